@@ -4,13 +4,54 @@
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
+#include <projgeom/big_int.hpp>
+#include <projgeom/conic.hpp>
 #include <projgeom/ell_object.hpp>
+#include <projgeom/fraction_vector.hpp>
+#include <projgeom/fractions.hpp>
 #include <projgeom/hyp_object.hpp>
+#include <projgeom/incidence_matrix.hpp>
+#include <projgeom/lazy_fraction.hpp>
+#include <projgeom/mod_int.hpp>
+#include <projgeom/modular_check.hpp>
+#include <projgeom/pg_line.hpp>
 #include <projgeom/pg_object.hpp>
 #include <projgeom/pg_plane.hpp>
+#include <projgeom/pg_point.hpp>
+#include <projgeom/simd_kernels.hpp>
+#include <projgeom/transform.hpp>
+#include <projgeom/transform_expr.hpp>
+#include <projgeom/wide_int.hpp>
+
+// ---------------------------------------------------------------------------
+// Helpers for batch benchmarks
+// ---------------------------------------------------------------------------
+static auto make_point_soa(std::size_t n, int64_t seed) -> fun::PointSoA {
+    fun::PointSoA pts;
+    pts.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto k = static_cast<int64_t>(i) + seed;
+        pts.push_back(PgPoint{{k % 1000 - 500, (k * 7) % 1000 - 500, (k * 13) % 1000 + 1}});
+    }
+    return pts;
+}
+
+static auto isa_arg(const benchmark::State& state) -> fun::SimdIsa {
+    return static_cast<fun::SimdIsa>(state.range(0));
+}
+
+static void SimdIsaArgs(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"isa", "n"});
+    for (auto isa : {fun::SimdIsa::Scalar, fun::SimdIsa::Avx2, fun::SimdIsa::Avx512}) {
+        bench->Args({static_cast<int64_t>(isa), 4096});
+    }
+}
 
 // ---------------------------------------------------------------------------
 // Dot product
@@ -24,6 +65,25 @@ static void BM_DotProduct(benchmark::State& state) {
 }
 BENCHMARK(BM_DotProduct);
 
+static void BM_DotProductBatch(benchmark::State& state) {
+    const auto isa = isa_arg(state);
+    if (!fun::simd_supported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+    const auto n = static_cast<std::size_t>(state.range(1));
+    const auto a = make_point_soa(n, 1);
+    const auto b = make_point_soa(n, 2);
+    std::vector<int64_t> r(n);
+    for (auto _ : state) {
+        fun::dot_batch(isa, a.view(), b.view(), r);
+        benchmark::DoNotOptimize(r.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_DotProductBatch)->Apply(SimdIsaArgs);
+
 // ---------------------------------------------------------------------------
 // Cross product
 // ---------------------------------------------------------------------------
@@ -36,6 +96,58 @@ static void BM_CrossProduct(benchmark::State& state) {
 }
 BENCHMARK(BM_CrossProduct);
 
+static void BM_CrossProductBatch(benchmark::State& state) {
+    const auto isa = isa_arg(state);
+    if (!fun::simd_supported(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+    const auto n = static_cast<std::size_t>(state.range(1));
+    const auto a = make_point_soa(n, 1);
+    const auto b = make_point_soa(n, 2);
+    fun::LineSoA r(n);
+    for (auto _ : state) {
+        fun::cross_batch(isa, a.view(), b.view(), r.span());
+        benchmark::DoNotOptimize(r.x().data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_CrossProductBatch)->Apply(SimdIsaArgs);
+
+// Generic meet of fun::pg_point<T>: int64_t vs. Int128/Int256 and GF(2^61 - 1)
+template <typename T> static void BM_MeetWide(benchmark::State& state) {
+    fun::pg_point<T> p(T(1009), T(2), T(1));
+    fun::pg_point<T> q(T(-3), T(1013), T(1));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p);
+        benchmark::DoNotOptimize(q);
+        auto ln = p * q;
+        benchmark::DoNotOptimize(ln);
+    }
+}
+BENCHMARK(BM_MeetWide<int64_t>);
+BENCHMARK(BM_MeetWide<fun::Int128>);
+BENCHMARK(BM_MeetWide<fun::Int256>);
+BENCHMARK(BM_MeetWide<fun::ModInt61>);
+BENCHMARK(BM_MeetWide<fun::BigInt>);
+
+// Product of two n-limb BigInts: schoolbook below the Karatsuba threshold, Karatsuba above
+static void BM_BigIntMul(benchmark::State& state) {
+    const auto limbs = static_cast<std::size_t>(state.range(0));
+    fun::BigInt lhs;
+    fun::BigInt rhs;
+    for (std::size_t i = 0; i < limbs; ++i) {
+        lhs = (lhs << 64) + fun::BigInt(0x9e3779b97f4a7c15ULL * (i + 1));
+        rhs = (rhs << 64) + fun::BigInt(0xc2b2ae3d27d4eb4fULL * (i + 3));
+    }
+    for (auto _ : state) {
+        auto prod = lhs * rhs;
+        benchmark::DoNotOptimize(prod);
+    }
+}
+BENCHMARK(BM_BigIntMul)->Arg(2)->Arg(16)->Arg(64)->Arg(256);
+
 // ---------------------------------------------------------------------------
 // Point creation
 // ---------------------------------------------------------------------------
@@ -147,4 +259,400 @@ static void BM_HarmonicConj(benchmark::State& state) {
 }
 BENCHMARK(BM_HarmonicConj);
 
+// ---------------------------------------------------------------------------
+// Incidence matrix (points x lines)
+// ---------------------------------------------------------------------------
+static void BM_IncidenceMatrix(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const auto pts = make_point_soa(n, 1);
+    fun::LineSoA lns;
+    const auto tmp = make_point_soa(n, 2);
+    for (std::size_t i = 0; i < n; ++i) {
+        lns.push_back(tmp[i].aux());
+    }
+    for (auto _ : state) {
+        auto mat = fun::build_incidence(pts, lns, 1);
+        benchmark::DoNotOptimize(mat);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(n * n));
+}
+BENCHMARK(BM_IncidenceMatrix)->Arg(1024);
+
+// ---------------------------------------------------------------------------
+// Randomized Pappus check over GF(p) (Schwartz-Zippel)
+// ---------------------------------------------------------------------------
+static void BM_IdentityTestPappus(benchmark::State& state) {
+    auto pappus = [](auto& rnd) {
+        using Point = fun::pg_point<typename std::decay_t<decltype(rnd)>::value_type>;
+        const Point a(rnd(), rnd(), rnd());
+        const Point b(rnd(), rnd(), rnd());
+        const Point d(rnd(), rnd(), rnd());
+        const Point e(rnd(), rnd(), rnd());
+        const std::array<Point, 3> coline1{Point(a), Point(b),
+                                           Point::parametrize(rnd(), a, rnd(), b)};
+        const std::array<Point, 3> coline2{Point(d), Point(e),
+                                           Point::parametrize(rnd(), d, rnd(), e)};
+        return fun::check_pappus(coline1, coline2);
+    };
+    fun::ModularOptions opts;
+    opts.max_error = 1e-15;  // one prime per configuration
+    for (auto _ : state) {
+        ++opts.seed;
+        auto verdict = fun::identity_test(pappus, 64, opts);
+        benchmark::DoNotOptimize(verdict);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IdentityTestPappus);
+
+// ---------------------------------------------------------------------------
+// Fraction sums: reduce after every operation vs. deferred reduction
+// ---------------------------------------------------------------------------
+template <typename F> static void BM_FractionSum(benchmark::State& state) {
+    std::vector<F> terms;
+    for (int64_t i = 1; i <= 64; ++i) {
+        terms.emplace_back(F(i % 7 - 3, int64_t{1} << (i % 10)));
+    }
+    for (auto _ : state) {
+        F sum;
+        for (const auto& term : terms) {
+            sum += term;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(terms.size()));
+}
+BENCHMARK(BM_FractionSum<fun::Fraction<int64_t>>);
+BENCHMARK(BM_FractionSum<fun::LazyFraction<int64_t>>);
+
+static auto make_fractions(std::size_t n) -> fun::FractionVector {
+    fun::FractionVector fracs;
+    fracs.reserve(n);
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    for (std::size_t i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const auto num = static_cast<int64_t>(state >> 40) - (int64_t{1} << 23);
+        const auto den = static_cast<int64_t>((state >> 8) & 0xFFFFF) + 1;
+        fracs.push_back(num, den);
+    }
+    return fracs;
+}
+
+// Sorting an array of Fraction structs with the scalar operator<
+static void BM_FractionSortAoS(benchmark::State& state) {
+    const auto fracs = make_fractions(static_cast<std::size_t>(state.range(0)));
+    std::vector<fun::Fraction<int64_t>> aos;
+    for (std::size_t i = 0; i < fracs.size(); ++i) {
+        aos.push_back(fracs[i]);
+    }
+    for (auto _ : state) {
+        auto work = aos;
+        std::sort(work.begin(), work.end());
+        benchmark::DoNotOptimize(work.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FractionSortAoS)->Arg(1 << 20);
+
+// Columnar FractionVector sort; the argument is the number of threads
+static void BM_FractionVectorSort(benchmark::State& state) {
+    const auto fracs = make_fractions(std::size_t{1} << 20);
+    for (auto _ : state) {
+        auto work = fracs;
+        fun::sort(work, static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(work.num().data());
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t{1} << 20));
+}
+BENCHMARK(BM_FractionVectorSort)->Arg(1)->Arg(4)->UseRealTime();
+
+static void BM_FractionVectorAdd(benchmark::State& state) {
+    const auto lhs = make_fractions(std::size_t{1} << 16);
+    auto rhs = make_fractions(std::size_t{1} << 16);
+    fun::FractionVector out(lhs.size());
+    for (auto _ : state) {
+        fun::add(lhs.view(), rhs.view(), out.span());
+        benchmark::DoNotOptimize(out.num().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lhs.size()));
+}
+BENCHMARK(BM_FractionVectorAdd);
+
+// ---------------------------------------------------------------------------
+// Transform: lines through a fixed map (the adjugate is cached, no per-line inverse)
+// ---------------------------------------------------------------------------
+static void BM_TransformApplyLines(benchmark::State& state) {
+    using R = fun::Transform::Rational;
+    const auto xform = fun::Transform::rotation(R(3, 5), R(4, 5))
+                           .compose(fun::Transform::translation(7, -3));
+    std::vector<PgLine> lines;
+    for (int64_t i = 0; i < 1000; ++i) {
+        lines.emplace_back(std::array<int64_t, 3>{i % 17 - 8, i % 13 + 1, i - 500});
+    }
+    std::vector<PgLine> out(lines.size(), PgLine({0, 0, 1}));
+    for (auto _ : state) {
+        xform.apply_lines(lines, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_TransformApplyLines);
+
+// ---------------------------------------------------------------------------
+// Transform: a batch of points, one at a time vs blocked SIMD (AoS and SoA)
+// ---------------------------------------------------------------------------
+static auto transform_bench_points() -> std::vector<PgPoint> {
+    std::vector<PgPoint> points;
+    for (int64_t i = 0; i < 4096; ++i) {
+        points.emplace_back(std::array<int64_t, 3>{i % 101 - 50, i % 37 * 3 - 7, i % 5 + 1});
+    }
+    return points;
+}
+
+static auto transform_bench_map() -> fun::Transform {
+    using R = fun::Transform::Rational;
+    return fun::Transform::rotation(R(3, 5), R(4, 5)).compose(fun::Transform::translation(7, -3));
+}
+
+static void BM_TransformApplyPointLoop(benchmark::State& state) {
+    const auto xform = transform_bench_map();
+    const auto points = transform_bench_points();
+    std::vector<PgPoint> out(points.size(), PgPoint({0, 0, 1}));
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); ++i) out[i] = xform.apply_point(points[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_TransformApplyPointLoop);
+
+static void BM_TransformApplyPoints(benchmark::State& state) {
+    const auto xform = transform_bench_map();
+    const auto points = transform_bench_points();
+    std::vector<PgPoint> out(points.size(), PgPoint({0, 0, 1}));
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        xform.apply_points(points, out, threads);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_TransformApplyPoints)->Arg(1)->Arg(4);
+
+static void BM_TransformApplyPointsSoA(benchmark::State& state) {
+    const auto xform = transform_bench_map();
+    const auto points = transform_bench_points();
+    const fun::PointSoA soa{std::span<const PgPoint>{points}};
+    fun::PointSoA out;
+    xform.apply_points(soa, out);
+    for (auto _ : state) {
+        xform.apply_points(soa, out);
+        benchmark::DoNotOptimize(out.x().data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_TransformApplyPointsSoA);
+
+// ---------------------------------------------------------------------------
+// Transform chains: eager compose vs the folded TransformExpr
+// ---------------------------------------------------------------------------
+static void BM_TransformChainEager(benchmark::State& state) {
+    using R = fun::Transform::Rational;
+    const PgPoint point({5, -3, 2});
+    int64_t shift = 7;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shift);
+        const auto xform = fun::Transform::rotation(R(3, 5), R(4, 5))
+                               .compose(fun::Transform::translation(shift, -3))
+                               .compose(fun::Transform::scaling(R(2, 3), R(5, 7)))
+                               .compose(fun::Transform::translation(-1, 4));
+        benchmark::DoNotOptimize(xform.apply_point(point));
+    }
+}
+BENCHMARK(BM_TransformChainEager);
+
+static void BM_TransformChainLazy(benchmark::State& state) {
+    using R = fun::Transform::Rational;
+    const PgPoint point({5, -3, 2});
+    int64_t shift = 7;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shift);
+        const auto xform = fun::TransformExpr::rotation(R(3, 5), R(4, 5))
+                               .compose(fun::TransformExpr::translation(shift, -3))
+                               .compose(fun::TransformExpr::scaling(R(2, 3), R(5, 7)))
+                               .compose(fun::TransformExpr::translation(-1, 4));
+        benchmark::DoNotOptimize(xform.apply_point(point));
+    }
+}
+BENCHMARK(BM_TransformChainLazy);
+
+// ---------------------------------------------------------------------------
+// Transform: single points and lines through maps of each structure
+// ---------------------------------------------------------------------------
+static auto transform_bench_kind(int64_t kind) -> fun::Transform {
+    using R = fun::Transform::Rational;
+    switch (kind) {
+        case 0:
+            return fun::Transform::translation(7, -3);
+        case 1:
+            return fun::Transform::scaling(R(2, 3), R(5, 7));
+        case 2:
+            return transform_bench_map();
+        default:
+            return fun::Transform{fun::Transform::IntMat3x3{{{2, 1, 0}, {0, 3, 1}, {1, 0, 4}}}};
+    }
+}
+
+static void BM_TransformApplyPointKind(benchmark::State& state) {
+    const auto xform = transform_bench_kind(state.range(0));
+    const auto points = transform_bench_points();
+    std::vector<PgPoint> out(points.size(), PgPoint({0, 0, 1}));
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); ++i) out[i] = xform.apply_point(points[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_TransformApplyPointKind)->DenseRange(0, 3);
+
+static void BM_TransformApplyPointsKind(benchmark::State& state) {
+    const auto xform = transform_bench_kind(state.range(0));
+    const auto points = transform_bench_points();
+    std::vector<PgPoint> out(points.size(), PgPoint({0, 0, 1}));
+    for (auto _ : state) {
+        xform.apply_points(points, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_TransformApplyPointsKind)->DenseRange(0, 3);
+
+static void BM_TransformComposeKind(benchmark::State& state) {
+    const auto xform = transform_bench_kind(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(xform.compose(xform).inverse());
+    }
+}
+BENCHMARK(BM_TransformComposeKind)->DenseRange(0, 3);
+
+// ---------------------------------------------------------------------------
+// Conic: exact line intersection, one call per line vs. the batched kernel
+// ---------------------------------------------------------------------------
+static auto conic_bench_lines() -> std::vector<PgLine> {
+    std::vector<PgLine> lines;
+    for (int64_t i = 0; i < 1024; ++i) {
+        lines.emplace_back(std::array<int64_t, 3>{i % 13 - 6, i % 7 - 3, i % 41 - 20});
+    }
+    return lines;
+}
+
+static void BM_ConicIntersectLoop(benchmark::State& state) {
+    const auto conic = fun::Conic::circle(1, -2, 50);
+    const auto lines = conic_bench_lines();
+    std::vector<fun::ConicMeet> out(lines.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < lines.size(); ++i) out[i] = conic.intersect(lines[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_ConicIntersectLoop);
+
+static void BM_ConicIntersectBatch(benchmark::State& state) {
+    const auto conic = fun::Conic::circle(1, -2, 50);
+    const auto lines = conic_bench_lines();
+    std::vector<fun::ConicMeet> out(lines.size());
+    for (auto _ : state) {
+        conic.intersect(lines, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(lines.size()));
+}
+BENCHMARK(BM_ConicIntersectBatch);
+
+static void BM_ConicContainsPolar(benchmark::State& state) {
+    const auto conic = fun::Conic::parabola(fun::Conic::Rational(1, 3));
+    std::vector<PgPoint> points;
+    for (int64_t i = 0; i < 1024; ++i) {
+        points.emplace_back(std::array<int64_t, 3>{3 * (i % 17 - 8), 3 * (i % 5), 1});
+    }
+    for (auto _ : state) {
+        int64_t hits = 0;
+        for (const auto& pt : points) {
+            hits += conic.contains(pt) ? 1 : 0;
+            benchmark::DoNotOptimize(conic.polar(pt));
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_ConicContainsPolar);
+
+static auto conic_bench_cloud() -> std::vector<PgPoint> {
+    std::vector<PgPoint> points;
+    for (int64_t i = 0; i < 4096; ++i) {
+        points.emplace_back(
+            std::array<int64_t, 3>{(i * 7919) % 2001 - 1000, (i * 104729) % 2001 - 1000, 40});
+    }
+    return points;
+}
+
+static void BM_ConicClassifyLoop(benchmark::State& state) {
+    const auto conic = fun::Conic::circle(3, -4, 500);
+    const auto points = conic_bench_cloud();
+    std::vector<int8_t> out(points.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < points.size(); ++i) out[i] = conic.classify(points[i]);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_ConicClassifyLoop);
+
+static void BM_ConicClassify(benchmark::State& state) {
+    const auto conic = fun::Conic::circle(3, -4, 500);
+    const auto points = conic_bench_cloud();
+    std::vector<int8_t> out(points.size());
+    for (auto _ : state) {
+        conic.classify(points, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_ConicClassify);
+
+static void BM_ConicClassifySoA(benchmark::State& state) {
+    const auto conic = fun::Conic::circle(3, -4, 500);
+    fun::PointSoA points;
+    for (const auto& pt : conic_bench_cloud()) points.push_back(pt);
+    std::vector<int8_t> out(points.size());
+    for (auto _ : state) {
+        conic.classify(points, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(points.size()));
+}
+BENCHMARK(BM_ConicClassifySoA);
+
+static void BM_ConicThrough(benchmark::State& state) {
+    std::vector<std::array<PgPoint, 5>> samples;
+    for (int64_t i = 0; i < 4096; ++i) {
+        std::array<PgPoint, 5> sample{PgPoint({0, 0, 1}), PgPoint({0, 0, 1}), PgPoint({0, 0, 1}),
+                                      PgPoint({0, 0, 1}), PgPoint({0, 0, 1})};
+        for (int64_t k = 0; k < 5; ++k) {
+            const auto seed = i * 5 + k;
+            sample[static_cast<std::size_t>(k)]
+                = PgPoint({(seed * 7919) % 255 - 127, (seed * 104729) % 255 - 127, 1});
+        }
+        samples.push_back(sample);
+    }
+    std::vector<std::optional<fun::Conic>> out(samples.size());
+    for (auto _ : state) {
+        fun::Conic::through(samples, out, static_cast<std::size_t>(state.range(0)));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(samples.size()));
+}
+BENCHMARK(BM_ConicThrough)->Arg(1)->Arg(4)->UseRealTime();
+
 BENCHMARK_MAIN();
@@ -0,0 +1,849 @@
+/** @file big_int.hpp
+ *  @brief Arbitrary-precision signed integer satisfying Ring/Integral.
+ *
+ *  BigInt stores a sign and a little-endian vector of 64-bit magnitude limbs
+ *  (no leading zero limbs; zero has no limbs). Values of up to two limbs are
+ *  held inline; longer limb buffers come from the per-thread arena of
+ *  limb_arena.hpp. Division rounds toward zero and the remainder takes the
+ *  sign of the dividend, like the builtin integers, so Fraction<BigInt> and
+ *  fun::pg_point<BigInt> behave as they do for int64_t, only without
+ *  overflow.
+ *
+ *  Products use schoolbook multiplication below karatsuba_threshold limbs
+ *  and Karatsuba above it; gcd() finishes with the binary gcd once both
+ *  operands fit into 128 bits.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "binary_gcd.hpp"
+#include "int128.hpp"
+#include "limb_arena.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Vector of 64-bit limbs with inline storage for two limbs.
+     *
+     * Only the subset of the std::vector interface that BigInt needs. Values
+     * of up to 128 bits never allocate; longer buffers come from the
+     * per-thread arena and grow to power-of-two capacities that match its
+     * buckets.
+     */
+    class LimbBuffer {
+      public:
+        using value_type = std::uint64_t;
+        static constexpr std::size_t inline_capacity = 2;
+
+        LimbBuffer() noexcept = default;
+
+        LimbBuffer(std::size_t count, value_type fill) { this->resize(count, fill); }
+
+        LimbBuffer(const LimbBuffer& other) {
+            this->reserve(other.size_);
+            std::copy_n(other.data(), other.size_, this->data());
+            size_ = other.size_;
+        }
+
+        LimbBuffer(LimbBuffer&& other) noexcept { this->steal(other); }
+
+        auto operator=(const LimbBuffer& other) -> LimbBuffer& {
+            if (this != &other) {
+                size_ = 0;
+                this->reserve(other.size_);
+                std::copy_n(other.data(), other.size_, this->data());
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        auto operator=(LimbBuffer&& other) noexcept -> LimbBuffer& {
+            if (this != &other) {
+                this->release();
+                this->steal(other);
+            }
+            return *this;
+        }
+
+        ~LimbBuffer() { this->release(); }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+        [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t { return cap_; }
+        [[nodiscard]] auto is_inline() const noexcept -> bool { return cap_ == inline_capacity; }
+
+        [[nodiscard]] auto data() noexcept -> value_type* {
+            return this->is_inline() ? small_.data() : heap_;
+        }
+        [[nodiscard]] auto data() const noexcept -> const value_type* {
+            return this->is_inline() ? small_.data() : heap_;
+        }
+
+        auto operator[](std::size_t idx) noexcept -> value_type& { return this->data()[idx]; }
+        auto operator[](std::size_t idx) const noexcept -> const value_type& {
+            return this->data()[idx];
+        }
+
+        auto begin() noexcept -> value_type* { return this->data(); }
+        auto end() noexcept -> value_type* { return this->data() + size_; }
+        auto begin() const noexcept -> const value_type* { return this->data(); }
+        auto end() const noexcept -> const value_type* { return this->data() + size_; }
+
+        auto back() noexcept -> value_type& { return this->data()[size_ - 1]; }
+        auto back() const noexcept -> const value_type& { return this->data()[size_ - 1]; }
+
+        void push_back(value_type val) {
+            if (size_ == cap_) this->reserve(size_ + 1);
+            this->data()[size_++] = val;
+        }
+
+        void pop_back() noexcept { --size_; }
+
+        void clear() noexcept { size_ = 0; }
+
+        /// Resize; new limbs are set to fill.
+        void resize(std::size_t count, value_type fill = 0) {
+            this->reserve(count);
+            if (count > size_) std::fill(this->data() + size_, this->data() + count, fill);
+            size_ = count;
+        }
+
+        /// Replace the contents by count copies of fill.
+        void assign(std::size_t count, value_type fill) {
+            size_ = 0;
+            this->resize(count, fill);
+        }
+
+        void reserve(std::size_t count) {
+            if (count <= cap_) return;
+            const auto new_cap = std::bit_ceil(std::max(count, 2 * cap_));
+            auto* mem = static_cast<value_type*>(arena_allocate(new_cap * sizeof(value_type)));
+            std::copy_n(this->data(), size_, mem);
+            this->release();
+            heap_ = mem;
+            cap_ = new_cap;
+        }
+
+        friend auto operator==(const LimbBuffer& lhs, const LimbBuffer& rhs) noexcept -> bool {
+            return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+      private:
+        void release() noexcept {
+            if (!this->is_inline()) arena_deallocate(heap_, cap_ * sizeof(value_type));
+            cap_ = inline_capacity;
+        }
+
+        /// Take over the contents of other (whose buffer must be released already or moved).
+        void steal(LimbBuffer& other) noexcept {
+            if (other.is_inline()) {
+                small_ = other.small_;
+            } else {
+                heap_ = other.heap_;
+                cap_ = other.cap_;
+                other.cap_ = inline_capacity;
+            }
+            size_ = other.size_;
+            other.size_ = 0;
+        }
+
+        union {
+            std::array<value_type, inline_capacity> small_{};
+            value_type* heap_;
+        };
+        std::size_t size_{0};
+        std::size_t cap_{inline_capacity};
+    };
+
+    /**
+     * @brief Arbitrary-precision signed integer (sign and magnitude).
+     */
+    class BigInt {
+      public:
+        using limb_type = std::uint64_t;
+        using limb_vector = LimbBuffer;
+
+        /// Operand size (in limbs) from which products use Karatsuba.
+        static constexpr std::size_t karatsuba_threshold = 32;
+
+        /**
+         * @brief Zero.
+         */
+        BigInt() noexcept = default;
+
+        /**
+         * @brief Construct from a builtin integer.
+         *
+         * @param[in] val
+         */
+        template <std::integral T> BigInt(T val) {  // NOLINT
+            if constexpr (std::is_signed_v<T>) {
+                neg_ = val < 0;
+                const auto mag = neg_ ? limb_type{0} - static_cast<limb_type>(val)
+                                      : static_cast<limb_type>(val);
+                if (mag != 0) mag_.push_back(mag);
+            } else {
+                if (val != 0) mag_.push_back(static_cast<limb_type>(val));
+            }
+        }
+
+#if PROJGEOM_HAS_INT128
+        /**
+         * @brief Construct from a builtin 128-bit integer.
+         *
+         * @param[in] val
+         * @return BigInt
+         */
+        static auto from_int128(int128_t val) -> BigInt {
+            BigInt res;
+            res.neg_ = val < 0;
+            const auto mag = res.neg_ ? uint128_t(0) - uint128_t(val) : uint128_t(val);
+            res.mag_.push_back(static_cast<limb_type>(mag));
+            res.mag_.push_back(static_cast<limb_type>(mag >> 64));
+            res.trim();
+            return res;
+        }
+#endif
+
+        /**
+         * @brief Parse an optionally signed decimal string.
+         *
+         * @param[in] text
+         * @return BigInt
+         * @throws std::invalid_argument if text is not a decimal integer
+         */
+        static auto from_string(std::string_view text) -> BigInt {
+            bool neg = false;
+            if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+                neg = text.front() == '-';
+                text.remove_prefix(1);
+            }
+            if (text.empty()) throw std::invalid_argument{"BigInt: empty number"};
+            BigInt res;
+            // leading chunk of size % 19 digits, then full chunks of 19
+            auto len = text.size() % 19 == 0 ? std::size_t{19} : text.size() % 19;
+            for (std::size_t pos = 0; pos < text.size(); pos += len, len = 19) {
+                limb_type chunk = 0;
+                limb_type scale = 1;
+                for (const char digit : text.substr(pos, len)) {
+                    if (digit < '0' || digit > '9') {
+                        throw std::invalid_argument{"BigInt: invalid digit"};
+                    }
+                    chunk = chunk * 10 + static_cast<limb_type>(digit - '0');
+                    scale *= 10;
+                }
+                res.mul_add_small(scale, chunk);
+            }
+            res.neg_ = neg && !res.mag_.empty();
+            return res;
+        }
+
+        /**
+         * @brief Little-endian magnitude limbs (empty for zero).
+         *
+         * @return const limb_vector&
+         */
+        [[nodiscard]] auto limbs() const noexcept -> const limb_vector& { return mag_; }
+
+        [[nodiscard]] auto is_negative() const noexcept -> bool { return neg_; }
+
+        [[nodiscard]] auto is_zero() const noexcept -> bool { return mag_.empty(); }
+
+        /**
+         * @brief Number of significant bits of the magnitude.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] auto bit_length() const noexcept -> std::size_t {
+            if (mag_.empty()) return 0;
+            return 64 * (mag_.size() - 1) + static_cast<std::size_t>(std::bit_width(mag_.back()));
+        }
+
+        /**
+         * @brief Is the value representable as int64_t?
+         *
+         * @return bool
+         */
+        [[nodiscard]] auto fits_int64() const noexcept -> bool {
+            if (mag_.size() > 1) return false;
+            if (mag_.empty()) return true;
+            constexpr limb_type kLimit = limb_type{1} << 63;
+            return neg_ ? mag_[0] <= kLimit : mag_[0] < kLimit;
+        }
+
+        /**
+         * @brief Value as int64_t (exact iff fits_int64()).
+         *
+         * @return std::int64_t
+         */
+        [[nodiscard]] auto to_int64() const noexcept -> std::int64_t {
+            const limb_type low = mag_.empty() ? 0 : mag_[0];
+            return static_cast<std::int64_t>(neg_ ? limb_type{0} - low : low);
+        }
+
+        explicit operator bool() const noexcept { return !mag_.empty(); }
+
+        explicit operator double() const noexcept {
+            double res = 0.0;
+            for (std::size_t i = mag_.size(); i-- > 0;) {
+                res = res * 18446744073709551616.0 + static_cast<double>(mag_[i]);
+            }
+            return neg_ ? -res : res;
+        }
+
+        // ---- comparison ------------------------------------------------------
+
+        friend auto operator==(const BigInt& lhs, const BigInt& rhs) noexcept -> bool {
+            return lhs.neg_ == rhs.neg_ && lhs.mag_ == rhs.mag_;
+        }
+
+        friend auto operator<=>(const BigInt& lhs, const BigInt& rhs) noexcept
+            -> std::strong_ordering {
+            if (lhs.neg_ != rhs.neg_) return rhs.neg_ <=> lhs.neg_;
+            const auto cmp = compare_mag(lhs.mag_, rhs.mag_);
+            return lhs.neg_ ? 0 <=> cmp : cmp <=> 0;
+        }
+
+        // ---- additive --------------------------------------------------------
+
+        auto operator+=(const BigInt& rhs) -> BigInt& {
+            this->add_signed(rhs.mag_, rhs.neg_);
+            return *this;
+        }
+
+        auto operator-=(const BigInt& rhs) -> BigInt& {
+            this->add_signed(rhs.mag_, !rhs.neg_);
+            return *this;
+        }
+
+        auto operator-() const& -> BigInt {
+            BigInt res = *this;
+            res.neg_ = !res.neg_ && !res.mag_.empty();
+            return res;
+        }
+
+        auto operator-() && -> BigInt {
+            neg_ = !neg_ && !mag_.empty();
+            return std::move(*this);
+        }
+
+        auto operator+() const -> BigInt { return *this; }
+
+        friend auto operator+(BigInt lhs, const BigInt& rhs) -> BigInt { return lhs += rhs; }
+
+        friend auto operator-(BigInt lhs, const BigInt& rhs) -> BigInt { return lhs -= rhs; }
+
+        // ---- multiplicative --------------------------------------------------
+
+        friend auto operator*(const BigInt& lhs, const BigInt& rhs) -> BigInt {
+            BigInt res;
+            if (lhs.mag_.empty() || rhs.mag_.empty()) return res;
+            res.mag_ = mul_mag(lhs.mag_, rhs.mag_);
+            res.neg_ = lhs.neg_ != rhs.neg_;
+            return res;
+        }
+
+        auto operator*=(const BigInt& rhs) -> BigInt& { return *this = *this * rhs; }
+
+        /**
+         * @brief Truncating division (rounds toward zero, like builtin integers).
+         *
+         * @throws std::domain_error on division by zero
+         */
+        friend auto operator/(const BigInt& lhs, const BigInt& rhs) -> BigInt {
+            BigInt quot;
+            BigInt rem;
+            divmod(lhs, rhs, quot, rem);
+            return quot;
+        }
+
+        /**
+         * @brief Remainder with the sign of the dividend (like builtin integers).
+         *
+         * @throws std::domain_error on division by zero
+         */
+        friend auto operator%(const BigInt& lhs, const BigInt& rhs) -> BigInt {
+            BigInt quot;
+            BigInt rem;
+            divmod(lhs, rhs, quot, rem);
+            return rem;
+        }
+
+        auto operator/=(const BigInt& rhs) -> BigInt& { return *this = *this / rhs; }
+
+        auto operator%=(const BigInt& rhs) -> BigInt& { return *this = *this % rhs; }
+
+        /**
+         * @brief Quotient and remainder in one pass.
+         *
+         * @param[in] lhs
+         * @param[in] rhs
+         * @param[out] quot lhs / rhs rounded toward zero
+         * @param[out] rem lhs - quot * rhs
+         * @throws std::domain_error on division by zero
+         */
+        static void divmod(const BigInt& lhs, const BigInt& rhs, BigInt& quot, BigInt& rem) {
+            if (rhs.mag_.empty()) throw std::domain_error{"BigInt: division by zero"};
+            divmod_mag(lhs.mag_, rhs.mag_, quot.mag_, rem.mag_);
+            quot.neg_ = !quot.mag_.empty() && lhs.neg_ != rhs.neg_;
+            rem.neg_ = !rem.mag_.empty() && lhs.neg_;
+        }
+
+        // ---- shifts ----------------------------------------------------------
+
+        /// Multiply the magnitude by 2^shift.
+        auto operator<<=(std::size_t shift) -> BigInt& {
+            mag_ = shift_left(mag_, shift, 0);
+            return *this;
+        }
+
+        /// Divide the magnitude by 2^shift, rounding toward zero.
+        auto operator>>=(std::size_t shift) -> BigInt& {
+            shift_right_in_place(mag_, shift);
+            neg_ = neg_ && !mag_.empty();
+            return *this;
+        }
+
+        friend auto operator<<(BigInt lhs, std::size_t shift) -> BigInt { return lhs <<= shift; }
+
+        friend auto operator>>(BigInt lhs, std::size_t shift) -> BigInt { return lhs >>= shift; }
+
+        /**
+         * @brief Absolute value.
+         */
+        friend auto abs(BigInt val) -> BigInt {
+            val.neg_ = false;
+            return val;
+        }
+
+        /**
+         * @brief Greatest common divisor (nonnegative), found by ADL from fun::gcd callers.
+         *
+         * Euclid's algorithm with Knuth division while the operands are long,
+         * then the binary gcd once both fit into two limbs.
+         *
+         * @param[in] lhs
+         * @param[in] rhs
+         * @return BigInt
+         */
+        friend auto gcd(const BigInt& lhs, const BigInt& rhs) -> BigInt {
+            limb_vector big = lhs.mag_;
+            limb_vector small = rhs.mag_;
+            if (compare_mag(big, small) < 0) std::swap(big, small);
+            limb_vector quot;
+            limb_vector rem;
+            while (!small.empty() && big.size() > 2) {
+                divmod_mag(big, small, quot, rem);
+                big = std::move(small);
+                small = std::move(rem);
+            }
+            BigInt res;
+            if (small.empty()) {
+                res.mag_ = std::move(big);
+                return res;
+            }
+#if PROJGEOM_HAS_INT128
+            auto to_u128 = [](const limb_vector& mag) -> uint128_t {
+                return mag.size() == 2 ? (uint128_t(mag[1]) << 64) | mag[0] : uint128_t(mag[0]);
+            };
+            const auto common = binary_gcd_u128(to_u128(big), to_u128(small));
+            res.mag_.push_back(static_cast<limb_type>(common));
+            res.mag_.push_back(static_cast<limb_type>(common >> 64));
+            trim(res.mag_);
+#else
+            while (small.size() > 1) {
+                divmod_mag(big, small, quot, rem);
+                big = std::move(small);
+                small = std::move(rem);
+            }
+            if (small.empty()) {
+                res.mag_ = std::move(big);
+                return res;
+            }
+            if (big.size() > 1) big.assign(1, divmod_small_in_place(big, small[0]));
+            res.mag_.push_back(binary_gcd(big[0], small[0]));
+#endif
+            return res;
+        }
+
+        /**
+         * @brief Decimal representation.
+         *
+         * @return std::string
+         */
+        [[nodiscard]] auto to_string() const -> std::string {
+            constexpr limb_type kChunk = 10000000000000000000ULL;  // 10^19
+            auto mag = mag_;
+            std::string digits;
+            do {
+                const auto rem = divmod_small_in_place(mag, kChunk);
+                auto chunk = std::to_string(rem);
+                if (!mag.empty()) chunk.insert(0, 19 - chunk.size(), '0');
+                digits.insert(0, chunk);
+            } while (!mag.empty());
+            return neg_ ? "-" + digits : digits;
+        }
+
+        friend auto operator<<(std::ostream& os, const BigInt& val) -> std::ostream& {
+            return os << val.to_string();
+        }
+
+      private:
+        void trim() noexcept {
+            while (!mag_.empty() && mag_.back() == 0) mag_.pop_back();
+            if (mag_.empty()) neg_ = false;
+        }
+
+        static void trim(limb_vector& mag) noexcept {
+            while (!mag.empty() && mag.back() == 0) mag.pop_back();
+        }
+
+        /// *this = *this * mul + add, on the magnitude.
+        void mul_add_small(limb_type mul, limb_type add) {
+            limb_type carry = add;
+            for (auto& limb : mag_) {
+                limb_type hi = 0;
+                const limb_type lo = mul_wide(limb, mul, hi);
+                limb = lo + carry;
+                carry = hi + static_cast<limb_type>(limb < lo);
+            }
+            if (carry != 0) mag_.push_back(carry);
+        }
+
+        static auto compare_mag(const limb_vector& lhs, const limb_vector& rhs) noexcept -> int {
+            if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+            for (std::size_t i = lhs.size(); i-- > 0;) {
+                if (lhs[i] != rhs[i]) return lhs[i] < rhs[i] ? -1 : 1;
+            }
+            return 0;
+        }
+
+        /// lhs += rhs on magnitudes.
+        static void add_mag(limb_vector& lhs, const limb_vector& rhs) {
+            if (lhs.size() < rhs.size()) lhs.resize(rhs.size(), 0);
+            const auto carry = add_limbs(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+            if (carry != 0) lhs.push_back(carry);
+        }
+
+        /// lhs -= rhs on magnitudes; requires |lhs| >= |rhs|.
+        static void sub_mag(limb_vector& lhs, const limb_vector& rhs) noexcept {
+            sub_limbs(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+            trim(lhs);
+        }
+
+        /// *this += (-1)^neg |mag|.
+        void add_signed(const limb_vector& mag, bool neg) {
+            if (mag.empty()) return;
+            if (neg_ == neg || mag_.empty()) {
+                neg_ = neg;
+                add_mag(mag_, mag);
+                return;
+            }
+            if (compare_mag(mag_, mag) >= 0) {
+                sub_mag(mag_, mag);
+            } else {
+                limb_vector res = mag;
+                sub_mag(res, mag_);
+                mag_ = std::move(res);
+                neg_ = neg;
+            }
+            this->trim();
+        }
+
+        /// dst[0, dst_len) += src[0, src_len) with src_len <= dst_len; returns the carry out.
+        static auto add_limbs(limb_type* dst, std::size_t dst_len, const limb_type* src,
+                              std::size_t src_len) noexcept -> limb_type {
+            limb_type carry = 0;
+            std::size_t i = 0;
+            for (; i < src_len; ++i) {
+                const limb_type sum = dst[i] + src[i];
+                const limb_type res = sum + carry;
+                carry = static_cast<limb_type>(sum < dst[i]) | static_cast<limb_type>(res < sum);
+                dst[i] = res;
+            }
+            for (; carry != 0 && i < dst_len; ++i) {
+                carry = static_cast<limb_type>(++dst[i] == 0);
+            }
+            return carry;
+        }
+
+        /// dst[0, dst_len) -= src[0, src_len) with src_len <= dst_len; returns the borrow out.
+        static auto sub_limbs(limb_type* dst, std::size_t dst_len, const limb_type* src,
+                              std::size_t src_len) noexcept -> limb_type {
+            limb_type borrow = 0;
+            std::size_t i = 0;
+            for (; i < src_len; ++i) {
+                const limb_type diff = dst[i] - src[i];
+                const limb_type res = diff - borrow;
+                borrow = static_cast<limb_type>(dst[i] < src[i])
+                         | static_cast<limb_type>(diff < borrow);
+                dst[i] = res;
+            }
+            for (; borrow != 0 && i < dst_len; ++i) {
+                borrow = static_cast<limb_type>(dst[i]-- == 0);
+            }
+            return borrow;
+        }
+
+        /// res[0, a_len + b_len) = a * b by the schoolbook method.
+        static void mul_school(const limb_type* a_ptr, std::size_t a_len, const limb_type* b_ptr,
+                               std::size_t b_len, limb_type* res) noexcept {
+            std::fill_n(res, a_len + b_len, limb_type{0});
+            for (std::size_t i = 0; i < a_len; ++i) {
+                limb_type carry = 0;
+                for (std::size_t j = 0; j < b_len; ++j) {
+                    limb_type hi = 0;
+                    const limb_type lo = mul_wide(a_ptr[i], b_ptr[j], hi);
+                    limb_type acc = res[i + j] + lo;
+                    hi += static_cast<limb_type>(acc < lo);
+                    acc += carry;
+                    hi += static_cast<limb_type>(acc < carry);
+                    res[i + j] = acc;
+                    carry = hi;
+                }
+                res[i + b_len] = carry;
+            }
+        }
+
+        /**
+         * @brief res[0, a_len + b_len) = a * b, requires a_len >= b_len.
+         *
+         * Karatsuba with a = a1 B^h + a0 and b = b1 B^h + b0:
+         * @f[
+         *     ab = z_2 B^{2h} + ((a_0 + a_1)(b_0 + b_1) - z_0 - z_2) B^h + z_0
+         * @f]
+         * where z0 = a0 b0 and z2 = a1 b1. An operand of at most half the length
+         * of the other is multiplied slice by slice instead.
+         */
+        static void mul_limbs(const limb_type* a_ptr, std::size_t a_len, const limb_type* b_ptr,
+                              std::size_t b_len, limb_type* res) {
+            if (b_len < karatsuba_threshold) {
+                mul_school(a_ptr, a_len, b_ptr, b_len, res);
+                return;
+            }
+            const auto total = a_len + b_len;
+            const auto half = (a_len + 1) / 2;
+            if (b_len <= half) {
+                std::fill_n(res, total, limb_type{0});
+                limb_vector part(2 * b_len, 0);
+                for (std::size_t pos = 0; pos < a_len; pos += b_len) {
+                    const auto len = std::min(b_len, a_len - pos);
+                    if (len == b_len) {
+                        mul_limbs(a_ptr + pos, len, b_ptr, b_len, part.data());
+                    } else {
+                        mul_limbs(b_ptr, b_len, a_ptr + pos, len, part.data());
+                    }
+                    add_limbs(res + pos, total - pos, part.data(), len + b_len);
+                }
+                return;
+            }
+            const auto a1_len = a_len - half;
+            const auto b1_len = b_len - half;
+            mul_limbs(a_ptr, half, b_ptr, half, res);
+            mul_limbs(a_ptr + half, a1_len, b_ptr + half, b1_len, res + 2 * half);
+            limb_vector a_sum(half + 1, 0);
+            limb_vector b_sum(half + 1, 0);
+            std::copy_n(a_ptr, half, a_sum.data());
+            std::copy_n(b_ptr, half, b_sum.data());
+            a_sum[half] = add_limbs(a_sum.data(), half, a_ptr + half, a1_len);
+            b_sum[half] = add_limbs(b_sum.data(), half, b_ptr + half, b1_len);
+            limb_vector mid(2 * half + 2, 0);
+            mul_limbs(a_sum.data(), half + 1, b_sum.data(), half + 1, mid.data());
+            sub_limbs(mid.data(), mid.size(), res, 2 * half);
+            sub_limbs(mid.data(), mid.size(), res + 2 * half, a1_len + b1_len);
+            // mid = a0 b1 + a1 b0 < B^(total - half): its limbs above that are zero
+            add_limbs(res + half, total - half, mid.data(), std::min(mid.size(), total - half));
+        }
+
+        /// Product of magnitudes.
+        static auto mul_mag(const limb_vector& lhs, const limb_vector& rhs) -> limb_vector {
+            const auto& longer = lhs.size() >= rhs.size() ? lhs : rhs;
+            const auto& shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+            limb_vector res(lhs.size() + rhs.size(), 0);
+            mul_limbs(longer.data(), longer.size(), shorter.data(), shorter.size(), res.data());
+            trim(res);
+            return res;
+        }
+
+        /// mag * 2^shift, with extra zero limbs reserved on top.
+        static auto shift_left(const limb_vector& mag, std::size_t shift, std::size_t extra)
+            -> limb_vector {
+            if (mag.empty()) return {};
+            const auto limb_shift = shift / 64;
+            const auto bit_shift = static_cast<unsigned>(shift % 64);
+            limb_vector res(mag.size() + limb_shift + 1 + extra, 0);
+            for (std::size_t i = 0; i < mag.size(); ++i) {
+                res[i + limb_shift] |= mag[i] << bit_shift;
+                if (bit_shift != 0) res[i + limb_shift + 1] = mag[i] >> (64 - bit_shift);
+            }
+            if (extra == 0) trim(res);
+            return res;
+        }
+
+        static void shift_right_in_place(limb_vector& mag, std::size_t shift) noexcept {
+            const auto limb_shift = shift / 64;
+            const auto bit_shift = static_cast<unsigned>(shift % 64);
+            if (limb_shift >= mag.size()) {
+                mag.clear();
+                return;
+            }
+            const auto len = mag.size() - limb_shift;
+            for (std::size_t i = 0; i < len; ++i) {
+                const limb_type lo = mag[i + limb_shift];
+                const limb_type hi = i + limb_shift + 1 < mag.size() ? mag[i + limb_shift + 1] : 0;
+                mag[i] = bit_shift == 0 ? lo : (lo >> bit_shift) | (hi << (64 - bit_shift));
+            }
+            mag.resize(len);
+            trim(mag);
+        }
+
+        /// In-place division of a magnitude by one limb; returns the remainder.
+        static auto divmod_small_in_place(limb_vector& mag, limb_type div) noexcept -> limb_type {
+#if PROJGEOM_HAS_INT128
+            uint128_t rem = 0;
+            for (std::size_t i = mag.size(); i-- > 0;) {
+                const uint128_t cur = (rem << 64) | mag[i];
+                mag[i] = static_cast<limb_type>(cur / div);
+                rem = cur % div;
+            }
+            trim(mag);
+            return static_cast<limb_type>(rem);
+#else
+            limb_type rem = 0;
+            for (std::size_t i = mag.size() * 64; i-- > 0;) {
+                const bool top = (rem >> 63) != 0;
+                rem = (rem << 1) | ((mag[i / 64] >> (i % 64)) & 1U);
+                mag[i / 64] &= ~(limb_type{1} << (i % 64));
+                if (top || rem >= div) {
+                    rem -= div;
+                    mag[i / 64] |= limb_type{1} << (i % 64);
+                }
+            }
+            trim(mag);
+            return rem;
+#endif
+        }
+
+        /// Magnitude division num = quot * div + rem (Knuth, TAOCP 4.3.1, Algorithm D).
+        static void divmod_mag(const limb_vector& num, const limb_vector& div, limb_vector& quot,
+                               limb_vector& rem) {
+            if (compare_mag(num, div) < 0) {
+                rem = num;
+                quot.clear();
+                return;
+            }
+#if PROJGEOM_HAS_INT128
+            if (num.size() == 2) {
+                // both fit into 128 bits: one hardware-assisted division
+                const auto wide_num = (uint128_t(num[1]) << 64) | num[0];
+                const auto wide_div
+                    = div.size() == 2 ? (uint128_t(div[1]) << 64) | div[0] : uint128_t(div[0]);
+                const auto wide_quot = wide_num / wide_div;
+                const auto wide_rem = wide_num % wide_div;
+                quot.assign(1, static_cast<limb_type>(wide_quot));
+                quot.push_back(static_cast<limb_type>(wide_quot >> 64));
+                rem.assign(1, static_cast<limb_type>(wide_rem));
+                rem.push_back(static_cast<limb_type>(wide_rem >> 64));
+                trim(quot);
+                trim(rem);
+                return;
+            }
+#endif
+            if (div.size() == 1) {
+                quot = num;
+                const auto low = divmod_small_in_place(quot, div[0]);
+                rem.clear();
+                if (low != 0) rem.push_back(low);
+                return;
+            }
+#if PROJGEOM_HAS_INT128
+            const auto len_d = div.size();
+            const auto len_q = num.size() - len_d + 1;
+            // normalize so that the top limb of the divisor has its high bit set
+            const auto shift = static_cast<std::size_t>(std::countl_zero(div.back()));
+            const auto vn = shift_left(div, shift, 0);
+            auto un = shift_left(num, shift, 1);
+            un.resize(num.size() + 1);
+            quot.assign(len_q, 0);
+            const uint128_t base = uint128_t(1) << 64;
+            for (std::size_t j = len_q; j-- > 0;) {
+                const uint128_t top = (uint128_t(un[j + len_d]) << 64) | un[j + len_d - 1];
+                uint128_t qhat = top / vn[len_d - 1];
+                uint128_t rhat = top % vn[len_d - 1];
+                while (qhat >= base
+                       || qhat * vn[len_d - 2] > ((rhat << 64) | un[j + len_d - 2])) {
+                    --qhat;
+                    rhat += vn[len_d - 1];
+                    if (rhat >= base) break;
+                }
+                // multiply and subtract: un[j .. j + len_d] -= qhat * vn
+                limb_type carry = 0;
+                limb_type borrow = 0;
+                for (std::size_t i = 0; i < len_d; ++i) {
+                    const uint128_t prod = qhat * vn[i] + carry;
+                    carry = static_cast<limb_type>(prod >> 64);
+                    const auto low = static_cast<limb_type>(prod);
+                    const limb_type diff = un[i + j] - low;
+                    const limb_type res = diff - borrow;
+                    borrow = static_cast<limb_type>(un[i + j] < low)
+                             | static_cast<limb_type>(diff < borrow);
+                    un[i + j] = res;
+                }
+                const limb_type diff = un[j + len_d] - carry;
+                const limb_type res = diff - borrow;
+                const bool negative = un[j + len_d] < carry || diff < borrow;
+                un[j + len_d] = res;
+                if (negative) {
+                    // qhat was one too large: add the divisor back
+                    --qhat;
+                    limb_type add_carry = 0;
+                    for (std::size_t i = 0; i < len_d; ++i) {
+                        const uint128_t sum = uint128_t(un[i + j]) + vn[i] + add_carry;
+                        un[i + j] = static_cast<limb_type>(sum);
+                        add_carry = static_cast<limb_type>(sum >> 64);
+                    }
+                    un[j + len_d] += add_carry;
+                }
+                quot[j] = static_cast<limb_type>(qhat);
+            }
+            trim(quot);
+            un.resize(len_d);
+            shift_right_in_place(un, shift);
+            rem = std::move(un);
+#else
+            quot.assign(num.size(), 0);
+            rem.clear();
+            for (std::size_t i = num.size() * 64; i-- > 0;) {
+                rem = shift_left(rem, 1, 0);
+                if ((num[i / 64] >> (i % 64)) & 1U) {
+                    if (rem.empty()) rem.push_back(0);
+                    rem[0] |= 1U;
+                }
+                if (compare_mag(rem, div) >= 0) {
+                    sub_mag(rem, div);
+                    quot[i / 64] |= limb_type{1} << (i % 64);
+                }
+            }
+            trim(quot);
+#endif
+        }
+
+        limb_vector mag_;
+        bool neg_{false};
+    };
+
+}  // namespace fun
@@ -0,0 +1,145 @@
+/** @file binary_gcd.hpp
+ *  @brief Iterative greatest common divisors (Stein's binary gcd and Euclid).
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "common_concepts.h"
+#include "int128.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Magnitude of a signed 64-bit integer (well defined for INT64_MIN).
+     *
+     * @param[in] val
+     * @return std::uint64_t
+     */
+    constexpr auto magnitude(std::int64_t val) noexcept -> std::uint64_t {
+        return val < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(val)
+                       : static_cast<std::uint64_t>(val);
+    }
+
+    /**
+     * @brief Binary (Stein) greatest common divisor.
+     *
+     * Uses only shifts, subtractions and count-trailing-zeros, so it avoids
+     * the 64-bit divisions of Euclid's algorithm.
+     * @f[
+     *     \gcd(u, 0) = u, \quad \gcd(2^k u', 2^k v') = 2^k \gcd(u', v')
+     * @f]
+     * @param[in] u_val
+     * @param[in] v_val
+     * @return std::uint64_t
+     */
+    constexpr auto binary_gcd(std::uint64_t u_val, std::uint64_t v_val) noexcept -> std::uint64_t {
+        if (u_val == 0) return v_val;
+        if (v_val == 0) return u_val;
+        const auto shift = std::countr_zero(u_val | v_val);
+        u_val >>= std::countr_zero(u_val);
+        do {
+            v_val >>= std::countr_zero(v_val);
+            if (u_val > v_val) {
+                std::swap(u_val, v_val);
+            }
+            v_val -= u_val;
+        } while (v_val != 0);
+        return u_val << shift;
+    }
+
+#if PROJGEOM_HAS_INT128
+    /**
+     * @brief Binary (Stein) greatest common divisor of 128-bit values.
+     *
+     * @param[in] u_val
+     * @param[in] v_val
+     * @return uint128_t
+     */
+    constexpr auto binary_gcd_u128(uint128_t u_val, uint128_t v_val) noexcept -> uint128_t {
+        // std::countr_zero does not accept the non-standard 128-bit type
+        auto ctz = [](uint128_t val) -> int {
+            const auto low = static_cast<std::uint64_t>(val);
+            return low != 0 ? std::countr_zero(low)
+                            : 64 + std::countr_zero(static_cast<std::uint64_t>(val >> 64));
+        };
+        if (u_val == 0) return v_val;
+        if (v_val == 0) return u_val;
+        const auto shift = ctz(u_val | v_val);
+        u_val >>= ctz(u_val);
+        do {
+            v_val >>= ctz(v_val);
+            if (u_val > v_val) {
+                std::swap(u_val, v_val);
+            }
+            v_val -= u_val;
+        } while (v_val != 0);
+        return u_val << shift;
+    }
+#endif
+
+    /**
+     * @brief Iterative Euclidean greatest common divisor (non-negative result).
+     *
+     * @tparam Z
+     * @param[in] _m
+     * @param[in] _n
+     * @return Z
+     */
+    template <Integral Z> constexpr auto gcd_iterative(Z _m, Z _n) -> Z {
+        while (_n != Z(0)) {
+            Z rem = _m % _n;
+            _m = std::move(_n);
+            _n = std::move(rem);
+        }
+        return _m < Z(0) ? -_m : _m;
+    }
+
+    namespace detail {
+
+        /// Non-negative gcd of two accumulator values.
+        constexpr auto wide_gcd(int_wide lhs, int_wide rhs) noexcept -> int_wide {
+#if PROJGEOM_HAS_INT128
+            auto mag = [](int128_t val) {
+                return val < 0 ? uint128_t(0) - uint128_t(val) : uint128_t(val);
+            };
+            return static_cast<int128_t>(binary_gcd_u128(mag(lhs), mag(rhs)));
+#else
+            return static_cast<std::int64_t>(binary_gcd(magnitude(lhs), magnitude(rhs)));
+#endif
+        }
+
+        /// Divide out the common factor of a homogeneous vector.
+        template <std::size_t N> constexpr void wide_reduce(std::array<int_wide, N>& vec) {
+#if PROJGEOM_HAS_INT128
+            auto mag = [](int128_t val) {
+                return val < 0 ? uint128_t(0) - uint128_t(val) : uint128_t(val);
+            };
+            uint128_t common = 0;
+            for (const auto& val : vec) common = binary_gcd_u128(common, mag(val));
+#else
+            std::uint64_t common = 0;
+            for (const auto& val : vec) common = binary_gcd(common, magnitude(val));
+#endif
+            if (common <= 1) return;
+            for (auto& val : vec) val /= static_cast<int_wide>(common);
+        }
+
+        /// Narrow a homogeneous 3-vector, dividing out the common factor only if needed.
+        constexpr auto checked_narrow(std::array<int_wide, 3> vec) -> std::array<std::int64_t, 3> {
+#if PROJGEOM_HAS_INT128
+            if (!fits_int64(vec[0]) || !fits_int64(vec[1]) || !fits_int64(vec[2])) {
+                wide_reduce(vec);
+            }
+#endif
+            return {checked_narrow(vec[0]), checked_narrow(vec[1]), checked_narrow(vec[2])};
+        }
+
+    }  // namespace detail
+
+}  // namespace fun
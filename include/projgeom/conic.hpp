@@ -4,17 +4,403 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <numeric>
 #include <optional>
-#include <variant>
-#include <vector>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 
+#include "binary_gcd.hpp"
 #include "fractions.hpp"
+#include "int128.hpp"
 #include "pg_object.hpp"
+#include "pg_soa.hpp"
+#include "quad_ext.hpp"
+#include "run_blocks.hpp"
+#include "simd_kernels.hpp"
+#include "wide_int.hpp"
 
 namespace fun {
 
+    namespace detail {
+
+        using ConicWideMat3x3 = std::array<std::array<int_wide, 3>, 3>;
+
+        /// The point s P + t R, reduced and narrowed.
+        constexpr auto conic_point(int_wide s_val, const std::array<int_wide, 3>& pt_p,
+                                   int_wide t_val, const std::array<int_wide, 3>& pt_r)
+            -> PgPoint {
+            std::array<int_wide, 3> vec{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                vec[i] = checked_add(checked_mul(s_val, pt_p[i]), checked_mul(t_val, pt_r[i]));
+            }
+            wide_reduce(vec);
+            return PgPoint(
+                {checked_narrow(vec[0]), checked_narrow(vec[1]), checked_narrow(vec[2])});
+        }
+
+        /// The polar vector S x of the packed form (a, b, c, d, e, f).
+        constexpr auto conic_polar(const std::array<std::int64_t, 6>& coef,
+                                   const std::array<std::int64_t, 3>& pnt)
+            -> std::array<int_wide, 3> {
+            const auto [a_c, b_c, c_c, d_c, e_c, f_c] = coef;
+            const auto row = [&](std::int64_t s_x, std::int64_t s_y, std::int64_t s_z) {
+                return checked_add(checked_add(checked_mul(s_x, pnt[0]), checked_mul(s_y, pnt[1])),
+                                   checked_mul(s_z, pnt[2]));
+            };
+            return {row(a_c, b_c, d_c), row(b_c, c_c, e_c), row(d_c, e_c, f_c)};
+        }
+
+        /// x^T S x of the packed form, or nullopt if it does not fit into the wide type.
+        constexpr auto conic_form_value(const std::array<std::int64_t, 6>& coef,
+                                        const std::array<std::int64_t, 3>& pnt) noexcept
+            -> std::optional<int_wide> {
+            const auto [a_c, b_c, c_c, d_c, e_c, f_c] = coef;
+            const std::array<std::array<std::int64_t, 3>, 3> sym{
+                {{a_c, b_c, d_c}, {b_c, c_c, e_c}, {d_c, e_c, f_c}}};
+            int_wide res = 0;
+            for (std::size_t i = 0; i < 3; ++i) {
+                int_wide row = 0;
+                int_wide term{};
+                for (std::size_t j = 0; j < 3; ++j) {
+                    if (wide_mul_overflow(sym[i][j], pnt[j], term)
+                        || wide_add_overflow(row, term, row)) {
+                        return std::nullopt;
+                    }
+                }
+                if (wide_mul_overflow(pnt[i], row, term) || wide_add_overflow(res, term, res)) {
+                    return std::nullopt;
+                }
+            }
+            return res;
+        }
+
+        /// Points per block of Conic::classify.
+        constexpr std::size_t conic_block = 256;
+
+        /// Exact type of the fallback conic fit. Coordinates of up to 64 bits give entries of
+        /// e = 2 * 64 + 1 = 129 bits, so minors stay below 2^(5e + 7) = 2^652 < 2^(11 * 64 - 1).
+        using ConicFitWide = WideInt<11>;
+
+        /**
+         * @brief Null vector of a 5 x 6 matrix M from its signed maximal minors.
+         *
+         *  \f[ v_j = (-1)^j \det(M \text{ without column } j) \f]
+         * Laplace expansion of the 6 x 6 matrix [M; m_i] along its repeated
+         * row m_i gives M v = 0, and v = 0 iff rank M < 5. The minors of the
+         * first k rows are expanded from those of the first k - 1 rows along
+         * the new row (186 products, no division), so with entries below 2^e
+         * no intermediate reaches 2^(5e + 7).
+         */
+        template <typename T>
+        constexpr auto conic_null_vector(const std::array<std::array<T, 6>, 5>& mat)
+            -> std::array<T, 6> {
+            std::array<T, 64> minors{};  // indexed by the bit set of columns
+            minors[0] = T(1);
+            for (std::size_t row = 0; row < 5; ++row) {
+                for (unsigned cols = 1; cols < 64; ++cols) {
+                    if (static_cast<std::size_t>(std::popcount(cols)) != row + 1) continue;
+                    T acc(0);
+                    std::size_t pos = row;  // parity of (row + position of the column)
+                    for (unsigned col = 0; col < 6; ++col) {
+                        if (((cols >> col) & 1U) == 0) continue;
+                        const T term = mat[row][col] * minors[cols & ~(1U << col)];
+                        if (pos++ % 2 == 0) {
+                            acc += term;
+                        } else {
+                            acc -= term;
+                        }
+                    }
+                    minors[cols] = acc;
+                }
+            }
+            std::array<T, 6> res{};
+            for (unsigned col = 0; col < 6; ++col) {
+                const auto& minor = minors[63U & ~(1U << col)];
+                res[col] = col % 2 == 0 ? minor : -minor;
+            }
+            return res;
+        }
+
+        /**
+         * @brief Coprime int64 coefficients of a null vector, first nonzero one positive.
+         *
+         * @return false if the reduced vector does not fit into int64_t.
+         */
+        template <typename T>
+        constexpr auto conic_fit_coeffs(std::array<T, 6> vec, std::array<std::int64_t, 6>& coef)
+            -> bool {
+            if constexpr (std::is_same_v<T, int_wide>) {
+                wide_reduce(vec);
+            } else {
+                T common(0);
+                for (const auto& val : vec) {
+                    T rest = val < T(0) ? -val : val;
+                    while (rest != T(0)) {
+                        common %= rest;
+                        std::swap(common, rest);
+                    }
+                }
+                if (common > T(1)) {
+                    for (auto& val : vec) val /= common;
+                }
+            }
+            bool flip = false;
+            for (const auto& val : vec) {
+                if (val != T(0)) {
+                    flip = val < T(0);
+                    break;
+                }
+            }
+            for (std::size_t k = 0; k < 6; ++k) {
+                const T val = flip ? -vec[k] : vec[k];
+                if constexpr (std::is_same_v<T, int_wide>) {
+#if PROJGEOM_HAS_INT128
+                    if (!fits_int64(val)) return false;
+#endif
+                    coef[k] = static_cast<std::int64_t>(val);
+                } else {
+                    if (!val.fits_int64()) return false;
+                    coef[k] = val.to_int64();
+                }
+            }
+            return true;
+        }
+
+        /// The bilinear form u^T S v.
+        template <typename Mat>
+        constexpr auto conic_form(const Mat& sym, const std::array<int_wide, 3>& u_vec,
+                                  const std::array<int_wide, 3>& v_vec) -> int_wide {
+            int_wide res = 0;
+            for (std::size_t i = 0; i < 3; ++i) {
+                int_wide row = 0;
+                for (std::size_t j = 0; j < 3; ++j) {
+                    row = checked_add(row, checked_mul(sym[i][j], v_vec[j]));
+                }
+                res = checked_add(res, checked_mul(u_vec[i], row));
+            }
+            return res;
+        }
+
+        /// Adjugate of an integer symmetric matrix, if it fits into the wide type.
+        template <typename Mat>
+        constexpr auto conic_adjugate(const Mat& sym) noexcept -> std::optional<ConicWideMat3x3> {
+            ConicWideMat3x3 adj{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = i; j < 3; ++j) {
+                    // cofactor of entry (j, i), which equals that of (i, j)
+                    const std::size_t r0 = j == 0 ? 1 : 0, r1 = j == 2 ? 1 : 2;
+                    const std::size_t c0 = i == 0 ? 1 : 0, c1 = i == 2 ? 1 : 2;
+                    int_wide lhs{}, rhs{}, cof{};
+                    if (wide_mul_overflow(sym[r0][c0], sym[r1][c1], lhs)
+                        || wide_mul_overflow(sym[r0][c1], sym[r1][c0], rhs)
+                        || wide_sub_overflow(lhs, rhs, cof)) {
+                        return std::nullopt;
+                    }
+                    adj[i][j] = adj[j][i] = (i + j) % 2 == 0 ? cof : -cof;
+                }
+            }
+            return adj;
+        }
+
+        /**
+         * @brief Does the line provably miss the conic?
+         *
+         * The discriminant of the line has the sign of -l^T adj(S) l. Overflow
+         * yields false, leaving the decision to the exact kernel.
+         */
+        constexpr auto conic_misses(const ConicWideMat3x3& adj, const PgLine& line) noexcept
+            -> bool {
+            int_wide form = 0;
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    int_wide term{};
+                    if (wide_mul_overflow(adj[i][j], line.coord[i], term)
+                        || wide_mul_overflow(term, line.coord[j], term)
+                        || wide_add_overflow(form, term, form)) {
+                        return false;
+                    }
+                }
+            }
+            return form > 0;
+        }
+
+        /// Bit k is set iff k is a square modulo 64.
+        constexpr std::uint64_t conic_squares_mod64 = [] {
+            std::uint64_t mask = 0;
+            for (std::uint64_t k = 0; k < 64; ++k) mask |= std::uint64_t{1} << (k * k % 64);
+            return mask;
+        }();
+
+        /// Floor of the square root of a nonnegative value (Newton from above).
+        constexpr auto conic_isqrt(int_wide val) -> int_wide {
+            if (val < 2) return val;
+            int bits = std::bit_width(static_cast<std::uint64_t>(val));
+#if PROJGEOM_HAS_INT128
+            if (const auto hi = static_cast<std::uint64_t>(val >> 64); hi != 0) {
+                bits = 64 + std::bit_width(hi);
+            }
+#endif
+            auto root = int_wide{1} << ((bits + 1) / 2);
+            while (true) {
+                const auto next = (root + val / root) / 2;
+                if (next >= root) return root;
+                root = next;
+            }
+        }
+
+        /// Split val = factor^2 * rest, taking out the squares of the odd numbers below 100.
+        constexpr auto conic_square_part(int_wide& val) -> int_wide {
+            int_wide factor = 1;
+            while (val % 4 == 0) {
+                val /= 4;
+                factor *= 2;
+            }
+            for (int_wide odd = 3; odd < 100; odd += 2) {
+                while (val % (odd * odd) == 0) {
+                    val /= odd * odd;
+                    factor *= odd;
+                }
+            }
+            return factor;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Intersection of a line with a conic: at most two points, stored inline.
+     *
+     * The points are PgPoints when the discriminant of the line is a perfect
+     * square. Otherwise they are a conjugate pair with coordinates in Q(√d);
+     * the first is stored and the second is its conjugate. A line lying on a
+     * degenerate conic holds no points and is reported by contains_line().
+     */
+    class ConicMeet {
+      public:
+        using Coord = QuadExt<Fraction<std::int64_t>>;
+        using IrrationalPoint = std::array<Coord, 3>;
+
+        /**
+         * @brief The line misses the conic.
+         */
+        constexpr ConicMeet() = default;
+
+        /**
+         * @brief The line touches the conic at one point.
+         * @param[in] point
+         * @return ConicMeet
+         */
+        static constexpr auto tangent(const PgPoint& point) -> ConicMeet {
+            ConicMeet res;
+            res.points_[0] = point;
+            res.size_ = 1;
+            return res;
+        }
+
+        /**
+         * @brief The line cuts the conic at two rational points.
+         * @param[in] first
+         * @param[in] second
+         * @return ConicMeet
+         */
+        static constexpr auto secant(const PgPoint& first, const PgPoint& second) -> ConicMeet {
+            ConicMeet res;
+            res.points_ = {first, second};
+            res.size_ = 2;
+            return res;
+        }
+
+        /**
+         * @brief The line cuts the conic at root and its conjugate.
+         * @param[in] root
+         * @return ConicMeet
+         */
+        static constexpr auto conjugate(const IrrationalPoint& root) -> ConicMeet {
+            ConicMeet res;
+            res.root_ = root;
+            res.size_ = 2;
+            res.rational_ = false;
+            return res;
+        }
+
+        /**
+         * @brief The line lies on the (degenerate) conic.
+         * @return ConicMeet
+         */
+        static constexpr auto whole_line() -> ConicMeet {
+            ConicMeet res;
+            res.contains_line_ = true;
+            return res;
+        }
+
+        /** @brief Number of intersection points (0, 1 or 2). */
+        [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return size_; }
+
+        [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size_ == 0; }
+
+        /** @brief Are the points rational, i.e. available as PgPoints? */
+        [[nodiscard]] constexpr auto is_rational() const noexcept -> bool { return rational_; }
+
+        /** @brief Does the whole line lie on the conic? */
+        [[nodiscard]] constexpr auto contains_line() const noexcept -> bool {
+            return contains_line_;
+        }
+
+        /**
+         * @brief The i-th rational point.
+         * @param[in] idx  index below size()
+         */
+        constexpr auto operator[](std::size_t idx) const -> const PgPoint& {
+            assert(rational_ && idx < size_);
+            return points_[idx];
+        }
+
+        /** @brief The rational points (none if the points are irrational). */
+        [[nodiscard]] constexpr auto begin() const noexcept -> const PgPoint* {
+            return points_.data();
+        }
+
+        [[nodiscard]] constexpr auto end() const noexcept -> const PgPoint* {
+            return points_.data() + (rational_ ? size_ : 0);
+        }
+
+        /**
+         * @brief The i-th irrational point: the stored root, or its conjugate.
+         * @param[in] idx  0 or 1
+         * @return IrrationalPoint
+         */
+        [[nodiscard]] constexpr auto irrational_point(std::size_t idx) const -> IrrationalPoint {
+            assert(!rational_ && idx < 2);
+            if (idx == 0) return root_;
+            return {root_[0].conj(), root_[1].conj(), root_[2].conj()};
+        }
+
+        friend constexpr auto operator==(const ConicMeet& lhs, const ConicMeet& rhs) -> bool {
+            if (lhs.size_ != rhs.size_ || lhs.rational_ != rhs.rational_
+                || lhs.contains_line_ != rhs.contains_line_) {
+                return false;
+            }
+            if (!lhs.rational_) return lhs.root_ == rhs.root_;
+            for (std::size_t i = 0; i < lhs.size_; ++i) {
+                if (!(lhs.points_[i] == rhs.points_[i])) return false;
+            }
+            return true;
+        }
+
+      private:
+        std::array<PgPoint, 2> points_{PgPoint({0, 0, 1}), PgPoint({0, 0, 1})};
+        IrrationalPoint root_{};
+        std::uint8_t size_{0};
+        bool rational_{true};
+        bool contains_line_{false};
+    };
+
     /**
      * @brief Enumeration of conic types based on the discriminant.
      */
@@ -25,16 +411,34 @@ namespace fun {
      *
      * A point \f$\mathbf{x}=(x:y:z)\f$ lies on the conic iff
      * \f$\mathbf{x}^T Q \mathbf{x}=0\f$.
+     *
+     * Q only matters up to a positive factor, so it is stored as the six
+     * coprime integers (a, b, c, d, e, f) of
+     *  \f[ S = \begin{bmatrix}a&b&d\\b&c&e\\d&e&f\end{bmatrix}, \quad
+     *      \mathbf{x}^T S \mathbf{x} = a x^2 + 2 b x y + c y^2 + 2 d x z + 2 e y z + f z^2 \f]
+     * The sign is kept, so the inside (form < 0) and outside (form > 0) of
+     * the conic are preserved.
      */
     class Conic {
       public:
-        using Mat3x3 = std::array<std::array<Fraction, 3>, 3>;
+        using Rational = Fraction<std::int64_t>;
+        using Mat3x3 = std::array<std::array<Rational, 3>, 3>;
+        using Coeffs = std::array<std::int64_t, 6>;
 
         /**
-         * @brief Construct a new Conic from a symmetric matrix.
-         * @param[in] matrix  The 3x3 symmetric matrix Q.
+         * @brief Construct a new Conic from a matrix.
+         *
+         * Only the symmetric part (Q + Q^T) / 2 is used.
+         * @param[in] matrix  The 3x3 matrix Q.
+         * @throws std::overflow_error if the integer form does not fit into int64_t.
          */
-        constexpr explicit Conic(Mat3x3 matrix) : matrix_{std::move(matrix)} {}
+        constexpr explicit Conic(const Mat3x3& matrix) : coef_{from_rational(matrix)} {}
+
+        /**
+         * @brief Construct a new Conic from the integer coefficients (a, b, c, d, e, f).
+         * @param[in] coef  Upper triangle of S in the order S00, S01, S11, S02, S12, S22.
+         */
+        constexpr explicit Conic(const Coeffs& coef) : coef_{reduced(coef)} {}
 
         /**
          * @brief Create a circle with centre (cx, cy) and squared radius r².
@@ -48,16 +452,13 @@ namespace fun {
          */
         static constexpr auto circle(std::int64_t center_x, std::int64_t center_y,
                                      std::int64_t radius_sq) -> Conic {
-            const Fraction cx{center_x, 1};
-            const Fraction cy{center_y, 1};
-            const Fraction r2{radius_sq, 1};
-            const Fraction zero{0, 1};
-            const Fraction one{1, 1};
-            return Conic{Mat3x3{{
-                {{one, zero, -cx}},
-                {{zero, one, -cy}},
-                {{-cx, -cy, cx * cx + cy * cy - r2}},
-            }}};
+            using detail::checked_mul;
+            const auto sum_sq = detail::checked_add(checked_mul(center_x, center_x),
+                                                    checked_mul(center_y, center_y));
+            const auto f_coef = detail::checked_sub(sum_sq, radius_sq);
+            return Conic{Coeffs{1, 0, 1, detail::checked_narrow(detail::checked_sub(0, center_x)),
+                                detail::checked_narrow(detail::checked_sub(0, center_y)),
+                                detail::checked_narrow(f_coef)}};
         }
 
         /**
@@ -73,61 +474,188 @@ namespace fun {
          * @param[in] a  Coefficient.
          * @return constexpr Conic
          */
-        static constexpr auto parabola(const Fraction& a) -> Conic {
-            const Fraction zero{0, 1};
-            const Fraction half{1, 2};
-            const auto na = -a;
-            return Conic{Mat3x3{{
-                {{na, zero, zero}},
-                {{zero, zero, half}},
-                {{zero, half, zero}},
-            }}};
+        static constexpr auto parabola(const Rational& a) -> Conic {
+            // 2 den(a) (y z - a x^2)
+            return Conic{Coeffs{detail::checked_narrow(detail::checked_mul(-2, a.num())), 0, 0, 0,
+                                a.den(), 0}};
+        }
+
+        /**
+         * @brief The conic through five points.
+         *
+         * Each point gives a linear equation in the coefficients,
+         *  \f[ (x^2,\ 2xy,\ y^2,\ 2xz,\ 2yz,\ z^2) \cdot (a, b, c, d, e, f) = 0, \f]
+         * and the coefficients are the null vector of this 5 x 6 system,
+         * computed exactly from its signed 5 x 5 minors (fraction-free).
+         * Coordinates of up to 11 bits use 128-bit arithmetic; larger ones a
+         * 704-bit integer. The sign is chosen to make the first nonzero
+         * coefficient positive.
+         * @param[in] points  Five points, no four of them collinear.
+         * @return Conic
+         * @throws std::domain_error if the points do not determine a unique conic.
+         * @throws std::overflow_error if the coefficients do not fit into int64_t.
+         */
+        static auto through(const std::array<PgPoint, 5>& points) -> Conic {
+            Coeffs coef{};
+            switch (fit(points, coef)) {
+                case Fit::Degenerate:
+                    throw std::domain_error{"Conic: the points do not determine a unique conic"};
+                case Fit::TooLarge:
+                    throw std::overflow_error{"Conic: coefficients do not fit into int64_t"};
+                default:
+                    return Conic{coef};
+            }
+        }
+
+        /**
+         * @brief Fit a conic through each of many 5-point samples.
+         *
+         * Samples that do not determine a unique conic, or whose conic does
+         * not fit into int64_t, give std::nullopt instead of throwing, so a
+         * RANSAC-style search can skip them.
+         *
+         * @param[in] samples
+         * @param[out] out  same size as samples; out[i] = through(samples[i]) or std::nullopt
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         */
+        static void through(std::span<const std::array<PgPoint, 5>> samples,
+                            std::span<std::optional<Conic>> out, std::size_t num_threads = 1) {
+            assert(out.size() == samples.size());
+            const auto n = samples.size();
+            const auto num_blocks = (n + detail::conic_block - 1) / detail::conic_block;
+            detail::run_blocks(num_blocks, num_threads, [&](std::size_t blk) {
+                const auto last = std::min(n, (blk + 1) * detail::conic_block);
+                for (auto i = blk * detail::conic_block; i < last; ++i) {
+                    Coeffs coef{};
+                    if (fit(samples[i], coef) == Fit::Unique) {
+                        out[i].emplace(coef);
+                    } else {
+                        out[i].reset();
+                    }
+                }
+            });
         }
 
         /**
          * @brief Check whether a point lies on the conic.
          *
-         *  \f[ \mathbf{x}^T Q \mathbf{x} = 0 \f]
+         *  \f[ \mathbf{x}^T S \mathbf{x} = 0 \f]
          * @param[in] pt  The point to test.
          * @return true if the point lies on the conic.
          */
         constexpr auto contains(const PgPoint& point) const -> bool {
-            const Fraction x{point.coord[0], 1};
-            const Fraction y{point.coord[1], 1};
-            const Fraction z{point.coord[2], 1};
+            return this->classify(point) == 0;
+        }
+
+        /**
+         * @brief Side of the conic a point lies on.
+         *
+         *  \f[ \operatorname{sgn}(\mathbf{x}^T S \mathbf{x}) \f]
+         * -1 is inside (e.g. the centre of a circle), 0 on, +1 outside. The
+         * form is evaluated in 128 bits when it fits and in 256 bits
+         * otherwise, so the result is exact for all int64 coordinates.
+         * @param[in] point
+         * @return std::int8_t  -1, 0 or +1
+         */
+        constexpr auto classify(const PgPoint& point) const -> std::int8_t {
+            if (const auto val = detail::conic_form_value(coef_, point.coord)) {
+                return static_cast<std::int8_t>((*val > 0) - (*val < 0));
+            }
+            const auto [a_c, b_c, c_c, d_c, e_c, f_c] = coef_;
+            const Int256 px{point.coord[0]}, py{point.coord[1]}, pz{point.coord[2]};
+            const auto val = px * (Int256{a_c} * px + Int256{b_c} * py + Int256{d_c} * pz)
+                             + py * (Int256{b_c} * px + Int256{c_c} * py + Int256{e_c} * pz)
+                             + pz * (Int256{d_c} * px + Int256{e_c} * py + Int256{f_c} * pz);
+            if (val.is_negative()) return -1;
+            return val == Int256{0} ? 0 : 1;
+        }
+
+        /**
+         * @brief Classify a buffer of points (SoA) as inside, on or outside.
+         *
+         * A block of points small enough that the form cannot leave int64_t
+         * is evaluated by the SIMD kernel form_sign_batch; other blocks use
+         * the exact per-point path of classify(point).
+         *
+         * @param[in] points
+         * @param[out] out  same size as points; out[i] = classify(points[i])
+         */
+        void classify(CoordView points, std::span<std::int8_t> out) const {
+            assert(out.size() == points.size());
+            const auto isa = detect_simd_isa();
+            const auto coef_bits = this->coef_bits();
+            const auto n = points.size();
+            for (std::size_t first = 0; first < n; first += detail::conic_block) {
+                const auto len = std::min(detail::conic_block, n - first);
+                this->classify_block(isa, coef_bits,
+                                     CoordView{points.x.subspan(first, len),
+                                               points.y.subspan(first, len),
+                                               points.z.subspan(first, len)},
+                                     out.subspan(first, len));
+            }
+        }
+
+        /**
+         * @brief Classify a PointSoA as inside, on or outside.
+         *
+         * @param[in] points
+         * @param[out] out  same size as points
+         */
+        void classify(const PointSoA& points, std::span<std::int8_t> out) const {
+            this->classify(points.view(), out);
+        }
 
-            const auto& m = matrix_;
-            const auto val = x * (m[0][0] * x + m[0][1] * y + m[0][2] * z)
-                            + y * (m[1][0] * x + m[1][1] * y + m[1][2] * z)
-                            + z * (m[2][0] * x + m[2][1] * y + m[2][2] * z);
-            return val == Fraction{0, 1};
+        /**
+         * @brief Classify an array of points as inside, on or outside.
+         *
+         * Blocks of points are transposed into column buffers on the stack
+         * so that they can use the same SIMD kernel as the SoA variant.
+         *
+         * @param[in] points
+         * @param[out] out  same size as points; out[i] = classify(points[i])
+         */
+        void classify(std::span<const PgPoint> points, std::span<std::int8_t> out) const {
+            assert(out.size() == points.size());
+            const auto isa = detect_simd_isa();
+            const auto coef_bits = this->coef_bits();
+            const auto n = points.size();
+            using Column = std::array<std::int64_t, detail::conic_block>;
+            Column col_x;
+            Column col_y;
+            Column col_z;
+            for (std::size_t first = 0; first < n; first += detail::conic_block) {
+                const auto len = std::min(detail::conic_block, n - first);
+                for (std::size_t i = 0; i < len; ++i) {
+                    const auto& coord = points[first + i].coord;
+                    col_x[i] = coord[0];
+                    col_y[i] = coord[1];
+                    col_z[i] = coord[2];
+                }
+                this->classify_block(isa, coef_bits,
+                                     CoordView{std::span{col_x.data(), len},
+                                               std::span{col_y.data(), len},
+                                               std::span{col_z.data(), len}},
+                                     out.subspan(first, len));
+            }
         }
 
         /**
          * @brief Polar line of a point with respect to the conic.
          *
-         *  \f[ \mathbf{l} = Q \mathbf{x} \f]
+         *  \f[ \mathbf{l} = S \mathbf{x} \f]
          * @param[in] point  The point.
          * @return PgLine
+         * @throws std::overflow_error if the reduced line does not fit into int64_t.
          */
         constexpr auto polar(const PgPoint& point) const -> PgLine {
-            const Fraction x{point.coord[0], 1};
-            const Fraction y{point.coord[1], 1};
-            const Fraction z{point.coord[2], 1};
-
-            const auto& m = matrix_;
-            const auto a = m[0][0] * x + m[0][1] * y + m[0][2] * z;
-            const auto b = m[1][0] * x + m[1][1] * y + m[1][2] * z;
-            const auto c = m[2][0] * x + m[2][1] * y + m[2][2] * z;
-
-            return PgLine{{a.numer() / a.denom(), b.numer() / b.denom(), c.numer() / c.denom()}};
+            return PgLine{detail::checked_narrow(detail::conic_polar(coef_, point.coord))};
         }
 
         /**
          * @brief Tangent line at a point on the conic.
          *
          * At a point \f$\mathbf{p}\f$ on the conic, the tangent is the polar:
-         * \f[ \mathbf{t} = Q \mathbf{p} \f]
+         * \f[ \mathbf{t} = S \mathbf{p} \f]
          * @param[in] point  A point on the conic.
          * @return PgLine
          */
@@ -146,26 +674,55 @@ namespace fun {
         }
 
         /**
-         * @brief Intersection of a line with the conic (placeholder).
+         * @brief Intersection of a line with the conic, computed exactly.
          *
-         *  Currently returns an empty vector.
+         * With two points P, R spanning the line, sP + tR lies on the conic iff
+         *  \f[ a s^2 + 2 b s t + c t^2 = 0,
+         *      \quad a = P^T S P,\ b = P^T S R,\ c = R^T S R \f]
+         * where S is the integer form of the conic. The roots
+         * \f$(s:t) = (-b \pm \sqrt{\Delta} : a)\f$, \f$\Delta = b^2 - a c\f$, are
+         * rational iff Δ is a perfect square.
          * @param[in] line  The line.
-         * @return std::vector<PgPoint>  (0, 1, or 2 points).
+         * @return ConicMeet  (0, 1, or 2 points).
+         * @throws std::overflow_error if an intermediate does not fit.
          */
-        [[nodiscard]] auto intersect(const PgLine& line) const -> std::vector<PgPoint> {
-            (void)line;
-            return {};
+        [[nodiscard]] constexpr auto intersect(const PgLine& line) const -> ConicMeet {
+            return meet(this->int_matrix(), line);
+        }
+
+        /**
+         * @brief Intersect many lines with the conic.
+         *
+         * S and its adjugate are computed once. The discriminant of a line l has
+         * the sign of \f$-\mathbf{l}^T \operatorname{adj}(S)\, \mathbf{l}\f$, so a
+         * line that misses the conic costs one quadratic form.
+         * @param[in] lines
+         * @param[out] out  out[i] = intersect(lines[i])
+         * @throws std::overflow_error if an intermediate does not fit.
+         */
+        void intersect(std::span<const PgLine> lines, std::span<ConicMeet> out) const {
+            assert(out.size() == lines.size());
+            const auto sym = this->int_matrix();
+            const auto adj = detail::conic_adjugate(sym);
+            for (std::size_t i = 0; i < lines.size(); ++i) {
+                if (adj && detail::conic_misses(*adj, lines[i])) {
+                    out[i] = ConicMeet{};
+                } else {
+                    out[i] = meet(sym, lines[i]);
+                }
+            }
         }
 
         /**
          * @brief Discriminant of the conic (det of the 2x2 upper-left block).
          *
-         *  \f[ \Delta = a e - b d \f]
+         *  \f[ \Delta = a c - b^2 \f]
          *   >0 → ellipse, =0 → parabola, <0 → hyperbola.
-         * @return Fraction
+         * @return Rational
+         * @throws std::overflow_error if the discriminant does not fit into int64_t.
          */
-        constexpr auto discriminant() const -> Fraction {
-            return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+        constexpr auto discriminant() const -> Rational {
+            return Rational{detail::checked_narrow(this->wide_discriminant())};
         }
 
         /**
@@ -173,21 +730,212 @@ namespace fun {
          * @return ConicType
          */
         constexpr auto conic_type() const -> ConicType {
-            const auto d = discriminant();
-            if (d > Fraction{0, 1}) return ConicType::Ellipse;
-            if (d == Fraction{0, 1}) return ConicType::Parabola;
+            const auto disc = this->wide_discriminant();
+            if (disc > 0) return ConicType::Ellipse;
+            if (disc == 0) return ConicType::Parabola;
             return ConicType::Hyperbola;
         }
 
-        /** @brief Access the matrix. */
-        constexpr auto matrix() const -> const Mat3x3& { return matrix_; }
+        /** @brief The integer coefficients (a, b, c, d, e, f). */
+        constexpr auto coefficients() const noexcept -> const Coeffs& { return coef_; }
 
-        constexpr auto operator==(const Conic& other) const -> bool {
-            return matrix_ == other.matrix_;
+        /** @brief The matrix S (a positive multiple of Q). */
+        constexpr auto matrix() const -> Mat3x3 {
+            const auto sym = this->int_matrix();
+            Mat3x3 res{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) res[i][j] = Rational{sym[i][j]};
+            }
+            return res;
         }
 
+        constexpr auto operator==(const Conic& other) const -> bool = default;
+
       private:
-        Mat3x3 matrix_;
+        Coeffs coef_;
+
+        using IntMat3x3 = std::array<std::array<std::int64_t, 3>, 3>;
+
+        constexpr auto int_matrix() const noexcept -> IntMat3x3 {
+            const auto [a_c, b_c, c_c, d_c, e_c, f_c] = coef_;
+            return {{{a_c, b_c, d_c}, {b_c, c_c, e_c}, {d_c, e_c, f_c}}};
+        }
+
+        enum class Fit { Unique, Degenerate, TooLarge };
+
+        /// Coefficients of the conic through five points, if unique and representable.
+        static constexpr auto fit(const std::array<PgPoint, 5>& points, Coeffs& coef) -> Fit {
+            std::array<std::array<std::int64_t, 3>, 5> pts{};
+            std::uint64_t mags = 0;
+            for (std::size_t i = 0; i < 5; ++i) {
+                // scaling a point does not change the conic
+                const auto& crd = points[i].coord;
+                const auto common = binary_gcd(
+                    binary_gcd(magnitude(crd[0]), magnitude(crd[1])), magnitude(crd[2]));
+                for (std::size_t k = 0; k < 3; ++k) {
+                    pts[i][k] = common > 1 ? crd[k] / static_cast<std::int64_t>(common) : crd[k];
+                    mags |= magnitude(pts[i][k]);
+                }
+            }
+            // entries stay below 2^e with e = 2 b + 1; the minors below 2^(5 e + 7)
+            const auto entry_bits = 2 * std::bit_width(mags) + 1;
+            if (5 * entry_bits + 7 <= static_cast<int>(sizeof(detail::int_wide) * 8) - 1) {
+                return fit_as<detail::int_wide>(pts, coef);
+            }
+            return fit_as<detail::ConicFitWide>(pts, coef);
+        }
+
+        template <typename T>
+        static constexpr auto fit_as(const std::array<std::array<std::int64_t, 3>, 5>& pts,
+                                     Coeffs& coef) -> Fit {
+            std::array<std::array<T, 6>, 5> mat{};
+            for (std::size_t i = 0; i < 5; ++i) {
+                const T px(pts[i][0]), py(pts[i][1]), pz(pts[i][2]);
+                const T two(2);
+                mat[i] = {px * px, two * px * py, py * py, two * px * pz, two * py * pz, pz * pz};
+            }
+            const auto vec = detail::conic_null_vector(mat);
+            bool zero = true;
+            for (const auto& val : vec) zero = zero && val == T(0);
+            if (zero) return Fit::Degenerate;
+            return detail::conic_fit_coeffs(vec, coef) ? Fit::Unique : Fit::TooLarge;
+        }
+
+        /// Bit width of the largest coefficient magnitude.
+        constexpr auto coef_bits() const noexcept -> int {
+            std::uint64_t mags = 0;
+            for (const auto val : coef_) mags |= magnitude(val);
+            return std::bit_width(mags);
+        }
+
+        /**
+         * @brief One block of classify.
+         *
+         * If every coordinate has at most b bits and every coefficient at most
+         * a bits, the nine terms of the form sum to less than 2^(a + 2b + 4),
+         * so the wrapping SIMD products are exact when a + 2b + 4 <= 63.
+         */
+        void classify_block(SimdIsa isa, int coef_bits, CoordView points,
+                            std::span<std::int8_t> out) const {
+            std::uint64_t mags = 0;
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                mags |= magnitude(points.x[i]) | magnitude(points.y[i]) | magnitude(points.z[i]);
+            }
+            if (coef_bits + 2 * std::bit_width(mags) + 4 <= 63) {
+                form_sign_batch(isa, this->int_matrix(), points, out);
+                return;
+            }
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                out[i] = this->classify(PgPoint({points.x[i], points.y[i], points.z[i]}));
+            }
+        }
+
+        constexpr auto wide_discriminant() const -> detail::int_wide {
+            return detail::checked_sub(detail::checked_mul(coef_[0], coef_[2]),
+                                       detail::checked_mul(coef_[1], coef_[1]));
+        }
+
+        /// Divide out the positive common factor.
+        static constexpr auto reduced(Coeffs coef) -> Coeffs {
+            std::uint64_t common = 0;
+            for (const auto val : coef) common = binary_gcd(common, magnitude(val));
+            if (common > 1) {
+                // in magnitudes: a common factor of 2^63 does not fit into int64_t
+                for (auto& val : coef) {
+                    const auto mag = static_cast<std::int64_t>(magnitude(val) / common);
+                    val = val < 0 ? -mag : mag;
+                }
+            }
+            return coef;
+        }
+
+        /// lcd * (Q + Q^T) / 2 as coprime integers.
+        static constexpr auto from_rational(const Mat3x3& matrix) -> Coeffs {
+            constexpr std::array<std::array<std::size_t, 2>, 6> kEntries{
+                {{0, 0}, {0, 1}, {1, 1}, {0, 2}, {1, 2}, {2, 2}}};
+            std::array<Rational, 6> sym{};
+            std::int64_t lcd = 1;
+            for (std::size_t k = 0; k < 6; ++k) {
+                const auto [i, j] = kEntries[k];
+                sym[k] = matrix[i][j] == matrix[j][i]
+                             ? matrix[i][j]
+                             : (matrix[i][j] + matrix[j][i]) / std::int64_t{2};
+                const auto den = sym[k].den();
+                if (mul_overflow(lcd / std::gcd(lcd, den), den, lcd)) {
+                    throw std::overflow_error{"Conic: common denominator does not fit"};
+                }
+            }
+            Coeffs res{};
+            for (std::size_t k = 0; k < 6; ++k) {
+                if (mul_overflow(sym[k].num(), lcd / sym[k].den(), res[k])) {
+                    throw std::overflow_error{"Conic: common denominator does not fit"};
+                }
+            }
+            return reduced(res);
+        }
+
+        /// Intersect a line with the integer conic S.
+        static constexpr auto meet(const IntMat3x3& sym, const PgLine& line) -> ConicMeet {
+            using detail::checked_add;
+            using detail::checked_mul;
+            using detail::checked_sub;
+            using detail::int_wide;
+            const int_wide l0 = line.coord[0], l1 = line.coord[1], l2 = line.coord[2];
+            std::array<int_wide, 3> pt_p{}, pt_r{};
+            if (l0 != 0) {
+                pt_p = {l1, checked_sub(0, l0), 0};
+                pt_r = {l2, 0, checked_sub(0, l0)};
+            } else if (l1 != 0) {
+                pt_p = {l1, 0, 0};
+                pt_r = {0, l2, checked_sub(0, l1)};
+            } else {
+                pt_p = {l2, 0, 0};
+                pt_r = {0, l2, 0};
+            }
+            const auto a_coef = detail::conic_form(sym, pt_p, pt_p);
+            const auto b_coef = detail::conic_form(sym, pt_p, pt_r);
+            const auto c_coef = detail::conic_form(sym, pt_r, pt_r);
+            if (a_coef == 0) {
+                // t (2 b s + c t) = 0
+                if (b_coef != 0) {
+                    return ConicMeet::secant(detail::conic_point(1, pt_p, 0, pt_r),
+                                             detail::conic_point(checked_sub(0, c_coef), pt_p,
+                                                                 checked_mul(2, b_coef), pt_r));
+                }
+                if (c_coef == 0) return ConicMeet::whole_line();
+                return ConicMeet::tangent(detail::conic_point(1, pt_p, 0, pt_r));
+            }
+            const auto disc = checked_sub(checked_mul(b_coef, b_coef), checked_mul(a_coef, c_coef));
+            if (disc < 0) return ConicMeet{};
+            const auto minus_b = checked_sub(0, b_coef);
+            if (disc == 0) {
+                return ConicMeet::tangent(detail::conic_point(minus_b, pt_p, a_coef, pt_r));
+            }
+            if ((detail::conic_squares_mod64 >> static_cast<unsigned>(disc & 63)) & 1U) {
+                const auto root = detail::conic_isqrt(disc);
+                if (root * root == disc) {
+                    return ConicMeet::secant(
+                        detail::conic_point(checked_add(minus_b, root), pt_p, a_coef, pt_r),
+                        detail::conic_point(checked_sub(minus_b, root), pt_p, a_coef, pt_r));
+                }
+            }
+            // (-b P + a R) + factor P sqrt(radicand), with disc = factor^2 radicand
+            auto radicand = disc;
+            const auto factor = detail::conic_square_part(radicand);
+            std::array<int_wide, 6> parts{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                parts[i] = checked_add(checked_mul(minus_b, pt_p[i]), checked_mul(a_coef, pt_r[i]));
+                parts[i + 3] = checked_mul(factor, pt_p[i]);
+            }
+            detail::wide_reduce(parts);
+            const Rational rad{detail::checked_narrow(radicand)};
+            ConicMeet::IrrationalPoint root{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                root[i] = ConicMeet::Coord{Rational{detail::checked_narrow(parts[i])},
+                                           Rational{detail::checked_narrow(parts[i + 3])}, rad};
+            }
+            return ConicMeet::conjugate(root);
+        }
     };
 
 }  // namespace fun
@@ -5,7 +5,7 @@
 #pragma once
 
 #include "euclid_plane.hpp"
-// #include "fractions.hpp"
+#include "fractions.hpp"  // import Fraction
 
 namespace fun {
 
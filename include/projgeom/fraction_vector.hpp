@@ -0,0 +1,484 @@
+/** @file fraction_vector.hpp
+ *  @brief Columnar container of Fraction<int64_t> with batched kernels.
+ *
+ *  Numerators and denominators live in two separate contiguous columns, so
+ *  batched add/mul/compare kernels stream over them with unit stride, and
+ *  the common small-operand case avoids 128-bit arithmetic. Sorting orders
+ *  compact (double key, index) records with an exact tie-break and can use
+ *  several threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "binary_gcd.hpp"
+#include "fractions.hpp"
+#include "int128.hpp"
+#include "run_blocks.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Read-only view of fractions stored column-wise.
+     *
+     * The i-th fraction is num[i] / den[i] with den[i] > 0, in lowest terms.
+     */
+    struct FractionView {
+        std::span<const std::int64_t> num;
+        std::span<const std::int64_t> den;
+
+        /**
+         * @brief Number of fractions in the view.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return num.size(); }
+    };
+
+    /**
+     * @brief Writable view of fractions stored column-wise.
+     */
+    struct FractionSpan {
+        std::span<std::int64_t> num;
+        std::span<std::int64_t> den;
+
+        /**
+         * @brief Number of fractions in the span.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return num.size(); }
+
+        /**
+         * @brief Convert to a read-only view.
+         *
+         * @return FractionView
+         */
+        constexpr operator FractionView() const noexcept { return {num, den}; }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Fraction<int64_t> from a numerator and denominator already in lowest terms.
+         */
+        inline auto make_reduced(std::int64_t num, std::int64_t den) -> Fraction<std::int64_t> {
+            Fraction<std::int64_t> res;
+            res._num = num;
+            res._den = den;
+            return res;
+        }
+
+        inline auto gcd64(std::int64_t lhs, std::int64_t rhs) -> std::int64_t {
+            return static_cast<std::int64_t>(binary_gcd(magnitude(lhs), magnitude(rhs)));
+        }
+
+        /**
+         * @brief a/b + c/d in lowest terms for reduced operands below 2^31 (Knuth 4.5.1).
+         *
+         * The gcds are taken of the small denominators rather than of the
+         * full cross products.
+         */
+        inline void add_small(std::int64_t a_num, std::int64_t b_den, std::int64_t c_num,
+                              std::int64_t d_den, std::int64_t& out_num, std::int64_t& out_den) {
+            const auto common = gcd64(b_den, d_den);
+            if (common == 1) {
+                out_num = a_num * d_den + c_num * b_den;
+                out_den = b_den * d_den;
+                return;
+            }
+            const auto b_part = b_den / common;
+            const auto num = a_num * (d_den / common) + c_num * b_part;
+            const auto common2 = gcd64(num, common);
+            out_num = num / common2;
+            out_den = b_part * (d_den / common2);
+        }
+
+        /**
+         * @brief (a/b)(c/d) in lowest terms for reduced operands below 2^31.
+         */
+        inline void mul_small(std::int64_t a_num, std::int64_t b_den, std::int64_t c_num,
+                              std::int64_t d_den, std::int64_t& out_num, std::int64_t& out_den) {
+            const auto common_ad = gcd64(a_num, d_den);
+            const auto common_cb = gcd64(c_num, b_den);
+            out_num = (a_num / common_ad) * (c_num / common_cb);
+            out_den = (b_den / common_cb) * (d_den / common_ad);
+        }
+
+        /// Sort record of argsort: double approximation plus original index.
+        struct SortKey {
+            double approx;
+            std::uint32_t idx;
+            std::uint32_t approx_exact;  ///< nonzero if approx is the correctly rounded value
+        };
+
+        inline auto make_sort_key(std::int64_t num, std::int64_t den, std::size_t idx)
+            -> SortKey {
+            constexpr std::int64_t kExact = std::int64_t{1} << 53;
+            const bool exact = num > -kExact && num < kExact && den < kExact;
+            return {static_cast<double>(num) / static_cast<double>(den),
+                    static_cast<std::uint32_t>(idx), std::uint32_t{exact}};
+        }
+
+        /**
+         * @brief Sort one run per thread concurrently, then merge runs pairwise.
+         *
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         */
+        template <typename Iter, typename Less>
+        void parallel_sort(Iter first, Iter last, Less less, std::size_t num_threads) {
+            constexpr std::size_t kMinRun = 4096;
+            const auto n = static_cast<std::size_t>(last - first);
+            num_threads
+                = std::min(resolve_threads(num_threads), std::max<std::size_t>(1, n / kMinRun));
+            if (num_threads <= 1) {
+                std::sort(first, last, less);
+                return;
+            }
+            auto at = [first](std::size_t pos) { return first + static_cast<std::ptrdiff_t>(pos); };
+            // one task per run, each on its own thread
+            auto run_parallel = [](std::size_t count, const auto& task) {
+                run_blocks(count, count, task);
+            };
+            // run boundaries: bounds[k] .. bounds[k + 1]
+            std::vector<std::size_t> bounds(num_threads + 1);
+            for (std::size_t k = 0; k <= num_threads; ++k) {
+                bounds[k] = n * k / num_threads;
+            }
+            run_parallel(num_threads,
+                         [&](std::size_t k) { std::sort(at(bounds[k]), at(bounds[k + 1]), less); });
+            while (bounds.size() > 2) {
+                run_parallel((bounds.size() - 1) / 2, [&](std::size_t k) {
+                    std::inplace_merge(at(bounds[2 * k]), at(bounds[2 * k + 1]),
+                                       at(bounds[2 * k + 2]), less);
+                });
+                std::vector<std::size_t> merged;
+                for (std::size_t k = 0; k < bounds.size(); k += 2) {
+                    merged.push_back(bounds[k]);
+                }
+                if (merged.back() != n) {
+                    merged.push_back(n);
+                }
+                bounds = std::move(merged);
+            }
+        }
+
+        /// Fractions per block of the batched kernels.
+        constexpr std::size_t fraction_block = 256;
+
+        /**
+         * @brief Are all entries of [first, last) of both views below 2^31 in magnitude?
+         */
+        inline auto block_small(FractionView lhs, FractionView rhs, std::size_t first,
+                                std::size_t last) -> bool {
+            constexpr std::int64_t kLimit = std::int64_t{1} << 31;
+            bool small = true;
+            for (std::size_t i = first; i < last; ++i) {
+                // den > 0, so only the numerators need the lower bound
+                small &= (lhs.num[i] > -kLimit) & (lhs.num[i] < kLimit) & (lhs.den[i] < kLimit)
+                         & (rhs.num[i] > -kLimit) & (rhs.num[i] < kLimit)
+                         & (rhs.den[i] < kLimit);
+            }
+            return small;
+        }
+
+        /**
+         * @brief Exact sign of a/b - c/d for positive b, d.
+         */
+        inline auto fraction_cmp(std::int64_t a_num, std::int64_t b_den, std::int64_t c_num,
+                                 std::int64_t d_den) -> int {
+#if PROJGEOM_HAS_INT128
+            const auto lhs = int128_t(a_num) * d_den;
+            const auto rhs = int128_t(c_num) * b_den;
+            return (lhs > rhs) - (lhs < rhs);
+#else
+            const auto diff = make_reduced(a_num, b_den) - make_reduced(c_num, d_den);
+            return (diff.num() > 0) - (diff.num() < 0);
+#endif
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Structure-of-arrays container of Fraction<int64_t>.
+     *
+     * Every entry is kept in lowest terms with a positive denominator, the
+     * same canonical form as Fraction<int64_t>.
+     */
+    class FractionVector {
+      public:
+        using value_type = Fraction<std::int64_t>;
+
+        /**
+         * @brief Construct an empty container.
+         */
+        FractionVector() = default;
+
+        /**
+         * @brief Construct a container of n zeros (0/1).
+         *
+         * @param[in] n number of fractions
+         */
+        explicit FractionVector(std::size_t n) : num_(n, 0), den_(n, 1) {}
+
+        /**
+         * @brief Construct a container from an array of fractions.
+         *
+         * @param[in] fracs fractions to copy
+         */
+        explicit FractionVector(std::span<const Fraction<std::int64_t>> fracs) {
+            this->reserve(fracs.size());
+            for (const auto& frac : fracs) {
+                this->push_back(frac);
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return num_.size(); }
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return num_.empty(); }
+
+        void reserve(std::size_t n) {
+            num_.reserve(n);
+            den_.reserve(n);
+        }
+
+        void resize(std::size_t n) {
+            num_.resize(n, 0);
+            den_.resize(n, 1);
+        }
+
+        void clear() noexcept {
+            num_.clear();
+            den_.clear();
+        }
+
+        /**
+         * @brief Append a fraction.
+         *
+         * @param[in] frac
+         */
+        void push_back(const Fraction<std::int64_t>& frac) {
+            num_.push_back(frac.num());
+            den_.push_back(frac.den());
+        }
+
+        /**
+         * @brief Append num / den, brought to lowest terms.
+         *
+         * @param[in] num
+         * @param[in] den must be nonzero
+         */
+        void push_back(std::int64_t num, std::int64_t den) {
+            this->push_back(Fraction<std::int64_t>(num, den));
+        }
+
+        /**
+         * @brief Gather the i-th fraction.
+         *
+         * @param[in] idx
+         * @return Fraction<std::int64_t>
+         */
+        [[nodiscard]] auto operator[](std::size_t idx) const -> Fraction<std::int64_t> {
+            return detail::make_reduced(num_[idx], den_[idx]);
+        }
+
+        /**
+         * @brief Scatter a fraction into the i-th slot.
+         *
+         * @param[in] idx
+         * @param[in] frac
+         */
+        void set(std::size_t idx, const Fraction<std::int64_t>& frac) {
+            num_[idx] = frac.num();
+            den_[idx] = frac.den();
+        }
+
+        [[nodiscard]] auto num() const noexcept -> std::span<const std::int64_t> { return num_; }
+        [[nodiscard]] auto den() const noexcept -> std::span<const std::int64_t> { return den_; }
+
+        /**
+         * @brief Read-only column view.
+         *
+         * @return FractionView
+         */
+        [[nodiscard]] auto view() const noexcept -> FractionView { return {num_, den_}; }
+
+        /**
+         * @brief Writable column view.
+         *
+         * Writers must keep every entry in lowest terms with a positive
+         * denominator.
+         *
+         * @return FractionSpan
+         */
+        [[nodiscard]] auto span() noexcept -> FractionSpan { return {num_, den_}; }
+
+      private:
+        std::vector<std::int64_t> num_;
+        std::vector<std::int64_t> den_;
+    };
+
+    // ---- column kernels -----------------------------------------------------
+
+    /**
+     * @brief Batched sum: out[i] = lhs[i] + rhs[i].
+     *
+     * Blocks whose operands are all below 2^31 stay in int64 arithmetic;
+     * other blocks go through Fraction<int64_t>, which widens to 128 bits.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs (may alias lhs or rhs)
+     * @throws std::overflow_error if a reduced sum does not fit into int64_t
+     */
+    inline void add(FractionView lhs, FractionView rhs, FractionSpan out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        const auto n = lhs.size();
+        for (std::size_t first = 0; first < n; first += detail::fraction_block) {
+            const auto last = std::min(first + detail::fraction_block, n);
+            if (!detail::block_small(lhs, rhs, first, last)) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const auto sum = detail::make_reduced(lhs.num[i], lhs.den[i])
+                                     + detail::make_reduced(rhs.num[i], rhs.den[i]);
+                    out.num[i] = sum.num();
+                    out.den[i] = sum.den();
+                }
+                continue;
+            }
+            for (std::size_t i = first; i < last; ++i) {
+                detail::add_small(lhs.num[i], lhs.den[i], rhs.num[i], rhs.den[i], out.num[i],
+                                  out.den[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Batched product: out[i] = lhs[i] * rhs[i].
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs (may alias lhs or rhs)
+     * @throws std::overflow_error if a reduced product does not fit into int64_t
+     */
+    inline void mul(FractionView lhs, FractionView rhs, FractionSpan out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        const auto n = lhs.size();
+        for (std::size_t first = 0; first < n; first += detail::fraction_block) {
+            const auto last = std::min(first + detail::fraction_block, n);
+            if (!detail::block_small(lhs, rhs, first, last)) {
+                for (std::size_t i = first; i < last; ++i) {
+                    const auto prod = detail::make_reduced(lhs.num[i], lhs.den[i])
+                                      * detail::make_reduced(rhs.num[i], rhs.den[i]);
+                    out.num[i] = prod.num();
+                    out.den[i] = prod.den();
+                }
+                continue;
+            }
+            for (std::size_t i = first; i < last; ++i) {
+                detail::mul_small(lhs.num[i], lhs.den[i], rhs.num[i], rhs.den[i], out.num[i],
+                                  out.den[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief Batched three-way compare: out[i] = sign(lhs[i] - rhs[i]).
+     *
+     * @f[
+     *     \operatorname{sign}(a_i d_i - c_i b_i), \quad b_i, d_i > 0
+     * @f]
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out -1, 0 or 1 per fraction
+     */
+    inline void compare(FractionView lhs, FractionView rhs, std::span<std::int8_t> out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        const auto n = lhs.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<std::int8_t>(
+                detail::fraction_cmp(lhs.num[i], lhs.den[i], rhs.num[i], rhs.den[i]));
+        }
+    }
+
+    /**
+     * @brief Permutation that sorts the fractions in ascending order.
+     *
+     * Each entry is keyed by its correctly rounded double value. When every
+     * numerator and denominator is an exact double (below 2^53), rounding is
+     * monotone, so the records are sorted by the double key alone and only
+     * runs of equal keys are re-sorted with the exact 128-bit
+     * cross-multiplication. Otherwise the exact compare decides whenever a
+     * key is not exact.
+     *
+     * @param[in] fracs
+     * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+     * @return std::vector<std::size_t> indices such that fracs[idx[0]] <= fracs[idx[1]] <= ...
+     */
+    inline auto argsort(FractionView fracs, std::size_t num_threads = 0)
+        -> std::vector<std::size_t> {
+        const auto n = fracs.size();
+        assert(n <= std::size_t{0xFFFFFFFF});
+        std::vector<detail::SortKey> keys(n);
+        bool all_exact = true;
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = detail::make_sort_key(fracs.num[i], fracs.den[i], i);
+            all_exact = all_exact && keys[i].approx_exact != 0;
+        }
+        auto exact_less = [&fracs](const detail::SortKey& lhs, const detail::SortKey& rhs) {
+            if ((lhs.approx_exact & rhs.approx_exact) != 0 && lhs.approx != rhs.approx) {
+                return lhs.approx < rhs.approx;
+            }
+            return detail::fraction_cmp(fracs.num[lhs.idx], fracs.den[lhs.idx],
+                                        fracs.num[rhs.idx], fracs.den[rhs.idx])
+                   < 0;
+        };
+        if (all_exact) {
+            detail::parallel_sort(
+                keys.begin(), keys.end(),
+                [](const detail::SortKey& lhs, const detail::SortKey& rhs) {
+                    return lhs.approx < rhs.approx;
+                },
+                num_threads);
+            for (auto first = keys.begin(); first != keys.end();) {
+                auto last = std::find_if(first + 1, keys.end(), [&first](const auto& key) {
+                    return key.approx != first->approx;
+                });
+                if (last - first > 1) {
+                    std::sort(first, last, exact_less);
+                }
+                first = last;
+            }
+        } else {
+            detail::parallel_sort(keys.begin(), keys.end(), exact_less, num_threads);
+        }
+        std::vector<std::size_t> idx(n);
+        std::transform(keys.begin(), keys.end(), idx.begin(),
+                       [](const detail::SortKey& key) { return std::size_t{key.idx}; });
+        return idx;
+    }
+
+    /**
+     * @brief Sort the fractions in ascending order (exact, optionally multi-threaded).
+     *
+     * @param[in,out] fracs
+     * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+     */
+    inline void sort(FractionVector& fracs, std::size_t num_threads = 0) {
+        const auto idx = argsort(fracs.view(), num_threads);
+        FractionVector sorted(idx.size());
+        auto out = sorted.span();
+        for (std::size_t k = 0; k < idx.size(); ++k) {
+            out.num[k] = fracs.num()[idx[k]];
+            out.den[k] = fracs.den()[idx[k]];
+        }
+        fracs = std::move(sorted);
+    }
+
+}  // namespace fun
@@ -7,11 +7,15 @@
 
 // #include <boost/operators.hpp>
 // #include <cmath>
+#include <cstdint>
 #include <numeric>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "binary_gcd.hpp"
 #include "common_concepts.h"
+#include "int128.hpp"
 
 namespace fun {
 
@@ -54,16 +58,23 @@ namespace fun {
      *         \gcd(|m|, n \bmod |m|) & \text{otherwise}
      *     \end{cases}
      * @f]
+     * Builtin integers up to 64 bits use the binary (Stein) gcd; other types
+     * use the iterative Euclidean loop.
      * @tparam Mn
      * @param[in] _m
      * @param[in] _n
      * @return Mn
      */
     template <Integral Mn> constexpr auto gcd(const Mn& _m, const Mn& _n) -> Mn {
-        if (_m == 0) {
-            return abs(_n);
+        if constexpr (std::is_integral_v<Mn> && sizeof(Mn) <= sizeof(std::uint64_t)) {
+            if constexpr (std::is_signed_v<Mn>) {
+                return static_cast<Mn>(binary_gcd(magnitude(_m), magnitude(_n)));
+            } else {
+                return static_cast<Mn>(binary_gcd(_m, _n));
+            }
+        } else {
+            return gcd_iterative(_m, _n);
         }
-        return gcd_recur(_m, _n);
     }
 
     /**
@@ -84,15 +95,79 @@ namespace fun {
         return (abs(_m) / gcd(_m, _n)) * abs(_n);
     }
 
+    namespace detail {
+
+        /**
+         * @brief Are all operands below 2^31 in magnitude?
+         *
+         * Then a d + b c cannot overflow int64_t, so the plain int64 formulas
+         * are exact.
+         */
+        template <typename... Ts> constexpr auto all_small(const Ts&... vals) noexcept -> bool {
+            constexpr std::int64_t kLimit = std::int64_t{1} << 31;
+            return ((vals > -kLimit && vals < kLimit) && ...);
+        }
+
+    }  // namespace detail
+
     /**
      * @brief Fraction
      *
+     * For Z = std::int64_t, products and cross products of large operands are
+     * formed in 128 bits and reduced before narrowing back; a result that
+     * still does not fit into int64_t throws std::overflow_error.
+     *
      * @tparam Z
      */
     template <Integral Z> struct Fraction {
         Z _num;
         Z _den;
 
+#if PROJGEOM_HAS_INT128
+        /// Whether the 128-bit intermediate paths are used.
+        static constexpr bool kWide = std::is_same_v<Z, std::int64_t>;
+
+        /**
+         * @brief Reduce a 128-bit intermediate ratio and narrow it back to int64_t.
+         *
+         * @param[in] num
+         * @param[in] den
+         * @return Fraction
+         * @throws std::overflow_error if the reduced ratio does not fit into int64_t
+         */
+        static constexpr auto from_wide(int128_t num, int128_t den) -> Fraction {
+            if (den < 0) {
+                num = -num;
+                den = -den;
+            }
+            const auto mag = num < 0 ? uint128_t(0) - uint128_t(num) : uint128_t(num);
+            const auto common = static_cast<int128_t>(binary_gcd_u128(mag, uint128_t(den)));
+            if (common > 1) {
+                num /= common;
+                den /= common;
+            }
+            if (!fits_int64(num) || !fits_int64(den)) {
+                throw std::overflow_error{"Fraction<int64_t>: result does not fit into int64_t"};
+            }
+            Fraction res;
+            res._num = static_cast<Z>(num);
+            res._den = static_cast<Z>(den);
+            return res;
+        }
+
+        /**
+         * @brief Sign of a d - b c for int64 operands, exact in 128 bits.
+         */
+        static constexpr auto cross_sign(const Z& a_num, const Z& b_den, const Z& c_num,
+                                         const Z& d_den) noexcept -> int {
+            const auto lhs = int128_t(a_num) * d_den;
+            const auto rhs = int128_t(b_den) * c_num;
+            return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+        }
+#else
+        static constexpr bool kWide = false;
+#endif
+
         /**
          * @brief Construct a new Fraction object from two values.
          *
@@ -131,6 +206,9 @@ namespace fun {
          * denominator is always co-prime with numerator
          */
         constexpr auto normalize2() -> Z {
+            if (this->_den == Z(1)) {
+                return Z(1);
+            }
             Z common = gcd(this->_num, this->_den);
             if (common == Z(1) || common == Z(0)) {
                 return common;
@@ -196,6 +274,11 @@ namespace fun {
          * @return false
          */
         friend constexpr auto operator==(Fraction lhs, Z rhs) -> bool {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                return cross_sign(lhs._num, lhs._den, rhs, Z(1)) == 0;
+            }
+#endif
             if (lhs._den == Z(1) || rhs == Z(0)) {
                 return lhs._num == rhs;
             }
@@ -213,10 +296,15 @@ namespace fun {
          * @return false
          */
         friend constexpr auto operator<(Fraction lhs, Z rhs) -> bool {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                return cross_sign(lhs._num, lhs._den, rhs, Z(1)) < 0;
+            }
+#endif
             if (lhs._den == Z(1) || rhs == Z(0)) {
                 return lhs._num < rhs;
             }
-            std::swap(lhs._den, rhs._num);
+            std::swap(lhs._den, rhs);
             lhs.normalize2();
             return lhs._num < lhs._den * rhs;
         }
@@ -230,6 +318,11 @@ namespace fun {
          * @return false
          */
         friend constexpr auto operator<(Z lhs, Fraction rhs) -> bool {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                return cross_sign(lhs, Z(1), rhs._num, rhs._den) < 0;
+            }
+#endif
             if (rhs._den == Z(1) || lhs == Z(0)) {
                 return lhs < rhs._num;
             }
@@ -267,6 +360,11 @@ namespace fun {
          * @return false
          */
         constexpr friend auto operator==(Fraction lhs, Fraction rhs) -> bool {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                return cross_sign(lhs._num, lhs._den, rhs._num, rhs._den) == 0;
+            }
+#endif
             if (lhs._den == rhs._den) {
                 return lhs._num == rhs._num;
             }
@@ -285,6 +383,11 @@ namespace fun {
          * @return false
          */
         constexpr friend auto operator<(Fraction lhs, Fraction rhs) -> bool {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                return cross_sign(lhs._num, lhs._den, rhs._num, rhs._den) < 0;
+            }
+#endif
             if (lhs._den == rhs._den) {
                 return lhs._num < rhs._num;
             }
@@ -411,6 +514,14 @@ namespace fun {
          * @return Fraction&
          */
         constexpr auto operator*=(Fraction rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs._num, rhs._den)) {
+                    return *this = from_wide(int128_t(this->_num) * rhs._num,
+                                             int128_t(this->_den) * rhs._den);
+                }
+            }
+#endif
             std::swap(this->_num, rhs._num);
             this->normalize2();
             rhs.normalize2();
@@ -437,6 +548,13 @@ namespace fun {
          * @return Fraction&
          */
         constexpr auto operator*=(Z rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs)) {
+                    return *this = from_wide(int128_t(this->_num) * rhs, this->_den);
+                }
+            }
+#endif
             std::swap(this->_num, rhs);
             this->normalize2();
             this->_num *= rhs;
@@ -472,6 +590,14 @@ namespace fun {
          * @return Fraction&
          */
         constexpr auto operator/=(Fraction rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs._num, rhs._den)) {
+                    return *this = from_wide(int128_t(this->_num) * rhs._den,
+                                             int128_t(this->_den) * rhs._num);
+                }
+            }
+#endif
             std::swap(this->_den, rhs._num);
             this->normalize();
             rhs.normalize2();
@@ -497,7 +623,14 @@ namespace fun {
          * @param[in] rhs
          * @return Fraction&
          */
-        constexpr auto operator/=(const Z& rhs) -> Fraction& {
+        constexpr auto operator/=(Z rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs)) {
+                    return *this = from_wide(this->_num, int128_t(this->_den) * rhs);
+                }
+            }
+#endif
             std::swap(this->_den, rhs);
             this->normalize();
             this->_den *= rhs;
@@ -545,6 +678,15 @@ namespace fun {
          * @return Fraction
          */
         constexpr auto operator+(const Fraction& rhs) const -> Fraction {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs._num, rhs._den)) {
+                    return from_wide(int128_t(this->_num) * rhs._den
+                                         + int128_t(this->_den) * rhs._num,
+                                     int128_t(this->_den) * rhs._den);
+                }
+            }
+#endif
             if (this->_den == rhs._den) {
                 return Fraction(this->_num + rhs._num, this->_den);
             }
@@ -565,7 +707,10 @@ namespace fun {
          * @param[in] frac
          * @return Fraction
          */
-        constexpr auto operator-(const Fraction& frac) const -> Fraction { return *this + (-frac); }
+        constexpr auto operator-(const Fraction& frac) const -> Fraction {
+            auto res = *this;
+            return res -= frac;
+        }
 
         /**
          * @brief Add
@@ -591,7 +736,10 @@ namespace fun {
          * @param[in] i
          * @return Fraction
          */
-        constexpr auto operator-(const Z& i) const -> Fraction { return *this + (-i); }
+        constexpr auto operator-(const Z& i) const -> Fraction {
+            auto res = *this;
+            return res -= i;
+        }
 
         /**
          * @brief
@@ -599,7 +747,19 @@ namespace fun {
          * @param[in] rhs
          * @return Fraction
          */
-        constexpr auto operator+=(const Fraction& rhs) -> Fraction& { return *this -= (-rhs); }
+        constexpr auto operator+=(const Fraction& rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            // before the negation below, which overflows for INT64_MIN
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs._num, rhs._den)) {
+                    return *this = from_wide(int128_t(this->_num) * rhs._den
+                                                 + int128_t(this->_den) * rhs._num,
+                                             int128_t(this->_den) * rhs._den);
+                }
+            }
+#endif
+            return *this -= (-rhs);
+        }
 
         /**
          * @brief
@@ -608,6 +768,15 @@ namespace fun {
          * @return Fraction
          */
         constexpr auto operator-=(const Fraction& rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs._num, rhs._den)) {
+                    return *this = from_wide(int128_t(this->_num) * rhs._den
+                                                 - int128_t(this->_den) * rhs._num,
+                                             int128_t(this->_den) * rhs._den);
+                }
+            }
+#endif
             if (this->_den == rhs._den) {
                 this->_num -= rhs._num;
                 this->normalize2();
@@ -635,7 +804,16 @@ namespace fun {
          * @param[in] i
          * @return Fraction
          */
-        constexpr auto operator+=(const Z& i) -> Fraction& { return *this -= (-i); }
+        constexpr auto operator+=(const Z& i) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, i)) {
+                    return *this = from_wide(this->_num + int128_t(this->_den) * i, this->_den);
+                }
+            }
+#endif
+            return *this -= (-i);
+        }
 
         /**
          * @brief
@@ -644,6 +822,13 @@ namespace fun {
          * @return Fraction
          */
         constexpr auto operator-=(const Z& rhs) -> Fraction& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(this->_num, this->_den, rhs)) {
+                    return *this = from_wide(this->_num - int128_t(this->_den) * rhs, this->_den);
+                }
+            }
+#endif
             if (this->_den == Z(1)) {
                 this->_num -= rhs;
                 return *this;
@@ -667,6 +852,13 @@ namespace fun {
          * @return Fraction
          */
         friend constexpr auto operator-(const Z& c, const Fraction& frac) -> Fraction {
+#if PROJGEOM_HAS_INT128
+            if constexpr (kWide) {
+                if (!detail::all_small(frac._num, frac._den, c)) {
+                    return from_wide(int128_t(frac._den) * c - frac._num, frac._den);
+                }
+            }
+#endif
             return c + (-frac);
         }
 
@@ -689,7 +881,7 @@ namespace fun {
          * @return Fraction
          */
         friend constexpr auto operator-(int&& c, const Fraction& frac) -> Fraction {
-            return (-frac) + Z(c);
+            return Z(c) - frac;
         }
 
         /**
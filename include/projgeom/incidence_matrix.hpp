@@ -0,0 +1,256 @@
+/** @file incidence_matrix.hpp
+ *  @brief Packed points-by-lines incidence matrix with a tiled, multi-threaded builder.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "pg_soa.hpp"
+#include "run_blocks.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Dense incidence relation between N points and M lines.
+     *
+     * Row i holds one bit per line; bit j of row i is set iff point i is
+     * incident with line j. Rows are padded to a whole number of 64-bit
+     * words so that each row can be scanned with popcount.
+     */
+    class IncidenceMatrix {
+      public:
+        /**
+         * @brief Construct an all-zero matrix.
+         *
+         * @param[in] rows number of points
+         * @param[in] cols number of lines
+         */
+        IncidenceMatrix(std::size_t rows, std::size_t cols)
+            : rows_{rows}, cols_{cols}, words_per_row_{bit_words(cols)},
+              bits_(rows * words_per_row_, 0) {}
+
+        [[nodiscard]] auto rows() const noexcept -> std::size_t { return rows_; }
+        [[nodiscard]] auto cols() const noexcept -> std::size_t { return cols_; }
+        [[nodiscard]] auto words_per_row() const noexcept -> std::size_t { return words_per_row_; }
+
+        /**
+         * @brief Is point i incident with line j?
+         *
+         * @param[in] row
+         * @param[in] col
+         * @return bool
+         */
+        [[nodiscard]] auto test(std::size_t row, std::size_t col) const -> bool {
+            assert(row < rows_ && col < cols_);
+            return ((bits_[row * words_per_row_ + col / 64] >> (col % 64)) & 1U) != 0;
+        }
+
+        /**
+         * @brief Mark point i as incident with line j.
+         *
+         * @param[in] row
+         * @param[in] col
+         */
+        void set(std::size_t row, std::size_t col) {
+            assert(row < rows_ && col < cols_);
+            bits_[row * words_per_row_ + col / 64] |= std::uint64_t{1} << (col % 64);
+        }
+
+        /**
+         * @brief Packed words of row i.
+         *
+         * @param[in] row
+         * @return std::span<const std::uint64_t>
+         */
+        [[nodiscard]] auto row(std::size_t row) const -> std::span<const std::uint64_t> {
+            return {bits_.data() + row * words_per_row_, words_per_row_};
+        }
+
+        /**
+         * @brief Writable packed words of row i.
+         *
+         * @param[in] row
+         * @return std::span<std::uint64_t>
+         */
+        [[nodiscard]] auto row(std::size_t row) -> std::span<std::uint64_t> {
+            return {bits_.data() + row * words_per_row_, words_per_row_};
+        }
+
+        /**
+         * @brief Number of lines incident with point i.
+         *
+         * @param[in] row
+         * @return std::size_t
+         */
+        [[nodiscard]] auto row_count(std::size_t row) const -> std::size_t {
+            std::size_t count = 0;
+            for (const auto word : this->row(row)) {
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+        /**
+         * @brief Number of points incident with line j.
+         *
+         * @param[in] col
+         * @return std::size_t
+         */
+        [[nodiscard]] auto col_count(std::size_t col) const -> std::size_t {
+            assert(col < cols_);
+            const auto word = col / 64;
+            const auto shift = col % 64;
+            std::size_t count = 0;
+            for (std::size_t r = 0; r < rows_; ++r) {
+                count += (bits_[r * words_per_row_ + word] >> shift) & 1U;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Number of incident lines for every point.
+         *
+         * @return std::vector<std::size_t>
+         */
+        [[nodiscard]] auto row_counts() const -> std::vector<std::size_t> {
+            std::vector<std::size_t> counts(rows_);
+            for (std::size_t r = 0; r < rows_; ++r) {
+                counts[r] = this->row_count(r);
+            }
+            return counts;
+        }
+
+        /**
+         * @brief Number of incident points for every line (single pass over the matrix).
+         *
+         * @return std::vector<std::size_t>
+         */
+        [[nodiscard]] auto col_counts() const -> std::vector<std::size_t> {
+            std::vector<std::size_t> counts(cols_, 0);
+            for (std::size_t r = 0; r < rows_; ++r) {
+                const auto words = this->row(r);
+                for (std::size_t w = 0; w < words_per_row_; ++w) {
+                    for (auto word = words[w]; word != 0; word &= word - 1) {
+                        ++counts[w * 64 + static_cast<std::size_t>(std::countr_zero(word))];
+                    }
+                }
+            }
+            return counts;
+        }
+
+        /**
+         * @brief Total number of incident (point, line) pairs.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] auto count() const -> std::size_t {
+            std::size_t count = 0;
+            for (const auto word : bits_) {
+                count += static_cast<std::size_t>(std::popcount(word));
+            }
+            return count;
+        }
+
+      private:
+        std::size_t rows_;
+        std::size_t cols_;
+        std::size_t words_per_row_;
+        std::vector<std::uint64_t> bits_;
+    };
+
+    namespace detail {
+
+        /// Points per tile; each tile of rows is owned by exactly one thread.
+        inline constexpr std::size_t incidence_row_tile = 64;
+
+        /// Lines per tile (8 words); 512 lines of SoA coordinates stay resident in L1.
+        inline constexpr std::size_t incidence_col_tile = 512;
+
+        inline void incidence_tile(CoordView points, CoordView lines, IncidenceMatrix& mat,
+                                   std::size_t row_begin, std::size_t row_end) {
+            const auto ncols = lines.size();
+            const auto* lx = lines.x.data();
+            const auto* ly = lines.y.data();
+            const auto* lz = lines.z.data();
+            for (std::size_t c0 = 0; c0 < ncols; c0 += incidence_col_tile) {
+                const auto c1 = std::min(c0 + incidence_col_tile, ncols);
+                for (std::size_t r = row_begin; r < row_end; ++r) {
+                    const auto px = points.x[r];
+                    const auto py = points.y[r];
+                    const auto pz = points.z[r];
+                    auto words = mat.row(r);
+                    for (std::size_t base = c0; base < c1; base += 64) {
+                        const auto len = std::min<std::size_t>(64, c1 - base);
+                        std::uint64_t word = 0;
+                        for (std::size_t k = 0; k < len; ++k) {
+                            const auto j = base + k;
+                            const auto d = px * lx[j] + py * ly[j] + pz * lz[j];
+                            word |= std::uint64_t{d == 0} << k;
+                        }
+                        words[base / 64] = word;
+                    }
+                }
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Build the incidence matrix of points against lines.
+     *
+     * The work is split into tiles of 64 points by 512 lines; tiles of rows
+     * are handed out to worker threads, so no two threads write to the same
+     * row.
+     *
+     * @param[in] points
+     * @param[in] lines
+     * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+     * @return IncidenceMatrix rows = points, cols = lines
+     */
+    inline auto build_incidence(CoordView points, CoordView lines, std::size_t num_threads = 0)
+        -> IncidenceMatrix {
+        IncidenceMatrix mat{points.size(), lines.size()};
+        const auto nrows = points.size();
+        const auto num_tiles = (nrows + detail::incidence_row_tile - 1) / detail::incidence_row_tile;
+        detail::run_blocks(num_tiles, num_threads, [&](std::size_t tile) {
+            const auto r0 = tile * detail::incidence_row_tile;
+            const auto r1 = std::min(r0 + detail::incidence_row_tile, nrows);
+            detail::incidence_tile(points, lines, mat, r0, r1);
+        });
+        return mat;
+    }
+
+    /**
+     * @brief Build the incidence matrix from SoA containers.
+     *
+     * @param[in] points
+     * @param[in] lines
+     * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+     * @return IncidenceMatrix
+     */
+    inline auto build_incidence(const PointSoA& points, const LineSoA& lines,
+                                std::size_t num_threads = 0) -> IncidenceMatrix {
+        return build_incidence(points.view(), lines.view(), num_threads);
+    }
+
+    /**
+     * @brief Build the incidence matrix from arrays of points and lines.
+     *
+     * @param[in] points
+     * @param[in] lines
+     * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+     * @return IncidenceMatrix
+     */
+    inline auto build_incidence(std::span<const PgPoint> points, std::span<const PgLine> lines,
+                                std::size_t num_threads = 0) -> IncidenceMatrix {
+        return build_incidence(PointSoA{points}, LineSoA{lines}, num_threads);
+    }
+
+}  // namespace fun
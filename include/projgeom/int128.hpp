@@ -0,0 +1,211 @@
+/** @file int128.hpp
+ *  @brief 128-bit integer aliases and overflow-checked int64 arithmetic helpers.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SIZEOF_INT128__)
+#    define PROJGEOM_HAS_INT128 1
+#else
+#    define PROJGEOM_HAS_INT128 0
+#endif
+
+namespace fun {
+
+#if PROJGEOM_HAS_INT128
+    __extension__ typedef __int128 int128_t;
+    __extension__ typedef unsigned __int128 uint128_t;
+
+    /**
+     * @brief Does a 128-bit value fit into int64_t?
+     *
+     * @param[in] val
+     * @return bool
+     */
+    constexpr auto fits_int64(int128_t val) noexcept -> bool {
+        return val >= std::numeric_limits<std::int64_t>::min()
+               && val <= std::numeric_limits<std::int64_t>::max();
+    }
+#endif
+
+    /**
+     * @brief Multiply with overflow detection.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] res lhs * rhs (wrapped on overflow)
+     * @return true if the exact product does not fit into int64_t
+     */
+    constexpr auto mul_overflow(std::int64_t lhs, std::int64_t rhs, std::int64_t& res) noexcept
+        -> bool {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(lhs, rhs, &res);
+#else
+        constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+        constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+        res = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs)
+                                        * static_cast<std::uint64_t>(rhs));
+        if (lhs == 0 || rhs == 0) return false;
+        if (lhs > 0) {
+            return rhs > 0 ? lhs > kMax / rhs : rhs < kMin / lhs;
+        }
+        return rhs > 0 ? lhs < kMin / rhs : rhs < kMax / lhs;
+#endif
+    }
+
+    /**
+     * @brief Add with overflow detection.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] res lhs + rhs (wrapped on overflow)
+     * @return true if the exact sum does not fit into int64_t
+     */
+    constexpr auto add_overflow(std::int64_t lhs, std::int64_t rhs, std::int64_t& res) noexcept
+        -> bool {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_add_overflow(lhs, rhs, &res);
+#else
+        res = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs)
+                                        + static_cast<std::uint64_t>(rhs));
+        return (lhs >= 0) == (rhs >= 0) && (res >= 0) != (lhs >= 0);
+#endif
+    }
+
+    /**
+     * @brief Subtract with overflow detection.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] res lhs - rhs (wrapped on overflow)
+     * @return true if the exact difference does not fit into int64_t
+     */
+    constexpr auto sub_overflow(std::int64_t lhs, std::int64_t rhs, std::int64_t& res) noexcept
+        -> bool {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_sub_overflow(lhs, rhs, &res);
+#else
+        res = static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs)
+                                        - static_cast<std::uint64_t>(rhs));
+        return (lhs >= 0) != (rhs >= 0) && (res >= 0) != (lhs >= 0);
+#endif
+    }
+
+    /**
+     * @brief Full 64 x 64 -> 128 bit unsigned product.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] hi upper 64 bits
+     * @return std::uint64_t lower 64 bits
+     */
+    constexpr auto mul_wide(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t& hi) noexcept
+        -> std::uint64_t {
+#if PROJGEOM_HAS_INT128
+        const auto prod = uint128_t(lhs) * rhs;
+        hi = static_cast<std::uint64_t>(prod >> 64);
+        return static_cast<std::uint64_t>(prod);
+#else
+        const std::uint64_t lhs_lo = lhs & 0xffffffffU, lhs_hi = lhs >> 32;
+        const std::uint64_t rhs_lo = rhs & 0xffffffffU, rhs_hi = rhs >> 32;
+        const std::uint64_t p00 = lhs_lo * rhs_lo, p01 = lhs_lo * rhs_hi;
+        const std::uint64_t p10 = lhs_hi * rhs_lo, p11 = lhs_hi * rhs_hi;
+        const std::uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffU) + (p10 & 0xffffffffU);
+        hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+        return (mid << 32) | (p00 & 0xffffffffU);
+#endif
+    }
+
+    namespace detail {
+
+#if PROJGEOM_HAS_INT128
+        /// Accumulator of the exact int64 kernels (Transform, Conic).
+        using int_wide = int128_t;
+#else
+        using int_wide = std::int64_t;
+#endif
+
+        constexpr auto wide_mul_overflow(int_wide lhs, int_wide rhs, int_wide& res) noexcept
+            -> bool {
+#if PROJGEOM_HAS_INT128
+            return __builtin_mul_overflow(lhs, rhs, &res);
+#else
+            return mul_overflow(lhs, rhs, res);
+#endif
+        }
+
+        constexpr auto wide_add_overflow(int_wide lhs, int_wide rhs, int_wide& res) noexcept
+            -> bool {
+#if PROJGEOM_HAS_INT128
+            return __builtin_add_overflow(lhs, rhs, &res);
+#else
+            return add_overflow(lhs, rhs, res);
+#endif
+        }
+
+        constexpr auto wide_sub_overflow(int_wide lhs, int_wide rhs, int_wide& res) noexcept
+            -> bool {
+#if PROJGEOM_HAS_INT128
+            return __builtin_sub_overflow(lhs, rhs, &res);
+#else
+            return sub_overflow(lhs, rhs, res);
+#endif
+        }
+
+        /// Exact product of two int64 values (checked when there is no 128-bit type).
+        constexpr auto wide_mul(std::int64_t lhs, std::int64_t rhs) -> int_wide {
+#if PROJGEOM_HAS_INT128
+            return int_wide(lhs) * rhs;
+#else
+            std::int64_t res = 0;
+            if (mul_overflow(lhs, rhs, res)) {
+                throw std::overflow_error{"intermediate does not fit into int64_t"};
+            }
+            return res;
+#endif
+        }
+
+        /// @throws std::overflow_error if the product does not fit into int_wide.
+        constexpr auto checked_mul(int_wide lhs, int_wide rhs) -> int_wide {
+            int_wide res{};
+            if (wide_mul_overflow(lhs, rhs, res)) {
+                throw std::overflow_error{"intermediate does not fit"};
+            }
+            return res;
+        }
+
+        /// @throws std::overflow_error if the sum does not fit into int_wide.
+        constexpr auto checked_add(int_wide lhs, int_wide rhs) -> int_wide {
+            int_wide res{};
+            if (wide_add_overflow(lhs, rhs, res)) {
+                throw std::overflow_error{"intermediate does not fit"};
+            }
+            return res;
+        }
+
+        /// @throws std::overflow_error if the difference does not fit into int_wide.
+        constexpr auto checked_sub(int_wide lhs, int_wide rhs) -> int_wide {
+            int_wide res{};
+            if (wide_sub_overflow(lhs, rhs, res)) {
+                throw std::overflow_error{"intermediate does not fit"};
+            }
+            return res;
+        }
+
+        /// @throws std::overflow_error if the value does not fit into int64_t.
+        constexpr auto checked_narrow(int_wide val) -> std::int64_t {
+#if PROJGEOM_HAS_INT128
+            if (!fits_int64(val)) {
+                throw std::overflow_error{"result does not fit into int64_t"};
+            }
+#endif
+            return static_cast<std::int64_t>(val);
+        }
+
+    }  // namespace detail
+
+}  // namespace fun
@@ -0,0 +1,384 @@
+/** @file lazy_fraction.hpp
+ *  @brief Rational numbers whose reduction to lowest terms is deferred.
+ *
+ *  Fraction<Z> divides out the gcd after every operation. In chains such as
+ *  quadrance/spread sums most of those gcds are wasted: the result is only
+ *  inspected at the end. LazyFraction<Z> keeps the numerator and denominator
+ *  unreduced and only reduces when one of them exceeds a magnitude limit,
+ *  or on request (reduce(), reduced(), output).
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "binary_gcd.hpp"
+#include "common_concepts.h"
+#include "fractions.hpp"
+#include "int128.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Magnitude above which LazyFraction<Z> reduces to lowest terms.
+     *
+     * For builtin integers the limit is 2^(digits/2), so the cross products
+     * of two operands strictly below the limit, and their sum, still fit
+     * into Z. Operands at or above the limit are multiplied in a wider type
+     * (see detail::lazy_wide) and reduced before narrowing back.
+     * Other types reduce eagerly (limit 0) unless this trait is specialized.
+     *
+     * @tparam Z
+     */
+    template <typename Z> struct lazy_reduce_limit {
+        static constexpr auto value() -> Z {
+            if constexpr (std::is_integral_v<Z>) {
+                return Z(Z(1) << (std::numeric_limits<Z>::digits / 2));
+            } else {
+                return Z(0);
+            }
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Integer type that holds the cross products of two Z values, or void.
+         *
+         * @tparam Z
+         */
+        template <typename Z> struct lazy_wide {
+            using type = void;
+        };
+
+        template <typename Z>
+            requires(std::is_integral_v<Z> && std::is_signed_v<Z> && sizeof(Z) <= 4)
+        struct lazy_wide<Z> {
+            using type = std::int64_t;
+        };
+
+#if PROJGEOM_HAS_INT128
+        template <typename Z>
+            requires(std::is_integral_v<Z> && std::is_signed_v<Z> && sizeof(Z) == 8)
+        struct lazy_wide<Z> {
+            using type = int128_t;
+        };
+#endif
+
+        template <typename Z> using lazy_wide_t = typename lazy_wide<Z>::type;
+
+        /// gcd of two wide intermediates (non-negative).
+        template <typename W> constexpr auto lazy_gcd(W lhs, W rhs) -> W {
+#if PROJGEOM_HAS_INT128
+            if constexpr (std::is_same_v<W, int128_t>) {
+                auto mag = [](int128_t val) {
+                    return val < 0 ? uint128_t(0) - uint128_t(val) : uint128_t(val);
+                };
+                return static_cast<int128_t>(binary_gcd_u128(mag(lhs), mag(rhs)));
+            } else
+#endif
+            {
+                return gcd(lhs, rhs);
+            }
+        }
+
+        /**
+         * @brief Sign of a d - b c, widened to 128 bits for 64-bit operands.
+         *
+         * @return -1, 0 or 1
+         */
+        template <typename Z>
+        constexpr auto cross_sign(const Z& a_num, const Z& b_den, const Z& c_num,
+                                  const Z& d_den) -> int {
+#if PROJGEOM_HAS_INT128
+            if constexpr (std::is_integral_v<Z> && sizeof(Z) <= sizeof(std::int64_t)) {
+                const auto lhs = int128_t(a_num) * d_den;
+                const auto rhs = int128_t(b_den) * c_num;
+                return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+            } else
+#endif
+            {
+                const Z lhs = a_num * d_den;
+                const Z rhs = b_den * c_num;
+                return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Fraction with deferred normalization.
+     *
+     * Invariant: the denominator is non-negative. The numerator and
+     * denominator need not be co-prime; two LazyFractions compare equal when
+     * they denote the same rational number.
+     *
+     * @tparam Z
+     */
+    template <Integral Z> class LazyFraction {
+        Z _num;
+        Z _den;
+
+        constexpr void normalize_sign() {
+            if (this->_den < Z(0)) {
+                this->_num = -this->_num;
+                this->_den = -this->_den;
+            }
+        }
+
+        constexpr void maybe_reduce() {
+            const Z limit = lazy_reduce_limit<Z>::value();
+            if (this->_den > limit || this->_num > limit || this->_num < -limit) {
+                this->reduce();
+            }
+        }
+
+        /// Are both operands strictly below the limit, so the plain Z formulas are exact?
+        constexpr auto small_with(const LazyFraction& rhs) const -> bool {
+            const Z limit = lazy_reduce_limit<Z>::value();
+            auto below = [&limit](const Z& val) { return val < limit && val > -limit; };
+            return below(this->_num) && below(this->_den) && below(rhs._num) && below(rhs._den);
+        }
+
+        /**
+         * @brief Narrow a wide intermediate ratio back to Z, reducing it first if needed.
+         *
+         * @throws std::overflow_error if the reduced ratio does not fit into Z
+         */
+        template <typename W> static constexpr auto from_wide(W num, W den) -> LazyFraction {
+            if (den < 0) {
+                num = -num;
+                den = -den;
+            }
+            constexpr W kMax = W(std::numeric_limits<Z>::max());
+            if (num > kMax || num < -kMax || den > kMax) {
+                const W common = detail::lazy_gcd(num, den);
+                if (common > 1) {
+                    num /= common;
+                    den /= common;
+                }
+                if (num > kMax || num < -kMax || den > kMax) {
+                    throw std::overflow_error{"LazyFraction: result does not fit into Z"};
+                }
+            }
+            LazyFraction res;
+            res._num = static_cast<Z>(num);
+            res._den = static_cast<Z>(den);
+            res.maybe_reduce();
+            return res;
+        }
+
+      public:
+        /**
+         * @brief Default construct a new LazyFraction object (0/1).
+         */
+        constexpr LazyFraction() : _num(0), _den(1) {}
+
+        /**
+         * @brief Construct a new LazyFraction object from a single value.
+         *
+         * @param[in] num
+         */
+        constexpr explicit LazyFraction(Z num) : _num{std::move(num)}, _den(1) {}
+
+        /**
+         * @brief Construct a new LazyFraction object from two values (not reduced).
+         *
+         * @param[in] num numerator
+         * @param[in] den denominator
+         */
+        constexpr LazyFraction(Z num, Z den) : _num{std::move(num)}, _den{std::move(den)} {
+            this->normalize_sign();
+            this->maybe_reduce();
+        }
+
+        /**
+         * @brief Construct a new LazyFraction object from a reduced Fraction.
+         *
+         * @param[in] frac
+         */
+        constexpr explicit LazyFraction(const Fraction<Z>& frac)
+            : _num{frac.num()}, _den{frac.den()} {}
+
+        /**
+         * @brief Numerator (not necessarily in lowest terms)
+         *
+         * @return const Z&
+         */
+        [[nodiscard]] constexpr auto num() const noexcept -> const Z& { return _num; }
+
+        /**
+         * @brief Denominator (non-negative, not necessarily in lowest terms)
+         *
+         * @return const Z&
+         */
+        [[nodiscard]] constexpr auto den() const noexcept -> const Z& { return _den; }
+
+        /**
+         * @brief Reduce to lowest terms in place.
+         *
+         * @return LazyFraction&
+         */
+        constexpr auto reduce() -> LazyFraction& {
+            const Z common = gcd(this->_num, this->_den);
+            if (common != Z(0) && common != Z(1)) {
+                this->_num /= common;
+                this->_den /= common;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief The value as a canonical Fraction.
+         *
+         * @return Fraction<Z>
+         */
+        [[nodiscard]] constexpr auto reduced() const -> Fraction<Z> {
+            return Fraction<Z>(this->_num, this->_den);
+        }
+
+        /** @name Comparison operators
+         *  by cross-multiplication; no gcd is needed
+         */
+        ///@{
+
+        friend constexpr auto operator==(const LazyFraction& lhs, const LazyFraction& rhs)
+            -> bool {
+            return detail::cross_sign(lhs._num, lhs._den, rhs._num, rhs._den) == 0;
+        }
+
+        friend constexpr auto operator<=>(const LazyFraction& lhs, const LazyFraction& rhs)
+            -> std::strong_ordering {
+            return detail::cross_sign(lhs._num, lhs._den, rhs._num, rhs._den) <=> 0;
+        }
+
+        friend constexpr auto operator==(const LazyFraction& lhs, const Z& rhs) -> bool {
+            return detail::cross_sign(lhs._num, lhs._den, rhs, Z(1)) == 0;
+        }
+
+        friend constexpr auto operator<=>(const LazyFraction& lhs, const Z& rhs)
+            -> std::strong_ordering {
+            return detail::cross_sign(lhs._num, lhs._den, rhs, Z(1)) <=> 0;
+        }
+
+        ///@}
+
+        /** @name Arithmetic operators
+         *  schoolbook formulas; reduction only past lazy_reduce_limit.
+         *  For builtin integers, operands at or above the limit are combined in
+         *  a wider type; @throws std::overflow_error if the reduced result does
+         *  not fit into Z.
+         */
+        ///@{
+
+        constexpr auto operator-() const -> LazyFraction {
+            auto res = *this;
+            res._num = -res._num;
+            return res;
+        }
+
+        constexpr auto operator+=(const LazyFraction& rhs) -> LazyFraction& {
+            if constexpr (!std::is_void_v<detail::lazy_wide_t<Z>>) {
+                using W = detail::lazy_wide_t<Z>;
+                if (!this->small_with(rhs)) {
+                    return *this = from_wide(W(this->_num) * rhs._den + W(this->_den) * rhs._num,
+                                             W(this->_den) * rhs._den);
+                }
+            }
+            if (this->_den == rhs._den) {
+                this->_num += rhs._num;
+            } else {
+                this->_num = this->_num * rhs._den + this->_den * rhs._num;
+                this->_den *= rhs._den;
+            }
+            this->maybe_reduce();
+            return *this;
+        }
+
+        constexpr auto operator-=(const LazyFraction& rhs) -> LazyFraction& {
+            if constexpr (!std::is_void_v<detail::lazy_wide_t<Z>>) {
+                using W = detail::lazy_wide_t<Z>;
+                if (!this->small_with(rhs)) {
+                    return *this = from_wide(W(this->_num) * rhs._den - W(this->_den) * rhs._num,
+                                             W(this->_den) * rhs._den);
+                }
+            }
+            if (this->_den == rhs._den) {
+                this->_num -= rhs._num;
+            } else {
+                this->_num = this->_num * rhs._den - this->_den * rhs._num;
+                this->_den *= rhs._den;
+            }
+            this->maybe_reduce();
+            return *this;
+        }
+
+        constexpr auto operator*=(const LazyFraction& rhs) -> LazyFraction& {
+            if constexpr (!std::is_void_v<detail::lazy_wide_t<Z>>) {
+                using W = detail::lazy_wide_t<Z>;
+                if (!this->small_with(rhs)) {
+                    return *this = from_wide(W(this->_num) * rhs._num, W(this->_den) * rhs._den);
+                }
+            }
+            this->_num *= rhs._num;
+            this->_den *= rhs._den;
+            this->maybe_reduce();
+            return *this;
+        }
+
+        constexpr auto operator/=(const LazyFraction& rhs) -> LazyFraction& {
+            if constexpr (!std::is_void_v<detail::lazy_wide_t<Z>>) {
+                using W = detail::lazy_wide_t<Z>;
+                if (!this->small_with(rhs)) {
+                    return *this = from_wide(W(this->_num) * rhs._den, W(this->_den) * rhs._num);
+                }
+            }
+            this->_num *= rhs._den;
+            this->_den *= rhs._num;
+            this->normalize_sign();
+            this->maybe_reduce();
+            return *this;
+        }
+
+        friend constexpr auto operator+(LazyFraction lhs, const LazyFraction& rhs)
+            -> LazyFraction {
+            return lhs += rhs;
+        }
+
+        friend constexpr auto operator-(LazyFraction lhs, const LazyFraction& rhs)
+            -> LazyFraction {
+            return lhs -= rhs;
+        }
+
+        friend constexpr auto operator*(LazyFraction lhs, const LazyFraction& rhs)
+            -> LazyFraction {
+            return lhs *= rhs;
+        }
+
+        friend constexpr auto operator/(LazyFraction lhs, const LazyFraction& rhs)
+            -> LazyFraction {
+            return lhs /= rhs;
+        }
+
+        ///@}
+
+        /**
+         * @brief Output in lowest terms, in the same format as Fraction.
+         *
+         * @tparam Stream
+         * @param[in] os
+         * @param[in] frac
+         * @return Stream&
+         */
+        template <typename Stream> friend auto operator<<(Stream& os, const LazyFraction& frac)
+            -> Stream& {
+            return os << frac.reduced();
+        }
+    };
+
+}  // namespace fun
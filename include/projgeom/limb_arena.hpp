@@ -0,0 +1,163 @@
+/** @file limb_arena.hpp
+ *  @brief Per-thread recycling arena for the limb buffers of BigInt.
+ *
+ *  Exact constructions allocate and free many short-lived big-integer
+ *  temporaries of similar sizes. The arena keeps freed buffers in per-thread
+ *  free lists bucketed by power-of-two size, so the steady state of such a
+ *  loop performs no calls into the global allocator and takes no locks.
+ *
+ *  Buffers are ordinary ::operator new blocks. A buffer may therefore be
+ *  freed on a different thread than the one that allocated it, and cached
+ *  buffers are released when their thread exits.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace fun {
+
+    namespace detail {
+
+        /// Smallest bucket: 16 bytes (two limbs); bucket k holds 16 << k bytes.
+        constexpr std::size_t arena_min_bytes = 16;
+        constexpr std::size_t arena_buckets = 16;
+        /// Cached buffers per bucket and thread; further frees go to ::operator delete.
+        constexpr std::size_t arena_max_cached = 256;
+
+        struct ArenaBlock {
+            ArenaBlock* next;
+        };
+
+        /// Trivially destructible, so it stays usable while other thread_locals are destroyed.
+        struct ArenaState {
+            std::array<ArenaBlock*, arena_buckets> heads;
+            std::array<std::size_t, arena_buckets> counts;
+            bool registered;
+            bool shut_down;
+        };
+
+        inline auto arena_state() noexcept -> ArenaState& {
+            thread_local ArenaState state{};
+            return state;
+        }
+
+        inline void arena_release(ArenaState& state) noexcept {
+            for (std::size_t k = 0; k < arena_buckets; ++k) {
+                while (state.heads[k] != nullptr) {
+                    auto* block = state.heads[k];
+                    state.heads[k] = block->next;
+                    ::operator delete(block);
+                }
+                state.counts[k] = 0;
+            }
+        }
+
+        /// Releases the cached buffers at thread exit.
+        struct ArenaFlusher {
+            ArenaFlusher() = default;
+            ArenaFlusher(const ArenaFlusher&) = delete;
+            auto operator=(const ArenaFlusher&) -> ArenaFlusher& = delete;
+            ~ArenaFlusher() {
+                auto& state = arena_state();
+                arena_release(state);
+                state.shut_down = true;
+            }
+        };
+
+        /// Register the thread-exit flusher before the first buffer is cached or allocated.
+        inline void arena_register(ArenaState& state) noexcept {
+            if (!state.registered && !state.shut_down) {
+                state.registered = true;
+                thread_local ArenaFlusher flusher;
+            }
+        }
+
+        /**
+         * @brief Bucket index of a request, or arena_buckets if it is too large to cache.
+         */
+        constexpr auto arena_bucket(std::size_t bytes) noexcept -> std::size_t {
+            if (bytes <= arena_min_bytes) return 0;
+            return static_cast<std::size_t>(std::bit_width((bytes - 1) / arena_min_bytes));
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Allocate a buffer of at least the given size from the calling thread's arena.
+     *
+     * @param[in] bytes
+     * @return void* suitably aligned for any fundamental type
+     */
+    inline auto arena_allocate(std::size_t bytes) -> void* {
+        const auto bucket = detail::arena_bucket(bytes);
+        if (bucket >= detail::arena_buckets) {
+            return ::operator new(bytes);
+        }
+        auto& state = detail::arena_state();
+        if (auto* block = state.heads[bucket]; block != nullptr) {
+            state.heads[bucket] = block->next;
+            --state.counts[bucket];
+            return block;
+        }
+        detail::arena_register(state);
+        return ::operator new(detail::arena_min_bytes << bucket);
+    }
+
+    /**
+     * @brief Return a buffer obtained from arena_allocate (on any thread).
+     *
+     * @param[in] ptr
+     * @param[in] bytes the size passed to arena_allocate
+     */
+    inline void arena_deallocate(void* ptr, std::size_t bytes) noexcept {
+        if (ptr == nullptr) return;
+        const auto bucket = detail::arena_bucket(bytes);
+        auto& state = detail::arena_state();
+        if (bucket >= detail::arena_buckets || state.shut_down
+            || state.counts[bucket] >= detail::arena_max_cached) {
+            ::operator delete(ptr);
+            return;
+        }
+        // a consumer thread may only ever free buffers allocated elsewhere
+        detail::arena_register(state);
+        auto* block = static_cast<detail::ArenaBlock*>(ptr);
+        block->next = state.heads[bucket];
+        state.heads[bucket] = block;
+        ++state.counts[bucket];
+    }
+
+    /**
+     * @brief Standard allocator backed by the per-thread arena.
+     *
+     * Stateless: all instances compare equal, so containers using it can
+     * swap and move buffers freely.
+     *
+     * @tparam T
+     */
+    template <typename T> struct ArenaAllocator {
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+
+        template <typename U>
+        constexpr ArenaAllocator(const ArenaAllocator<U>& /*unused*/) noexcept {}
+
+        [[nodiscard]] auto allocate(std::size_t n) -> T* {
+            return static_cast<T*>(arena_allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept { arena_deallocate(ptr, n * sizeof(T)); }
+
+        template <typename U> friend constexpr auto operator==(const ArenaAllocator& /*lhs*/,
+                                                               const ArenaAllocator<U>& /*rhs*/)
+            -> bool {
+            return true;
+        }
+    };
+
+}  // namespace fun
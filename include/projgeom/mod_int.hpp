@@ -0,0 +1,304 @@
+/** @file mod_int.hpp
+ *  @brief Prime-field GF(p) coordinate type with Montgomery multiplication.
+ *
+ *  For incidence-only questions (collinearity, concurrency, Desargues) an
+ *  exact answer modulo a large prime is enough: a nonzero integer polynomial
+ *  value vanishes mod p only if p divides it. Residues never grow, so every
+ *  operation takes constant time regardless of the construction depth.
+ */
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "int128.hpp"
+
+namespace fun {
+
+    namespace detail {
+
+        constexpr auto mulmod_u64(std::uint64_t lhs, std::uint64_t rhs, std::uint64_t mod)
+            -> std::uint64_t {
+#if PROJGEOM_HAS_INT128
+            return static_cast<std::uint64_t>(uint128_t(lhs) * rhs % mod);
+#else
+            std::uint64_t res = 0;
+            lhs %= mod;
+            for (; rhs != 0; rhs >>= 1) {
+                if ((rhs & 1U) != 0) res = res >= mod - lhs ? res - (mod - lhs) : res + lhs;
+                lhs = lhs >= mod - lhs ? lhs - (mod - lhs) : lhs + lhs;
+            }
+            return res;
+#endif
+        }
+
+        constexpr auto powmod_u64(std::uint64_t base, std::uint64_t exp, std::uint64_t mod)
+            -> std::uint64_t {
+            std::uint64_t res = 1 % mod;
+            for (base %= mod; exp != 0; exp >>= 1) {
+                if ((exp & 1U) != 0) res = mulmod_u64(res, base, mod);
+                base = mulmod_u64(base, base, mod);
+            }
+            return res;
+        }
+
+        /**
+         * @brief Deterministic Miller-Rabin primality test for 64-bit integers.
+         *
+         * @param[in] num
+         * @return bool
+         */
+        constexpr auto is_prime_u64(std::uint64_t num) -> bool {
+            // these bases are a deterministic witness set for all n < 2^64
+            constexpr std::array<std::uint64_t, 12> kBases{2,  3,  5,  7,  11, 13,
+                                                           17, 19, 23, 29, 31, 37};
+            if (num < 2) return false;
+            for (const auto small : kBases) {
+                if (num % small == 0) return num == small;
+            }
+            auto odd = num - 1;
+            unsigned twos = 0;
+            for (; (odd & 1U) == 0; odd >>= 1) ++twos;
+            for (const auto base : kBases) {
+                auto val = powmod_u64(base, odd, num);
+                if (val == 1 || val == num - 1) continue;
+                bool composite = true;
+                for (unsigned i = 1; i < twos && composite; ++i) {
+                    val = mulmod_u64(val, val, num);
+                    composite = val != num - 1;
+                }
+                if (composite) return false;
+            }
+            return true;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Element of the prime field GF(P) in Montgomery form.
+     *
+     * Residues are stored as a R mod P with R = 2^64, so a product needs one
+     * 64 x 64 -> 128 bit multiply and one Montgomery reduction (REDC) instead
+     * of a division.
+     *
+     * To satisfy the Integral concept:
+     * - a / b multiplies by the inverse of b (exact division in a field),
+     * - a % b is 0 (every nonzero element divides every element),
+     * - the ordering compares the canonical residues in [0, P). It is a total
+     *   order for use in containers and gcd loops, not a field ordering.
+     *
+     * @tparam P odd prime below 2^63
+     */
+    template <std::uint64_t P> class ModInt {
+        static_assert(P > 2 && P < (std::uint64_t{1} << 63), "P must be an odd prime below 2^63");
+        static_assert(detail::is_prime_u64(P), "P must be prime");
+
+      public:
+        static constexpr std::uint64_t modulus = P;
+
+        /**
+         * @brief Zero.
+         */
+        constexpr ModInt() noexcept = default;
+
+        /**
+         * @brief Residue of a builtin integer (negative values wrap).
+         *
+         * @param[in] val
+         */
+        template <std::integral T> constexpr ModInt(T val) noexcept {  // NOLINT
+            std::uint64_t res = 0;
+            if constexpr (std::is_signed_v<T>) {
+                const auto mag = val < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(val)
+                                         : static_cast<std::uint64_t>(val);
+                res = mag % P;
+                if (val < 0 && res != 0) res = P - res;
+            } else {
+                res = static_cast<std::uint64_t>(val) % P;
+            }
+            mont_ = to_mont(res);
+        }
+
+        /**
+         * @brief Canonical residue in [0, P).
+         *
+         * @return std::uint64_t
+         */
+        [[nodiscard]] constexpr auto value() const noexcept -> std::uint64_t {
+            return redc(0, mont_);
+        }
+
+        /**
+         * @brief Symmetric residue in (-P/2, P/2].
+         *
+         * @return std::int64_t
+         */
+        [[nodiscard]] constexpr auto signed_value() const noexcept -> std::int64_t {
+            const auto val = this->value();
+            return val > P / 2 ? -static_cast<std::int64_t>(P - val)
+                               : static_cast<std::int64_t>(val);
+        }
+
+        friend constexpr auto operator==(const ModInt& lhs, const ModInt& rhs) noexcept -> bool
+            = default;
+
+        friend constexpr auto operator<=>(const ModInt& lhs, const ModInt& rhs) noexcept
+            -> std::strong_ordering {
+            return lhs.value() <=> rhs.value();
+        }
+
+        constexpr auto operator+=(const ModInt& rhs) noexcept -> ModInt& {
+            mont_ += rhs.mont_;
+            if (mont_ >= P) mont_ -= P;
+            return *this;
+        }
+
+        constexpr auto operator-=(const ModInt& rhs) noexcept -> ModInt& {
+            mont_ = mont_ >= rhs.mont_ ? mont_ - rhs.mont_ : mont_ + (P - rhs.mont_);
+            return *this;
+        }
+
+        constexpr auto operator*=(const ModInt& rhs) noexcept -> ModInt& {
+            std::uint64_t hi = 0;
+            const auto lo = mul_wide(mont_, rhs.mont_, hi);
+            mont_ = redc(hi, lo);
+            return *this;
+        }
+
+        /**
+         * @brief Multiply by the inverse.
+         *
+         * @throws std::domain_error if rhs is zero
+         */
+        constexpr auto operator/=(const ModInt& rhs) -> ModInt& {
+            return *this *= rhs.inverse();
+        }
+
+        /**
+         * @brief Remainder of exact field division (zero).
+         *
+         * @throws std::domain_error if rhs is zero
+         */
+        constexpr auto operator%=(const ModInt& rhs) -> ModInt& {
+            if (rhs.mont_ == 0) throw std::domain_error{"ModInt: division by zero"};
+            mont_ = 0;
+            return *this;
+        }
+
+        constexpr auto operator-() const noexcept -> ModInt {
+            ModInt res;
+            res.mont_ = mont_ == 0 ? 0 : P - mont_;
+            return res;
+        }
+
+        constexpr auto operator+() const noexcept -> ModInt { return *this; }
+
+        friend constexpr auto operator+(ModInt lhs, const ModInt& rhs) noexcept -> ModInt {
+            return lhs += rhs;
+        }
+
+        friend constexpr auto operator-(ModInt lhs, const ModInt& rhs) noexcept -> ModInt {
+            return lhs -= rhs;
+        }
+
+        friend constexpr auto operator*(ModInt lhs, const ModInt& rhs) noexcept -> ModInt {
+            return lhs *= rhs;
+        }
+
+        friend constexpr auto operator/(ModInt lhs, const ModInt& rhs) -> ModInt {
+            return lhs /= rhs;
+        }
+
+        friend constexpr auto operator%(ModInt lhs, const ModInt& rhs) -> ModInt {
+            return lhs %= rhs;
+        }
+
+        /**
+         * @brief Power by square-and-multiply.
+         *
+         * @param[in] exp
+         * @return ModInt
+         */
+        [[nodiscard]] constexpr auto pow(std::uint64_t exp) const noexcept -> ModInt {
+            ModInt res(1);
+            for (ModInt base = *this; exp != 0; exp >>= 1) {
+                if ((exp & 1U) != 0) res *= base;
+                base *= base;
+            }
+            return res;
+        }
+
+        /**
+         * @brief Multiplicative inverse (Fermat: a^(P-2)).
+         *
+         * @return ModInt
+         * @throws std::domain_error if *this is zero
+         */
+        [[nodiscard]] constexpr auto inverse() const -> ModInt {
+            if (mont_ == 0) throw std::domain_error{"ModInt: zero has no inverse"};
+            return this->pow(P - 2);
+        }
+
+        friend auto operator<<(std::ostream& os, const ModInt& val) -> std::ostream& {
+            return os << val.value();
+        }
+
+      private:
+        /// -P^{-1} mod 2^64 by Newton iteration (each step doubles the correct bits).
+        static constexpr auto neg_inv() noexcept -> std::uint64_t {
+            std::uint64_t inv = P;  // correct to 3 bits for odd P
+            for (int i = 0; i < 5; ++i) inv *= 2 - P * inv;
+            return std::uint64_t{0} - inv;
+        }
+
+        /// R^2 mod P with R = 2^64.
+        static constexpr auto r_squared() noexcept -> std::uint64_t {
+            const auto r_mod = (std::uint64_t{0} - P) % P;  // 2^64 mod P
+            return detail::mulmod_u64(r_mod, r_mod, P);
+        }
+
+        static constexpr std::uint64_t kNegInv = neg_inv();
+        static constexpr std::uint64_t kR2 = r_squared();
+
+        /// Montgomery reduction of T = hi 2^64 + lo < P 2^64: returns T R^{-1} mod P.
+        static constexpr auto redc(std::uint64_t hi, std::uint64_t lo) noexcept -> std::uint64_t {
+            const std::uint64_t quot = lo * kNegInv;
+            std::uint64_t prod_hi = 0;
+            mul_wide(quot, P, prod_hi);
+            // lo + low(quot * P) == 0 mod 2^64, with a carry iff lo != 0
+            auto res = hi + prod_hi + static_cast<std::uint64_t>(lo != 0);
+            return res >= P ? res - P : res;
+        }
+
+        static constexpr auto to_mont(std::uint64_t val) noexcept -> std::uint64_t {
+            std::uint64_t hi = 0;
+            const auto lo = mul_wide(val, kR2, hi);
+            return redc(hi, lo);
+        }
+
+        std::uint64_t mont_{0};
+    };
+
+    /// GF(2^61 - 1), the largest Mersenne prime field below 2^63.
+    using ModInt61 = ModInt<(std::uint64_t{1} << 61) - 1>;
+
+}  // namespace fun
+
+/**
+ * @brief Hash of fun::ModInt (by canonical residue).
+ *
+ * @tparam P
+ */
+template <std::uint64_t P> struct std::hash<fun::ModInt<P>> {
+    auto operator()(const fun::ModInt<P>& val) const noexcept -> std::size_t {
+        return std::hash<std::uint64_t>{}(val.value());
+    }
+};
@@ -0,0 +1,319 @@
+/** @file modular_check.hpp
+ *  @brief Multi-modular randomized identity testing for theorem checks.
+ *
+ *  A predicate such as check_pappus or check_desargue is a polynomial
+ *  identity in the input coordinates. Instead of evaluating it in one exact
+ *  integer ring (which overflows), it is evaluated over GF(p) for several
+ *  primes p drawn at random from a compile-time pool of 62-bit primes:
+ *
+ *  - modular_check: fixed integer inputs whose polynomial value is bounded by
+ *    2^value_bits. A nonzero residue is a certain counterexample; if the
+ *    value is nonzero, at most (value_bits - 1) / 61 pool primes divide it,
+ *    which bounds the probability that all drawn primes miss it.
+ *  - identity_test: Schwartz-Zippel. The predicate samples its own inputs
+ *    uniformly from GF(p); a nonzero failure polynomial of degree d vanishes
+ *    at a random point with probability at most d / p.
+ *  - crt_value: the exact polynomial value, reconstructed from its residues
+ *    by the Chinese remainder theorem (Garner's algorithm) into an Int256.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "mod_int.hpp"
+#include "run_blocks.hpp"
+#include "wide_int.hpp"
+
+namespace fun {
+
+    /// Pool of the 16 largest primes below 2^62 (each exceeds 2^61.99).
+    inline constexpr std::array<std::uint64_t, 16> modular_primes{
+        0x3fffffffffffffc7ULL, 0x3fffffffffffffa9ULL, 0x3fffffffffffff8bULL, 0x3fffffffffffff71ULL,
+        0x3fffffffffffff67ULL, 0x3fffffffffffff59ULL, 0x3fffffffffffff55ULL, 0x3fffffffffffff3dULL,
+        0x3fffffffffffff35ULL, 0x3ffffffffffffeefULL, 0x3ffffffffffffee1ULL, 0x3ffffffffffffec3ULL,
+        0x3ffffffffffffe45ULL, 0x3ffffffffffffe1dULL, 0x3ffffffffffffe11ULL, 0x3ffffffffffffdc1ULL,
+    };
+
+    /// Every pool prime is at least 2^61.
+    inline constexpr unsigned modular_prime_bits = 61;
+
+    /**
+     * @brief Outcome of a modular identity check.
+     *
+     * A false verdict is always certain (a witness was found). A true
+     * verdict is wrong with probability at most error_bound.
+     */
+    struct Verdict {
+        bool holds{true};
+        double error_bound{0.0};
+        std::size_t primes_used{0};
+
+        [[nodiscard]] auto certain() const noexcept -> bool { return !holds || error_bound == 0.0; }
+
+        explicit operator bool() const noexcept { return holds; }
+    };
+
+    /**
+     * @brief Options of the modular checks.
+     */
+    struct ModularOptions {
+        /// Stop as soon as the error bound of a true verdict drops to this value.
+        double max_error{1e-30};
+        /// Seed of the prime selection and of the Schwartz-Zippel samples.
+        std::uint64_t seed{0x9e3779b97f4a7c15ULL};
+        /// Upper limit on the number of primes (rounds) used.
+        std::size_t max_primes{modular_primes.size()};
+    };
+
+    namespace detail {
+
+        /// Small, fast UniformRandomBitGenerator (splitmix64).
+        class SplitMix64 {
+          public:
+            using result_type = std::uint64_t;
+
+            explicit SplitMix64(std::uint64_t seed) noexcept : state_{seed} {}
+
+            static constexpr auto min() noexcept -> result_type { return 0; }
+            static constexpr auto max() noexcept -> result_type {
+                return std::numeric_limits<result_type>::max();
+            }
+
+            auto operator()() noexcept -> result_type {
+                auto val = (state_ += 0x9e3779b97f4a7c15ULL);
+                val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                val = (val ^ (val >> 27)) * 0x94d049bb133111ebULL;
+                return val ^ (val >> 31);
+            }
+
+          private:
+            std::uint64_t state_;
+        };
+
+        /// Call fn(ModInt<modular_primes[idx]>{}) for a runtime index.
+        template <typename Fn, std::size_t... Is>
+        auto dispatch_prime(std::size_t idx, Fn& fn, std::index_sequence<Is...> /*unused*/) {
+            using Result = decltype(fn(ModInt<modular_primes[0]>{}));
+            Result res{};
+            ((idx == Is ? (void)(res = fn(ModInt<modular_primes[Is]>{})) : void()), ...);
+            return res;
+        }
+
+        template <typename Fn> auto with_prime(std::size_t idx, Fn& fn) {
+            return dispatch_prime(idx, fn, std::make_index_sequence<modular_primes.size()>{});
+        }
+
+        /// Random permutation prefix of the pool indices.
+        inline auto draw_primes(SplitMix64& gen, std::size_t count)
+            -> std::array<std::size_t, modular_primes.size()> {
+            std::array<std::size_t, modular_primes.size()> idx{};
+            std::iota(idx.begin(), idx.end(), std::size_t{0});
+            for (std::size_t i = 0; i < count && i + 1 < idx.size(); ++i) {
+                const auto j = i + static_cast<std::size_t>(gen() % (idx.size() - i));
+                std::swap(idx[i], idx[j]);
+            }
+            return idx;
+        }
+
+        template <typename Fn>
+        auto modular_check_seeded(Fn& pred, unsigned value_bits, const ModularOptions& opts,
+                                  std::uint64_t seed) -> Verdict {
+            constexpr auto kPool = modular_primes.size();
+            const auto rounds = std::min(opts.max_primes, kPool);
+            // number of pool primes that can divide a nonzero value below 2^value_bits
+            const std::size_t divisors
+                = value_bits == 0 ? 0 : (value_bits - 1) / modular_prime_bits;
+            SplitMix64 gen(seed);
+            const auto order = draw_primes(gen, rounds);
+            Verdict res;
+            res.error_bound = 1.0;
+            for (std::size_t k = 0; k < rounds; ++k) {
+                ++res.primes_used;
+                if (!with_prime(order[k], pred)) {
+                    res.holds = false;
+                    res.error_bound = 0.0;
+                    return res;
+                }
+                // Pr[all drawn primes divide v] <= C(divisors, k+1) / C(pool, k+1)
+                res.error_bound = k < divisors ? res.error_bound
+                                                     * static_cast<double>(divisors - k)
+                                                     / static_cast<double>(kPool - k)
+                                               : 0.0;
+                if (res.error_bound <= opts.max_error) break;
+            }
+            return res;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Uniform sampler of GF(p) elements for identity_test.
+     *
+     * @tparam K ModInt type
+     */
+    template <typename K> class FieldSampler {
+      public:
+        using value_type = K;
+
+        explicit FieldSampler(detail::SplitMix64& gen) noexcept : gen_{gen} {}
+
+        /**
+         * @brief A uniformly random field element.
+         *
+         * @return K
+         */
+        auto operator()() -> K { return K(gen_() % K::modulus); }
+
+      private:
+        detail::SplitMix64& gen_;
+    };
+
+    /**
+     * @brief Check a predicate on fixed integer inputs over random primes.
+     *
+     * The predicate is called as pred(K{}) for ModInt types K and must build
+     * its inputs from integers (e.g. fun::pg_point<K>(3, -1, 2)) and return
+     * whether the identity holds. value_bits bounds the magnitude of the
+     * underlying integer polynomial value, |v| < 2^value_bits, and of any
+     * intermediate whose vanishing mod p would make the predicate trivially
+     * true (e.g. a constructed point that is the zero vector mod p).
+     *
+     * @tparam Fn generic callable (auto tag) -> bool
+     * @param[in] pred
+     * @param[in] value_bits
+     * @param[in] opts
+     * @return Verdict
+     */
+    template <typename Fn>
+    auto modular_check(Fn&& pred, unsigned value_bits, const ModularOptions& opts = {})
+        -> Verdict {
+        return detail::modular_check_seeded(pred, value_bits, opts, opts.seed);
+    }
+
+    /**
+     * @brief Schwartz-Zippel test of a polynomial identity.
+     *
+     * The predicate is called as pred(sampler) with a FieldSampler<K>; it
+     * draws its free inputs with sampler() and returns whether the identity
+     * holds there. degree bounds the total degree of the failure polynomial
+     * in the sampled variables (including degeneracies that make the
+     * predicate trivially true), so each round misses a false identity with
+     * probability at most degree / 2^61.
+     *
+     * @tparam Fn generic callable (auto& sampler) -> bool
+     * @param[in] pred
+     * @param[in] degree
+     * @param[in] opts
+     * @return Verdict
+     */
+    template <typename Fn>
+    auto identity_test(Fn&& pred, unsigned degree, const ModularOptions& opts = {}) -> Verdict {
+        const auto rounds = std::min(opts.max_primes, modular_primes.size());
+        const double miss = std::min(1.0, std::ldexp(static_cast<double>(degree),
+                                                     -static_cast<int>(modular_prime_bits)));
+        detail::SplitMix64 gen(opts.seed);
+        const auto order = detail::draw_primes(gen, rounds);
+        auto round = [&gen, &pred](auto tag) -> bool {
+            FieldSampler<decltype(tag)> sampler(gen);
+            return pred(sampler);
+        };
+        Verdict res;
+        res.error_bound = 1.0;
+        for (std::size_t k = 0; k < rounds; ++k) {
+            ++res.primes_used;
+            if (!detail::with_prime(order[k], round)) {
+                res.holds = false;
+                res.error_bound = 0.0;
+                return res;
+            }
+            res.error_bound *= miss;
+            if (res.error_bound <= opts.max_error) break;
+        }
+        return res;
+    }
+
+    /**
+     * @brief Exact value of an integer polynomial by CRT over pool primes.
+     *
+     * The callable is evaluated as poly(K{}) -> K for enough primes that their
+     * product exceeds 2^(value_bits + 1); the residues are combined with
+     * Garner's algorithm into the symmetric range.
+     *
+     * @tparam Fn generic callable (auto tag) -> decltype(tag)
+     * @param[in] poly
+     * @param[in] value_bits bound |v| < 2^value_bits
+     * @return Int256
+     * @throws std::invalid_argument if value_bits exceeds 240
+     */
+    template <typename Fn> auto crt_value(Fn&& poly, unsigned value_bits) -> Int256 {
+        if (value_bits > 240) {
+            throw std::invalid_argument{"crt_value: value_bits exceeds Int256 capacity"};
+        }
+        const std::size_t count = (value_bits + 1) / modular_prime_bits + 1;
+        auto residue = [&poly](auto tag) -> std::uint64_t { return poly(tag).value(); };
+        // Garner: v = c_0 + p_0 (c_1 + p_1 (c_2 + ...)), 0 <= c_i < p_i
+        std::array<std::uint64_t, 4> coef{};
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto p_i = modular_primes[i];
+            auto val = detail::with_prime(i, residue);
+            for (std::size_t j = 0; j < i; ++j) {
+                const auto p_j = modular_primes[j] % p_i;
+                const auto inv = detail::powmod_u64(p_j, p_i - 2, p_i);
+                val = val >= coef[j] % p_i ? val - coef[j] % p_i : val + p_i - coef[j] % p_i;
+                val = detail::mulmod_u64(val, inv, p_i);
+            }
+            coef[i] = val;
+        }
+        Int256 res(coef[count - 1]);
+        for (std::size_t i = count - 1; i-- > 0;) {
+            res = res * Int256(modular_primes[i]) + Int256(coef[i]);
+        }
+        Int256 modulus(1);
+        for (std::size_t i = 0; i < count; ++i) modulus *= Int256(modular_primes[i]);
+        return res > (modulus >> 1) ? res - modulus : res;
+    }
+
+    /**
+     * @brief modular_check over many configurations, in parallel.
+     *
+     * pred(i, K{}) checks configuration i. Each configuration draws its primes
+     * from its own seeded stream, so the verdicts do not depend on the number
+     * of threads.
+     *
+     * @tparam Fn generic callable (std::size_t, auto tag) -> bool
+     * @param[in] count number of configurations
+     * @param[in] pred
+     * @param[in] value_bits
+     * @param[in] opts
+     * @param[in] num_threads 0 = std::thread::hardware_concurrency()
+     * @return std::vector<Verdict>
+     * @throws the first exception thrown by pred, after all workers have stopped.
+     */
+    template <typename Fn>
+    auto modular_check_batch(std::size_t count, Fn&& pred, unsigned value_bits,
+                             const ModularOptions& opts = {}, std::size_t num_threads = 0)
+        -> std::vector<Verdict> {
+        std::vector<Verdict> res(count);
+        constexpr std::size_t kChunk = 256;
+        detail::run_blocks((count + kChunk - 1) / kChunk, num_threads, [&](std::size_t blk) {
+            const auto stop = std::min(count, (blk + 1) * kChunk);
+            for (std::size_t i = blk * kChunk; i < stop; ++i) {
+                auto single = [&pred, i](auto tag) -> bool { return pred(i, tag); };
+                res[i] = detail::modular_check_seeded(single, value_bits, opts,
+                                                      opts.seed + i * 0xd1b54a32d192ed03ULL);
+            }
+        });
+        return res;
+    }
+
+}  // namespace fun
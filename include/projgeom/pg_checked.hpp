@@ -0,0 +1,280 @@
+/** @file pg_checked.hpp
+ *  @brief Overflow-detecting int64 cross/dot/plckr kernels for PgObject constructions.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "int128.hpp"
+#include "pg_object.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Sticky overflow flag for the checked kernels.
+     *
+     * Once a checked kernel overflows, the flag stays raised until clear() is
+     * called, so a whole construction chain can be run on the fast int64 path
+     * and tested once at the end.
+     */
+    struct OverflowFlag {
+        bool overflow{false};
+
+        /**
+         * @brief Raise the flag if cond holds (never lowers it).
+         *
+         * @param[in] cond
+         */
+        constexpr void raise(bool cond) noexcept { overflow = overflow || cond; }
+
+        /**
+         * @brief Lower the flag.
+         */
+        constexpr void clear() noexcept { overflow = false; }
+
+        constexpr explicit operator bool() const noexcept { return overflow; }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Exact a*b - c*d, narrowed to int64 with overflow detection.
+         */
+        constexpr auto checked_diff_of_products(std::int64_t a, std::int64_t b, std::int64_t c,
+                                                std::int64_t d, OverflowFlag& flag)
+            -> std::int64_t {
+#if PROJGEOM_HAS_INT128
+            const auto res = int128_t{a} * b - int128_t{c} * d;
+            flag.raise(!fits_int64(res));
+            return static_cast<std::int64_t>(res);
+#else
+            std::int64_t ab = 0;
+            std::int64_t cd = 0;
+            std::int64_t res = 0;
+            flag.raise(mul_overflow(a, b, ab));
+            flag.raise(mul_overflow(c, d, cd));
+            flag.raise(sub_overflow(ab, cd, res));
+            return res;
+#endif
+        }
+
+        /**
+         * @brief Exact a*b + c*d, narrowed to int64 with overflow detection.
+         */
+        constexpr auto checked_sum_of_products(std::int64_t a, std::int64_t b, std::int64_t c,
+                                               std::int64_t d, OverflowFlag& flag)
+            -> std::int64_t {
+#if PROJGEOM_HAS_INT128
+            // each product fits, but two of (2^63)^2 = 2^126 overflow the sum
+            int128_t res = 0;
+            flag.raise(__builtin_add_overflow(int128_t{a} * b, int128_t{c} * d, &res));
+            flag.raise(!fits_int64(res));
+            return static_cast<std::int64_t>(res);
+#else
+            std::int64_t ab = 0;
+            std::int64_t cd = 0;
+            std::int64_t res = 0;
+            flag.raise(mul_overflow(a, b, ab));
+            flag.raise(mul_overflow(c, d, cd));
+            flag.raise(add_overflow(ab, cd, res));
+            return res;
+#endif
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Dot product with overflow detection.
+     *
+     * With __int128 the three products are exact and only their sum (for
+     * operands near INT64_MIN) or the final narrowing can overflow;
+     * otherwise every step is checked.
+     *
+     * @param[in] pt_a
+     * @param[in] pt_b
+     * @param[in,out] flag raised if the result does not fit into int64_t
+     * @return int64_t (wrapped on overflow)
+     */
+    constexpr auto checked_dot(const std::array<std::int64_t, 3>& pt_a,
+                               const std::array<std::int64_t, 3>& pt_b, OverflowFlag& flag)
+        -> std::int64_t {
+#if PROJGEOM_HAS_INT128
+        int128_t res = 0;
+        flag.raise(__builtin_add_overflow(int128_t{pt_a[0]} * pt_b[0], int128_t{pt_a[1]} * pt_b[1],
+                                          &res));
+        flag.raise(__builtin_add_overflow(res, int128_t{pt_a[2]} * pt_b[2], &res));
+        flag.raise(!fits_int64(res));
+        return static_cast<std::int64_t>(res);
+#else
+        std::int64_t zz = 0;
+        std::int64_t res = 0;
+        const auto xy = detail::checked_sum_of_products(pt_a[0], pt_b[0], pt_a[1], pt_b[1], flag);
+        flag.raise(mul_overflow(pt_a[2], pt_b[2], zz));
+        flag.raise(add_overflow(xy, zz, res));
+        return res;
+#endif
+    }
+
+    /**
+     * @brief Cross product with overflow detection.
+     *
+     * @f[
+     *     a \times b = (a_y b_z - a_z b_y,\; a_z b_x - a_x b_z,\; a_x b_y - a_y b_x)^T
+     * @f]
+     * @param[in] pt_a
+     * @param[in] pt_b
+     * @param[in,out] flag raised if any component does not fit into int64_t
+     * @return std::array<int64_t, 3> (wrapped on overflow)
+     */
+    constexpr auto checked_cross(const std::array<std::int64_t, 3>& pt_a,
+                                 const std::array<std::int64_t, 3>& pt_b, OverflowFlag& flag)
+        -> std::array<std::int64_t, 3> {
+        return {
+            detail::checked_diff_of_products(pt_a[1], pt_b[2], pt_a[2], pt_b[1], flag),
+            detail::checked_diff_of_products(pt_a[2], pt_b[0], pt_a[0], pt_b[2], flag),
+            detail::checked_diff_of_products(pt_a[0], pt_b[1], pt_a[1], pt_b[0], flag),
+        };
+    }
+
+    /**
+     * @brief Homogeneous parametrization with overflow detection.
+     *
+     * @f[
+     *     \lambda p + \mu q
+     * @f]
+     * @param[in] lambda_val
+     * @param[in] pt_p
+     * @param[in] mu_val
+     * @param[in] pt_q
+     * @param[in,out] flag raised if any component does not fit into int64_t
+     * @return std::array<int64_t, 3> (wrapped on overflow)
+     */
+    constexpr auto checked_plckr(std::int64_t lambda_val, const std::array<std::int64_t, 3>& pt_p,
+                                 std::int64_t mu_val, const std::array<std::int64_t, 3>& pt_q,
+                                 OverflowFlag& flag) -> std::array<std::int64_t, 3> {
+        return {
+            detail::checked_sum_of_products(lambda_val, pt_p[0], mu_val, pt_q[0], flag),
+            detail::checked_sum_of_products(lambda_val, pt_p[1], mu_val, pt_q[1], flag),
+            detail::checked_sum_of_products(lambda_val, pt_p[2], mu_val, pt_q[2], flag),
+        };
+    }
+
+    /**
+     * @brief Cross product, or std::nullopt if it overflows int64.
+     *
+     * @param[in] pt_a
+     * @param[in] pt_b
+     * @return std::optional<std::array<int64_t, 3>>
+     */
+    constexpr auto try_cross(const std::array<std::int64_t, 3>& pt_a,
+                             const std::array<std::int64_t, 3>& pt_b)
+        -> std::optional<std::array<std::int64_t, 3>> {
+        OverflowFlag flag{};
+        const auto res = checked_cross(pt_a, pt_b, flag);
+        if (flag) return std::nullopt;
+        return res;
+    }
+
+    /**
+     * @brief Dot product, or std::nullopt if it overflows int64.
+     *
+     * @param[in] pt_a
+     * @param[in] pt_b
+     * @return std::optional<int64_t>
+     */
+    constexpr auto try_dot(const std::array<std::int64_t, 3>& pt_a,
+                           const std::array<std::int64_t, 3>& pt_b) -> std::optional<std::int64_t> {
+        OverflowFlag flag{};
+        const auto res = checked_dot(pt_a, pt_b, flag);
+        if (flag) return std::nullopt;
+        return res;
+    }
+
+    /**
+     * @brief Homogeneous parametrization, or std::nullopt if it overflows int64.
+     *
+     * @param[in] lambda_val
+     * @param[in] pt_p
+     * @param[in] mu_val
+     * @param[in] pt_q
+     * @return std::optional<std::array<int64_t, 3>>
+     */
+    constexpr auto try_plckr(std::int64_t lambda_val, const std::array<std::int64_t, 3>& pt_p,
+                             std::int64_t mu_val, const std::array<std::int64_t, 3>& pt_q)
+        -> std::optional<std::array<std::int64_t, 3>> {
+        OverflowFlag flag{};
+        const auto res = checked_plckr(lambda_val, pt_p, mu_val, pt_q, flag);
+        if (flag) return std::nullopt;
+        return res;
+    }
+
+    // ---- PgObject wrappers --------------------------------------------------
+
+    /**
+     * @brief Checked meet of two PgObject-derived objects.
+     *
+     * @tparam Object PgPoint, PgLine, EllipticPoint, ...
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[in,out] flag
+     * @return Object::Dual
+     */
+    template <typename Object>
+    constexpr auto checked_meet(const Object& lhs, const Object& rhs, OverflowFlag& flag) ->
+        typename Object::Dual {
+        return typename Object::Dual{checked_cross(lhs.coord, rhs.coord, flag)};
+    }
+
+    /**
+     * @brief Checked incidence test.
+     *
+     * With __int128 the products are exact. Their sum can only overflow
+     * int128 for coordinates near INT64_MIN; then the flag is raised and,
+     * since a sum that large is nonzero, false is returned.
+     *
+     * @tparam Object PgPoint, PgLine, EllipticPoint, ...
+     * @param[in] obj
+     * @param[in] dual
+     * @param[in,out] flag
+     * @return bool
+     */
+    template <typename Object>
+    constexpr auto checked_incident(const Object& obj, const typename Object::Dual& dual,
+                                    OverflowFlag& flag) -> bool {
+#if PROJGEOM_HAS_INT128
+        const auto& a = obj.coord;
+        const auto& b = dual.coord;
+        int128_t res = 0;
+        if (__builtin_add_overflow(int128_t{a[0]} * b[0], int128_t{a[1]} * b[1], &res)
+            || __builtin_add_overflow(res, int128_t{a[2]} * b[2], &res)) {
+            flag.raise(true);
+            return false;
+        }
+        return res == 0;
+#else
+        return checked_dot(obj.coord, dual.coord, flag) == 0;
+#endif
+    }
+
+    /**
+     * @brief Checked homogeneous parametrization of PgObject-derived objects.
+     *
+     * @tparam Object PgPoint, PgLine, EllipticPoint, ...
+     * @param[in] lambda_val
+     * @param[in] pt_p
+     * @param[in] mu_val
+     * @param[in] pt_q
+     * @param[in,out] flag
+     * @return Object
+     */
+    template <typename Object>
+    constexpr auto checked_parametrize(std::int64_t lambda_val, const Object& pt_p,
+                                       std::int64_t mu_val, const Object& pt_q, OverflowFlag& flag)
+        -> Object {
+        return Object{checked_plckr(lambda_val, pt_p.coord, mu_val, pt_q.coord, flag)};
+    }
+
+}  // namespace fun
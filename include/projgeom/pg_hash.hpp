@@ -0,0 +1,103 @@
+/** @file pg_hash.hpp
+ *  @brief std::hash for projective points and lines, built on their canonical form.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "pg_line.hpp"
+#include "pg_object.hpp"
+#include "pg_point.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Finalizer of splitmix64 (full avalanche of a 64-bit word).
+     *
+     * @param[in] val
+     * @return std::uint64_t
+     */
+    constexpr auto mix64(std::uint64_t val) noexcept -> std::uint64_t {
+        val ^= val >> 30;
+        val *= 0xbf58476d1ce4e5b9ULL;
+        val ^= val >> 27;
+        val *= 0x94d049bb133111ebULL;
+        val ^= val >> 31;
+        return val;
+    }
+
+    /**
+     * @brief Hash of a coordinate triple (not canonicalized).
+     *
+     * @param[in] coord
+     * @return std::uint64_t
+     */
+    constexpr auto hash_coord(const std::array<std::int64_t, 3>& coord) noexcept
+        -> std::uint64_t {
+        auto val = static_cast<std::uint64_t>(coord[0]) * 0x9e3779b97f4a7c15ULL;
+        val = (val ^ static_cast<std::uint64_t>(coord[1])) * 0xc2b2ae3d27d4eb4fULL;
+        val = (val ^ static_cast<std::uint64_t>(coord[2])) * 0x165667b19e3779f9ULL;
+        return mix64(val);
+    }
+
+    /**
+     * @brief Is Object derived from PgObject<Object, Object::Dual>?
+     *
+     * @tparam Object
+     */
+    template <typename Object>
+    concept PgObjectType = requires { typename Object::Dual; }
+                           && std::is_base_of_v<PgObject<Object, typename Object::Dual>, Object>;
+
+}  // namespace fun
+
+/**
+ * @brief Hash of PgPoint, PgLine, EllipticPoint, HyperbolicLine, ...
+ *
+ * Equal projective objects (proportional coordinates) hash equally because
+ * the hash is taken over the canonical form.
+ *
+ * @tparam Object PgObject-derived type
+ */
+template <fun::PgObjectType Object> struct std::hash<Object> {
+    auto operator()(const Object& obj) const noexcept -> std::size_t {
+        return static_cast<std::size_t>(fun::hash_coord(::canonical(obj.coord)));
+    }
+};
+
+/**
+ * @brief Hash of fun::pg_point over an integral coordinate type.
+ *
+ * @tparam _K
+ */
+template <fun::Integral _K> struct std::hash<fun::pg_point<_K>> {
+    auto operator()(const fun::pg_point<_K>& obj) const -> std::size_t {
+        const auto coord = fun::canonical_c(obj.coord);
+        std::uint64_t val = 0x9e3779b97f4a7c15ULL;
+        for (const auto& c : coord) {
+            val = fun::mix64(val ^ static_cast<std::uint64_t>(std::hash<_K>{}(c)));
+        }
+        return static_cast<std::size_t>(val);
+    }
+};
+
+/**
+ * @brief Hash of fun::pg_line over an integral coordinate type.
+ *
+ * @tparam _K
+ */
+template <fun::Integral _K> struct std::hash<fun::pg_line<_K>> {
+    auto operator()(const fun::pg_line<_K>& obj) const -> std::size_t {
+        const auto coord = fun::canonical_c(obj.coord);
+        std::uint64_t val = 0x7f4a7c159e3779b9ULL;
+        for (const auto& c : coord) {
+            val = fun::mix64(val ^ static_cast<std::uint64_t>(std::hash<_K>{}(c)));
+        }
+        return static_cast<std::size_t>(val);
+    }
+};
@@ -5,9 +5,15 @@
 #pragma once
 
 #include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 
 // #include "common_concepts.h"
+#include "binary_gcd.hpp"
 #include "pg_plane.hpp"
 
 /**
@@ -65,8 +71,76 @@ constexpr auto plckr(const int64_t& lambda, const std::array<int64_t, 3>& pt_p,
     };
 }
 
+/**
+ * @brief Canonical representative of a homogeneous 3-vector.
+ *
+ * Divides out the gcd of the three coordinates and makes the first nonzero
+ * coordinate positive, so that two vectors represent the same projective
+ * object iff their canonical forms are equal:
+ * @f[
+ *     \operatorname{canonical}(v) = \frac{\pm v}{\gcd(v_x, v_y, v_z)}
+ * @f]
+ * The zero vector is returned unchanged. In the single case where the sign
+ * flip is not representable (a coordinate of INT64_MIN with gcd 1), the
+ * input is already the only int64 representative and is returned as is.
+ *
+ * @param[in] coord
+ * @return std::array<int64_t, 3>
+ */
+constexpr auto canonical(const std::array<int64_t, 3>& coord) -> std::array<int64_t, 3> {
+    const std::array<uint64_t, 3> mag{fun::magnitude(coord[0]), fun::magnitude(coord[1]),
+                                      fun::magnitude(coord[2])};
+    const auto common = fun::binary_gcd(fun::binary_gcd(mag[0], mag[1]), mag[2]);
+    if (common == 0) {
+        return coord;
+    }
+    const bool negate
+        = coord[0] != 0 ? coord[0] < 0 : (coord[1] != 0 ? coord[1] < 0 : coord[2] < 0);
+    std::array<int64_t, 3> res{};
+    for (std::size_t i = 0; i < 3; ++i) {
+        const auto quot = mag[i] / common;
+        const bool negative = (coord[i] < 0) != negate;
+        if (!negative && quot > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return coord;
+        }
+        res[i] = static_cast<int64_t>(negative ? uint64_t{0} - quot : quot);
+    }
+    return res;
+}
+
 namespace fun {
 
+    /**
+     * @brief Canonical representative of a homogeneous 3-vector over an integral domain.
+     *
+     * Generic counterpart of ::canonical: divide by the gcd of the three
+     * coordinates and make the first nonzero coordinate positive.
+     * @tparam _K
+     * @param[in] coord
+     * @return std::array<_K, 3>
+     */
+    template <Integral _K> constexpr auto canonical_c(std::array<_K, 3> coord)
+        -> std::array<_K, 3> {
+        if constexpr (std::is_same_v<_K, int64_t>) {
+            return ::canonical(coord);
+        } else {
+            const auto common = gcd_iterative(gcd_iterative(coord[0], coord[1]), coord[2]);
+            if (common == _K(0)) {
+                return coord;
+            }
+            const bool negate = coord[0] != _K(0)   ? coord[0] < _K(0)
+                                : coord[1] != _K(0) ? coord[1] < _K(0)
+                                                    : coord[2] < _K(0);
+            for (auto& val : coord) {
+                val /= common;
+                if (negate) {
+                    val = -val;
+                }
+            }
+            return coord;
+        }
+    }
+
     /**
      * @brief Generic projective geometry object (value-type templated)
      *
@@ -98,7 +172,25 @@ namespace fun {
         }
 
         friend constexpr auto operator*(const Self& lhs, const Self& rhs) -> DualType {
-            return DualType{::cross(lhs.coord, rhs.coord)};
+            if constexpr (std::is_same_v<_K, int64_t>) {
+                return DualType{::cross(lhs.coord, rhs.coord)};
+            } else {
+                const auto& v_a = lhs.coord;
+                const auto& v_b = rhs.coord;
+                return DualType{std::array<_K, 3>{v_a[1] * v_b[2] - v_a[2] * v_b[1],
+                                                  v_a[2] * v_b[0] - v_a[0] * v_b[2],
+                                                  v_a[0] * v_b[1] - v_a[1] * v_b[0]}};
+            }
+        }
+
+        /**
+         * @brief Meet (or join) with another object, same as operator*.
+         *
+         * @param[in] other
+         * @return DualType
+         */
+        constexpr auto meet(const Self& other) const -> DualType {
+            return static_cast<const Self&>(*this) * other;
         }
 
         constexpr auto aux() const -> DualType { return DualType{this->coord}; }
@@ -114,10 +206,192 @@ namespace fun {
 
         static constexpr auto parametrize(const _K& lambda_val, const Self& pt_p, const _K& mu_val,
                                           const Self& pt_q) -> Self {
-            return Self{::plckr(lambda_val, pt_p.coord, mu_val, pt_q.coord)};
+            if constexpr (std::is_same_v<_K, int64_t>) {
+                return Self{::plckr(lambda_val, pt_p.coord, mu_val, pt_q.coord)};
+            } else {
+                return Self{std::array<_K, 3>{lambda_val * pt_p.coord[0] + mu_val * pt_q.coord[0],
+                                              lambda_val * pt_p.coord[1] + mu_val * pt_q.coord[1],
+                                              lambda_val * pt_p.coord[2] + mu_val * pt_q.coord[2]}};
+            }
+        }
+
+        /**
+         * @brief Canonical representative (gcd-reduced, first nonzero coordinate positive).
+         *
+         * @return Self
+         */
+        constexpr auto canonicalize() const -> Self
+            requires Integral<_K>
+        {
+            return Self{canonical_c(this->coord)};
         }
     };
 
+    /**
+     * @brief Difference of products with a single rounding error (Kahan's algorithm).
+     *
+     * @f[
+     *     ab - cd
+     * @f]
+     * The rounding error of \f$cd\f$ is recovered with an FMA and added back,
+     * which avoids the catastrophic cancellation of the naive formula.
+     * @tparam _K floating-point type
+     * @param[in] a
+     * @param[in] b
+     * @param[in] c
+     * @param[in] d
+     * @return _K
+     */
+    template <std::floating_point _K> inline auto diff_of_products(_K a, _K b, _K c, _K d) -> _K {
+        const _K cd = c * d;
+        const _K err = std::fma(-c, d, cd);
+        const _K dop = std::fma(a, b, -cd);
+        return dop + err;
+    }
+
+    /**
+     * @brief Cross product of two floating-point 3-vectors using FMA.
+     *
+     * @tparam _K floating-point type
+     * @param[in] v_a
+     * @param[in] v_b
+     * @return std::array<_K, 3>
+     */
+    template <std::floating_point _K>
+    inline auto cross_fma(const std::array<_K, 3>& v_a, const std::array<_K, 3>& v_b)
+        -> std::array<_K, 3> {
+        return {diff_of_products(v_a[1], v_b[2], v_a[2], v_b[1]),
+                diff_of_products(v_a[2], v_b[0], v_a[0], v_b[2]),
+                diff_of_products(v_a[0], v_b[1], v_a[1], v_b[0])};
+    }
+
+    /**
+     * @brief Euclidean norm of a floating-point 3-vector.
+     *
+     * @tparam _K floating-point type
+     * @param[in] v_a
+     * @return _K
+     */
+    template <std::floating_point _K> inline auto norm3(const std::array<_K, 3>& v_a) -> _K {
+        return std::hypot(v_a[0], v_a[1], v_a[2]);
+    }
+
+    /**
+     * @brief Scale a floating-point 3-vector to unit length (the zero vector is kept).
+     *
+     * @tparam _K floating-point type
+     * @param[in] v_a
+     * @return std::array<_K, 3>
+     */
+    template <std::floating_point _K> inline auto unit3(std::array<_K, 3> v_a)
+        -> std::array<_K, 3> {
+        const auto len = norm3(v_a);
+        if (len != _K(0)) {
+            for (auto& val : v_a) {
+                val /= len;
+            }
+        }
+        return v_a;
+    }
+
+    /**
+     * @brief Projective geometry object over a floating-point type.
+     *
+     * Exact zero tests are meaningless after rounding, so this specialization
+     * - computes the cross product with FMA (Kahan's difference of products),
+     * - scales constructed objects to unit length, which keeps long
+     *   construction chains away from overflow and underflow, and
+     * - compares with a relative tolerance in incident() and operator==.
+     *
+     * @tparam _K floating-point value type
+     * @tparam Self The derived type (CRTP)
+     * @tparam DualType The dual object type
+     */
+    template <Ring _K, typename Self, typename DualType>
+        requires std::floating_point<_K>
+    struct pg_object<_K, Self, DualType> {
+        using Dual = DualType;
+        using value_type = _K;
+
+        /// Relative tolerance of incident() and operator==.
+        static constexpr _K tolerance = _K(64) * std::numeric_limits<_K>::epsilon();
+
+        std::array<_K, 3> coord;
+
+        constexpr explicit pg_object(std::array<_K, 3> coord) : coord{std::move(coord)} {}
+
+        constexpr pg_object(const _K& x, const _K& y, const _K& z) : coord{{x, y, z}} {}
+
+        /**
+         * @brief Equal up to a relative tolerance.
+         *
+         * @f[
+         *     \|a \times b\| \le \epsilon \|a\| \|b\|
+         * @f]
+         */
+        friend auto operator==(const Self& lhs, const Self& rhs) -> bool {
+            if (&lhs == &rhs) return true;
+            const auto prod = cross_fma(lhs.coord, rhs.coord);
+            return norm3(prod) <= tolerance * norm3(lhs.coord) * norm3(rhs.coord);
+        }
+
+        friend auto operator!=(const Self& lhs, const Self& rhs) -> bool { return !(lhs == rhs); }
+
+        /**
+         * @brief Join/meet, scaled to unit length.
+         *
+         * @f[
+         *     l = \frac{p \times q}{\|p \times q\|}
+         * @f]
+         */
+        friend auto operator*(const Self& lhs, const Self& rhs) -> DualType {
+            return DualType{unit3(cross_fma(lhs.coord, rhs.coord))};
+        }
+
+        auto meet(const Self& other) const -> DualType {
+            return static_cast<const Self&>(*this) * other;
+        }
+
+        constexpr auto aux() const -> DualType { return DualType{this->coord}; }
+
+        auto dot(const DualType& other) const -> _K {
+            return std::fma(this->coord[0], other.coord[0],
+                            std::fma(this->coord[1], other.coord[1],
+                                     this->coord[2] * other.coord[2]));
+        }
+
+        /**
+         * @brief Incidence up to a relative tolerance.
+         *
+         * @f[
+         *     |a \cdot b| \le \epsilon \|a\| \|b\|
+         * @f]
+         */
+        auto incident(const DualType& other) const -> bool {
+            using std::abs;
+            return abs(this->dot(other))
+                   <= tolerance * norm3(this->coord) * norm3(other.coord);
+        }
+
+        /**
+         * @brief Homogeneous parametrization, scaled to unit length.
+         */
+        static auto parametrize(const _K& lambda_val, const Self& pt_p, const _K& mu_val,
+                                const Self& pt_q) -> Self {
+            return Self{unit3(std::array<_K, 3>{
+                std::fma(lambda_val, pt_p.coord[0], mu_val * pt_q.coord[0]),
+                std::fma(lambda_val, pt_p.coord[1], mu_val * pt_q.coord[1]),
+                std::fma(lambda_val, pt_p.coord[2], mu_val * pt_q.coord[2])})};
+        }
+
+        /**
+         * @brief The same object scaled to unit length.
+         *
+         * @return Self
+         */
+        auto normalize() const -> Self { return Self{unit3(this->coord)}; }
+    };
+
 }  // namespace fun
 
 /**
@@ -223,6 +497,18 @@ template <typename Point, typename Line> struct PgObject {
     constexpr auto meet(const Point& rhs) const -> Line {
         return Line{::cross(this->coord, rhs.coord)};
     }
+
+    /**
+     * @brief Canonical representative of the same projective object.
+     *
+     * Dividing out the gcd between construction steps keeps the coordinate
+     * magnitudes bounded.
+     * @f[
+     *     p \mapsto \frac{\pm p}{\gcd(p_x, p_y, p_z)}
+     * @f]
+     * @return Point
+     */
+    constexpr auto canonicalize() const -> Point { return Point{::canonical(this->coord)}; }
 };
 
 class PgPoint;
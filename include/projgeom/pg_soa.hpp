@@ -0,0 +1,410 @@
+/** @file pg_soa.hpp
+ *  @brief Structure-of-arrays containers and batched kernels for PgPoint/PgLine.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "pg_object.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Read-only view of homogeneous coordinates stored column-wise.
+     *
+     * The i-th object is \f$(x_i : y_i : z_i)\f$. All three columns must have
+     * the same length.
+     */
+    struct CoordView {
+        std::span<const std::int64_t> x;
+        std::span<const std::int64_t> y;
+        std::span<const std::int64_t> z;
+
+        /**
+         * @brief Number of objects in the view.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return x.size(); }
+    };
+
+    /**
+     * @brief Writable view of homogeneous coordinates stored column-wise.
+     */
+    struct CoordSpan {
+        std::span<std::int64_t> x;
+        std::span<std::int64_t> y;
+        std::span<std::int64_t> z;
+
+        /**
+         * @brief Number of objects in the span.
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return x.size(); }
+
+        /**
+         * @brief Convert to a read-only view.
+         *
+         * @return CoordView
+         */
+        constexpr operator CoordView() const noexcept { return {x, y, z}; }
+    };
+
+    /**
+     * @brief Structure-of-arrays container of projective objects.
+     *
+     * Stores the x, y and z coordinates of PgPoint/PgLine-like objects in
+     * three separate contiguous columns, so that batched kernels can stream
+     * over them with unit stride.
+     *
+     * @tparam Object PgObject-derived type (e.g. PgPoint or PgLine)
+     */
+    template <typename Object> class PgSoA {
+      public:
+        using value_type = Object;
+
+        /**
+         * @brief Construct an empty container.
+         */
+        PgSoA() = default;
+
+        /**
+         * @brief Construct a container of n zero-initialized objects.
+         *
+         * @param[in] n number of objects
+         */
+        explicit PgSoA(std::size_t n) : x_(n), y_(n), z_(n) {}
+
+        /**
+         * @brief Construct a container from an array of objects.
+         *
+         * @param[in] objs objects to copy
+         */
+        explicit PgSoA(std::span<const Object> objs) {
+            this->reserve(objs.size());
+            for (const auto& obj : objs) {
+                this->push_back(obj);
+            }
+        }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return x_.size(); }
+
+        [[nodiscard]] auto empty() const noexcept -> bool { return x_.empty(); }
+
+        void reserve(std::size_t n) {
+            x_.reserve(n);
+            y_.reserve(n);
+            z_.reserve(n);
+        }
+
+        void resize(std::size_t n) {
+            x_.resize(n);
+            y_.resize(n);
+            z_.resize(n);
+        }
+
+        void clear() noexcept {
+            x_.clear();
+            y_.clear();
+            z_.clear();
+        }
+
+        /**
+         * @brief Append an object.
+         *
+         * @param[in] obj
+         */
+        void push_back(const Object& obj) {
+            x_.push_back(obj.coord[0]);
+            y_.push_back(obj.coord[1]);
+            z_.push_back(obj.coord[2]);
+        }
+
+        /**
+         * @brief Gather the i-th object.
+         *
+         * @param[in] idx
+         * @return Object
+         */
+        [[nodiscard]] auto operator[](std::size_t idx) const -> Object {
+            return Object{{x_[idx], y_[idx], z_[idx]}};
+        }
+
+        /**
+         * @brief Scatter an object into the i-th slot.
+         *
+         * @param[in] idx
+         * @param[in] obj
+         */
+        void set(std::size_t idx, const Object& obj) {
+            x_[idx] = obj.coord[0];
+            y_[idx] = obj.coord[1];
+            z_[idx] = obj.coord[2];
+        }
+
+        [[nodiscard]] auto x() const noexcept -> std::span<const std::int64_t> { return x_; }
+        [[nodiscard]] auto y() const noexcept -> std::span<const std::int64_t> { return y_; }
+        [[nodiscard]] auto z() const noexcept -> std::span<const std::int64_t> { return z_; }
+        [[nodiscard]] auto x() noexcept -> std::span<std::int64_t> { return x_; }
+        [[nodiscard]] auto y() noexcept -> std::span<std::int64_t> { return y_; }
+        [[nodiscard]] auto z() noexcept -> std::span<std::int64_t> { return z_; }
+
+        /**
+         * @brief Read-only column view.
+         *
+         * @return CoordView
+         */
+        [[nodiscard]] auto view() const noexcept -> CoordView { return {x_, y_, z_}; }
+
+        /**
+         * @brief Writable column view.
+         *
+         * @return CoordSpan
+         */
+        [[nodiscard]] auto span() noexcept -> CoordSpan { return {x_, y_, z_}; }
+
+      private:
+        std::vector<std::int64_t> x_;
+        std::vector<std::int64_t> y_;
+        std::vector<std::int64_t> z_;
+    };
+
+    using PointSoA = PgSoA<PgPoint>;
+    using LineSoA = PgSoA<PgLine>;
+
+    /**
+     * @brief Number of 64-bit words needed to hold n packed bits.
+     *
+     * @param[in] n number of bits
+     * @return std::size_t
+     */
+    constexpr auto bit_words(std::size_t n) noexcept -> std::size_t { return (n + 63) / 64; }
+
+    // ---- column kernels -----------------------------------------------------
+
+    /**
+     * @brief Batched meet: out[i] = lhs[i] × rhs[i].
+     *
+     * @f[
+     *     l_i = p_i \times q_i
+     * @f]
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void meet(CoordView lhs, CoordView rhs, CoordSpan out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        const auto n = lhs.size();
+        const auto* ax = lhs.x.data();
+        const auto* ay = lhs.y.data();
+        const auto* az = lhs.z.data();
+        const auto* bx = rhs.x.data();
+        const auto* by = rhs.y.data();
+        const auto* bz = rhs.z.data();
+        auto* ox = out.x.data();
+        auto* oy = out.y.data();
+        auto* oz = out.z.data();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto cx = ay[i] * bz[i] - az[i] * by[i];
+            const auto cy = az[i] * bx[i] - ax[i] * bz[i];
+            const auto cz = ax[i] * by[i] - ay[i] * bx[i];
+            ox[i] = cx;
+            oy[i] = cy;
+            oz[i] = cz;
+        }
+    }
+
+    /**
+     * @brief Batched dot product: out[i] = lhs[i] · rhs[i].
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void dot(CoordView lhs, CoordView rhs, std::span<std::int64_t> out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        const auto n = lhs.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = lhs.x[i] * rhs.x[i] + lhs.y[i] * rhs.y[i] + lhs.z[i] * rhs.z[i];
+        }
+    }
+
+    /**
+     * @brief Batched incidence test, packed as bits.
+     *
+     * Bit i of out_bits (word i / 64, bit i % 64) is set iff
+     * \f$p_i \cdot l_i = 0\f$.
+     *
+     * @param[in] points
+     * @param[in] lines
+     * @param[out] out_bits must hold at least bit_words(points.size()) words
+     */
+    inline void incident(CoordView points, CoordView lines, std::span<std::uint64_t> out_bits) {
+        assert(points.size() == lines.size() && out_bits.size() >= bit_words(points.size()));
+        const auto n = points.size();
+        for (std::size_t base = 0; base < n; base += 64) {
+            const auto len = (n - base < 64) ? n - base : std::size_t{64};
+            std::uint64_t word = 0;
+            for (std::size_t k = 0; k < len; ++k) {
+                const auto i = base + k;
+                const auto d = points.x[i] * lines.x[i] + points.y[i] * lines.y[i]
+                               + points.z[i] * lines.z[i];
+                word |= std::uint64_t{d == 0} << k;
+            }
+            out_bits[base / 64] = word;
+        }
+    }
+
+    /**
+     * @brief Batched parametrization: out[i] = lambda[i] p[i] + mu[i] q[i].
+     *
+     * @param[in] lambda_val per-object coefficients for p
+     * @param[in] pts_p
+     * @param[in] mu_val per-object coefficients for q
+     * @param[in] pts_q
+     * @param[out] out
+     */
+    inline void parametrize(std::span<const std::int64_t> lambda_val, CoordView pts_p,
+                            std::span<const std::int64_t> mu_val, CoordView pts_q, CoordSpan out) {
+        assert(pts_p.size() == pts_q.size() && out.size() == pts_p.size());
+        assert(lambda_val.size() == pts_p.size() && mu_val.size() == pts_p.size());
+        const auto n = pts_p.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto lam = lambda_val[i];
+            const auto mu = mu_val[i];
+            out.x[i] = lam * pts_p.x[i] + mu * pts_q.x[i];
+            out.y[i] = lam * pts_p.y[i] + mu * pts_q.y[i];
+            out.z[i] = lam * pts_p.z[i] + mu * pts_q.z[i];
+        }
+    }
+
+    /**
+     * @brief Batched parametrization with shared coefficients.
+     *
+     * @f[
+     *     r_i = \lambda p_i + \mu q_i
+     * @f]
+     * @param[in] lambda_val
+     * @param[in] pts_p
+     * @param[in] mu_val
+     * @param[in] pts_q
+     * @param[out] out
+     */
+    inline void parametrize(std::int64_t lambda_val, CoordView pts_p, std::int64_t mu_val,
+                            CoordView pts_q, CoordSpan out) {
+        assert(pts_p.size() == pts_q.size() && out.size() == pts_p.size());
+        const auto n = pts_p.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out.x[i] = lambda_val * pts_p.x[i] + mu_val * pts_q.x[i];
+            out.y[i] = lambda_val * pts_p.y[i] + mu_val * pts_q.y[i];
+            out.z[i] = lambda_val * pts_p.z[i] + mu_val * pts_q.z[i];
+        }
+    }
+
+    /**
+     * @brief Batched in-place canonicalization (see ::canonical).
+     *
+     * @param[in,out] objs
+     */
+    inline void canonicalize(CoordSpan objs) {
+        const auto n = objs.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto res = ::canonical({objs.x[i], objs.y[i], objs.z[i]});
+            objs.x[i] = res[0];
+            objs.y[i] = res[1];
+            objs.z[i] = res[2];
+        }
+    }
+
+    // ---- container overloads ------------------------------------------------
+
+    /**
+     * @brief Batched meet over SoA containers (out is resized).
+     *
+     * @tparam Object PgPoint or PgLine
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out
+     */
+    template <typename Object>
+    void meet(const PgSoA<Object>& lhs, const PgSoA<Object>& rhs,
+              PgSoA<typename Object::Dual>& out) {
+        out.resize(lhs.size());
+        meet(lhs.view(), rhs.view(), out.span());
+    }
+
+    /**
+     * @brief Batched incidence over SoA containers (out_bits is resized).
+     *
+     * @tparam Object PgPoint or PgLine
+     * @param[in] objs
+     * @param[in] duals
+     * @param[out] out_bits
+     */
+    template <typename Object>
+    void incident(const PgSoA<Object>& objs, const PgSoA<typename Object::Dual>& duals,
+                  std::vector<std::uint64_t>& out_bits) {
+        out_bits.resize(bit_words(objs.size()));
+        incident(objs.view(), duals.view(), std::span<std::uint64_t>{out_bits});
+    }
+
+    /**
+     * @brief Batched meet over arrays of objects.
+     *
+     * @tparam Object PgPoint or PgLine
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    template <typename Object>
+    void meet(std::span<const Object> lhs, std::span<const Object> rhs,
+              std::span<typename Object::Dual> out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            out[i].coord = ::cross(lhs[i].coord, rhs[i].coord);
+        }
+    }
+
+    /**
+     * @brief Batched incidence over arrays of objects, packed as bits.
+     *
+     * @tparam Object PgPoint or PgLine
+     * @param[in] objs
+     * @param[in] duals
+     * @param[out] out_bits must hold at least bit_words(objs.size()) words
+     */
+    template <typename Object>
+    void incident(std::span<const Object> objs, std::span<const typename Object::Dual> duals,
+                  std::span<std::uint64_t> out_bits) {
+        assert(objs.size() == duals.size() && out_bits.size() >= bit_words(objs.size()));
+        const auto n = objs.size();
+        for (std::size_t base = 0; base < n; base += 64) {
+            const auto len = (n - base < 64) ? n - base : std::size_t{64};
+            std::uint64_t word = 0;
+            for (std::size_t k = 0; k < len; ++k) {
+                word |= std::uint64_t{objs[base + k].incident(duals[base + k])} << k;
+            }
+            out_bits[base / 64] = word;
+        }
+    }
+
+
+    /**
+     * @brief Batched in-place canonicalization of an array of objects.
+     *
+     * @tparam Object PgPoint or PgLine
+     * @param[in,out] objs
+     */
+    template <typename Object> void canonicalize(std::span<Object> objs) {
+        for (auto& obj : objs) {
+            obj.coord = ::canonical(obj.coord);
+        }
+    }
+
+}  // namespace fun
@@ -0,0 +1,298 @@
+/** @file projective_set.hpp
+ *  @brief Open-addressing hash set/map keyed by projective points or lines.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "pg_hash.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Open-addressing hash map from projective objects to values.
+     *
+     * Keys are stored in canonical form (24 bytes), so two keys are the same
+     * projective object iff their three coordinates are equal; no
+     * cross-multiplication is needed on lookup. Linear probing is used with a
+     * one-byte control array holding a 7-bit hash tag, which rejects most
+     * non-matching slots without touching the keys. Erasure uses backward
+     * shifting, so there are no tombstones.
+     *
+     * @tparam Object PgObject-derived type (PgPoint, PgLine, EllipticPoint, ...)
+     * @tparam T mapped type
+     */
+    template <PgObjectType Object, typename T> class ProjectiveMap {
+      public:
+        using key_type = Object;
+        using mapped_type = T;
+
+        /**
+         * @brief Construct an empty map.
+         */
+        ProjectiveMap() = default;
+
+        /**
+         * @brief Construct an empty map with room for n elements.
+         *
+         * @param[in] n
+         */
+        explicit ProjectiveMap(std::size_t n) { this->reserve(n); }
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+        [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t { return ctrl_.size(); }
+
+        void clear() noexcept {
+            ctrl_.assign(ctrl_.size(), kEmpty);
+            size_ = 0;
+        }
+
+        /**
+         * @brief Make room for n elements without rehashing.
+         *
+         * @param[in] n
+         */
+        void reserve(std::size_t n) {
+            std::size_t cap = kMinCapacity;
+            while (cap * 7 < n * 8) {
+                cap *= 2;
+            }
+            if (cap > ctrl_.size()) {
+                this->rehash(cap);
+            }
+        }
+
+        /**
+         * @brief Insert key -> value unless the key is already present.
+         *
+         * @param[in] key
+         * @param[in] value
+         * @return true if inserted, false if the key was present (value untouched)
+         */
+        auto insert(const Object& key, T value) -> bool {
+            const auto [idx, found] = this->locate(::canonical(key.coord));
+            if (found) return false;
+            this->emplace_at(idx, ::canonical(key.coord), std::move(value));
+            return true;
+        }
+
+        /**
+         * @brief Access the value of key, inserting T{} if missing.
+         *
+         * @param[in] key
+         * @return T&
+         */
+        auto operator[](const Object& key) -> T& {
+            const auto can = ::canonical(key.coord);
+            auto [idx, found] = this->locate(can);
+            if (!found) {
+                idx = this->emplace_at(idx, can, T{});
+            }
+            return slots_[idx].value;
+        }
+
+        /**
+         * @brief Find the value of key.
+         *
+         * @param[in] key
+         * @return T* nullptr if missing
+         */
+        auto find(const Object& key) -> T* {
+            const auto [idx, found] = this->locate(::canonical(key.coord));
+            return found ? &slots_[idx].value : nullptr;
+        }
+
+        /**
+         * @brief Find the value of key.
+         *
+         * @param[in] key
+         * @return const T* nullptr if missing
+         */
+        auto find(const Object& key) const -> const T* {
+            const auto [idx, found] = this->locate(::canonical(key.coord));
+            return found ? &slots_[idx].value : nullptr;
+        }
+
+        [[nodiscard]] auto contains(const Object& key) const -> bool {
+            return this->locate(::canonical(key.coord)).second;
+        }
+
+        /**
+         * @brief Remove key.
+         *
+         * @param[in] key
+         * @return true if the key was present
+         */
+        auto erase(const Object& key) -> bool {
+            auto [hole, found] = this->locate(::canonical(key.coord));
+            if (!found) return false;
+            const auto mask = ctrl_.size() - 1;
+            // backward-shift deletion: pull later members of the probe run into the hole
+            for (auto idx = (hole + 1) & mask; ctrl_[idx] != kEmpty; idx = (idx + 1) & mask) {
+                const auto home = static_cast<std::size_t>(hash_coord(slots_[idx].key)) & mask;
+                if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+                    ctrl_[hole] = ctrl_[idx];
+                    slots_[hole] = std::move(slots_[idx]);
+                    hole = idx;
+                }
+            }
+            ctrl_[hole] = kEmpty;
+            --size_;
+            return true;
+        }
+
+        /**
+         * @brief Visit every (key, value) pair; keys are passed in canonical form.
+         *
+         * @tparam Fn callable as fn(const Object&, const T&)
+         * @param[in] fn
+         */
+        template <typename Fn> void for_each(Fn&& fn) const {
+            for (std::size_t idx = 0; idx < ctrl_.size(); ++idx) {
+                if (ctrl_[idx] != kEmpty) {
+                    fn(Object{slots_[idx].key}, slots_[idx].value);
+                }
+            }
+        }
+
+      private:
+        struct Slot {
+            std::array<std::int64_t, 3> key;
+            [[no_unique_address]] T value;
+        };
+
+        static constexpr std::uint8_t kEmpty = 0;
+        static constexpr std::size_t kMinCapacity = 16;
+
+        static constexpr auto tag_of(std::uint64_t hash) noexcept -> std::uint8_t {
+            return static_cast<std::uint8_t>((hash >> 57) | 0x80U);
+        }
+
+        /// Slot holding key, or the empty slot where it would be inserted.
+        auto locate(const std::array<std::int64_t, 3>& key) const -> std::pair<std::size_t, bool> {
+            if (ctrl_.empty()) return {0, false};
+            const auto hash = hash_coord(key);
+            const auto tag = tag_of(hash);
+            const auto mask = ctrl_.size() - 1;
+            auto idx = static_cast<std::size_t>(hash) & mask;
+            for (; ctrl_[idx] != kEmpty; idx = (idx + 1) & mask) {
+                if (ctrl_[idx] == tag && slots_[idx].key == key) {
+                    return {idx, true};
+                }
+            }
+            return {idx, false};
+        }
+
+        auto emplace_at(std::size_t idx, const std::array<std::int64_t, 3>& key, T value)
+            -> std::size_t {
+            if (ctrl_.empty() || (size_ + 1) * 8 > ctrl_.size() * 7) {
+                this->rehash(ctrl_.empty() ? kMinCapacity : ctrl_.size() * 2);
+                idx = this->locate(key).first;
+            }
+            ctrl_[idx] = tag_of(hash_coord(key));
+            slots_[idx] = Slot{key, std::move(value)};
+            ++size_;
+            return idx;
+        }
+
+        void rehash(std::size_t cap) {
+            auto old_ctrl = std::move(ctrl_);
+            auto old_slots = std::move(slots_);
+            ctrl_.assign(cap, kEmpty);
+            slots_.clear();
+            slots_.resize(cap);
+            const auto mask = cap - 1;
+            for (std::size_t i = 0; i < old_ctrl.size(); ++i) {
+                if (old_ctrl[i] == kEmpty) continue;
+                auto idx = static_cast<std::size_t>(hash_coord(old_slots[i].key)) & mask;
+                while (ctrl_[idx] != kEmpty) {
+                    idx = (idx + 1) & mask;
+                }
+                ctrl_[idx] = old_ctrl[i];
+                slots_[idx] = std::move(old_slots[i]);
+            }
+        }
+
+        std::vector<std::uint8_t> ctrl_;
+        std::vector<Slot> slots_;
+        std::size_t size_{0};
+    };
+
+    /**
+     * @brief Open-addressing hash set of projective objects.
+     *
+     * @tparam Object PgObject-derived type (PgPoint, PgLine, EllipticPoint, ...)
+     */
+    template <PgObjectType Object> class ProjectiveSet {
+      public:
+        using key_type = Object;
+
+        ProjectiveSet() = default;
+
+        /**
+         * @brief Construct an empty set with room for n elements.
+         *
+         * @param[in] n
+         */
+        explicit ProjectiveSet(std::size_t n) : map_(n) {}
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t { return map_.size(); }
+        [[nodiscard]] auto empty() const noexcept -> bool { return map_.empty(); }
+        void clear() noexcept { map_.clear(); }
+        void reserve(std::size_t n) { map_.reserve(n); }
+
+        /**
+         * @brief Insert obj.
+         *
+         * @param[in] obj
+         * @return true if obj was not present yet
+         */
+        auto insert(const Object& obj) -> bool { return map_.insert(obj, Unit{}); }
+
+        [[nodiscard]] auto contains(const Object& obj) const -> bool { return map_.contains(obj); }
+
+        auto erase(const Object& obj) -> bool { return map_.erase(obj); }
+
+        /**
+         * @brief Visit every element (in canonical form).
+         *
+         * @tparam Fn callable as fn(const Object&)
+         * @param[in] fn
+         */
+        template <typename Fn> void for_each(Fn&& fn) const {
+            map_.for_each([&fn](const Object& obj, const Unit&) { fn(obj); });
+        }
+
+      private:
+        struct Unit {};
+
+        ProjectiveMap<Object, Unit> map_;
+    };
+
+    /**
+     * @brief Remove projectively duplicate objects, keeping first occurrences in order.
+     *
+     * @tparam Object PgObject-derived type
+     * @param[in] objs
+     * @return std::vector<Object>
+     */
+    template <PgObjectType Object> auto unique_objects(std::span<const Object> objs)
+        -> std::vector<Object> {
+        ProjectiveSet<Object> seen(objs.size());
+        std::vector<Object> res;
+        for (const auto& obj : objs) {
+            if (seen.insert(obj)) {
+                res.push_back(obj);
+            }
+        }
+        return res;
+    }
+
+}  // namespace fun
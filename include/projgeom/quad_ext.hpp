@@ -0,0 +1,193 @@
+/** @file quad_ext.hpp
+ *  @brief Numbers a + b√d of a quadratic extension of an exact ring.
+ *
+ *  Intersections of a rational line with a rational conic lie in Q(√d),
+ *  where d is the discriminant of the line. QuadExt keeps such coordinates
+ *  exact: a value carries its radicand d, and the arithmetic of two values
+ *  requires the same radicand unless one of them is in the base ring
+ *  (b = 0).
+ */
+
+#pragma once
+
+#include <concepts>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "common_concepts.h"
+
+namespace fun {
+
+    /**
+     * @brief The number a + b√d with a, b and d in the ring K.
+     *
+     * @tparam K  base ring (e.g. Fraction<std::int64_t>)
+     */
+    template <Ring K> class QuadExt {
+      public:
+        /**
+         * @brief Zero.
+         */
+        constexpr QuadExt() : a_(0), b_(0), d_(0) {}
+
+        /**
+         * @brief An element of the base ring.
+         *
+         * @param[in] rational
+         */
+        constexpr explicit QuadExt(K rational) : a_{std::move(rational)}, b_(0), d_(0) {}
+
+        /**
+         * @brief An integer.
+         *
+         * @param[in] val
+         */
+        template <std::integral I> constexpr explicit QuadExt(I val) : a_(val), b_(0), d_(0) {}
+
+        /**
+         * @brief The number a + b√d.
+         *
+         * @param[in] a rational part
+         * @param[in] b coefficient of the root
+         * @param[in] d radicand
+         */
+        constexpr QuadExt(K a, K b, K d) : a_{std::move(a)}, b_{std::move(b)}, d_{std::move(d)} {}
+
+        /** @brief The rational part a. */
+        [[nodiscard]] constexpr auto rational() const noexcept -> const K& { return a_; }
+
+        /** @brief The coefficient b of the root. */
+        [[nodiscard]] constexpr auto irrational() const noexcept -> const K& { return b_; }
+
+        /** @brief The radicand d. */
+        [[nodiscard]] constexpr auto radicand() const noexcept -> const K& { return d_; }
+
+        /** @brief Is the value in the base ring (b = 0)? */
+        [[nodiscard]] constexpr auto is_rational() const -> bool { return b_ == K(0); }
+
+        /**
+         * @brief The conjugate a - b√d.
+         *
+         * @return QuadExt
+         */
+        [[nodiscard]] constexpr auto conj() const -> QuadExt { return QuadExt{a_, -b_, d_}; }
+
+        /**
+         * @brief The norm (a + b√d)(a - b√d).
+         *
+         *  \f[ N(a + b\sqrt{d}) = a^2 - d b^2 \f]
+         * @return K
+         */
+        [[nodiscard]] constexpr auto norm() const -> K { return a_ * a_ - d_ * b_ * b_; }
+
+        // ---- comparison ------------------------------------------------------
+
+        /**
+         * @brief Exact equality (a root of a non-square radicand is irrational).
+         */
+        friend constexpr auto operator==(const QuadExt& lhs, const QuadExt& rhs) -> bool {
+            if (lhs.b_ == K(0) || rhs.b_ == K(0)) {
+                return lhs.a_ == rhs.a_ && lhs.b_ == rhs.b_;
+            }
+            return lhs.a_ == rhs.a_ && lhs.b_ == rhs.b_ && lhs.d_ == rhs.d_;
+        }
+
+        // ---- arithmetic ------------------------------------------------------
+
+        constexpr auto operator-() const -> QuadExt { return QuadExt{-a_, -b_, d_}; }
+
+        /**
+         * @brief Add and assign.
+         *
+         * @throws std::domain_error if both operands are irrational with different radicands.
+         */
+        constexpr auto operator+=(const QuadExt& rhs) -> QuadExt& {
+            this->adopt_radicand(rhs);
+            a_ += rhs.a_;
+            b_ += rhs.b_;
+            return *this;
+        }
+
+        /**
+         * @brief Subtract and assign.
+         *
+         * @throws std::domain_error if both operands are irrational with different radicands.
+         */
+        constexpr auto operator-=(const QuadExt& rhs) -> QuadExt& {
+            this->adopt_radicand(rhs);
+            a_ -= rhs.a_;
+            b_ -= rhs.b_;
+            return *this;
+        }
+
+        /**
+         * @brief Multiply and assign.
+         *
+         *  \f[ (a + b\sqrt{d})(a' + b'\sqrt{d}) = (a a' + d b b') + (a b' + a' b)\sqrt{d} \f]
+         * @throws std::domain_error if both operands are irrational with different radicands.
+         */
+        constexpr auto operator*=(const QuadExt& rhs) -> QuadExt& {
+            this->adopt_radicand(rhs);
+            K a_new = a_ * rhs.a_ + d_ * b_ * rhs.b_;
+            b_ = a_ * rhs.b_ + rhs.a_ * b_;
+            a_ = std::move(a_new);
+            return *this;
+        }
+
+        /**
+         * @brief Divide and assign, multiplying by the conjugate of rhs.
+         *
+         * Available if K is a field.
+         * @throws std::domain_error if rhs is zero or the radicands differ.
+         */
+        constexpr auto operator/=(const QuadExt& rhs) -> QuadExt&
+            requires requires(K x, K y) { x / y; }
+        {
+            const auto den = rhs.norm();
+            if (den == K(0)) throw std::domain_error{"QuadExt: division by zero"};
+            *this *= rhs.conj();
+            a_ = a_ / den;
+            b_ = b_ / den;
+            return *this;
+        }
+
+        friend constexpr auto operator+(QuadExt lhs, const QuadExt& rhs) -> QuadExt {
+            return lhs += rhs;
+        }
+
+        friend constexpr auto operator-(QuadExt lhs, const QuadExt& rhs) -> QuadExt {
+            return lhs -= rhs;
+        }
+
+        friend constexpr auto operator*(QuadExt lhs, const QuadExt& rhs) -> QuadExt {
+            return lhs *= rhs;
+        }
+
+        friend constexpr auto operator/(QuadExt lhs, const QuadExt& rhs) -> QuadExt
+            requires requires(K x, K y) { x / y; }
+        {
+            return lhs /= rhs;
+        }
+
+        /**
+         * @brief Output as (a + b√d).
+         */
+        friend auto operator<<(std::ostream& os, const QuadExt& val) -> std::ostream& {
+            return os << "(" << val.a_ << " + " << val.b_ << "√" << val.d_ << ")";
+        }
+
+      private:
+        K a_;
+        K b_;
+        K d_;
+
+        /// Take over the radicand of an irrational rhs, or reject a mismatch.
+        constexpr void adopt_radicand(const QuadExt& rhs) {
+            if (rhs.b_ == K(0) || rhs.d_ == d_) return;
+            if (b_ != K(0)) throw std::domain_error{"QuadExt: different radicands"};
+            d_ = rhs.d_;
+        }
+    };
+
+}  // namespace fun
@@ -0,0 +1,360 @@
+/** @file robust_predicates.hpp
+ *  @brief Filtered exact incidence, coincidence and perspectivity predicates for doubles.
+ *
+ *  Each predicate is a polynomial in the input coordinates. It is first
+ *  evaluated in double precision together with a running forward error
+ *  bound; if the bound proves the sign, that sign is returned. Only near
+ *  degeneracy is the polynomial re-evaluated exactly with Shewchuk's
+ *  floating-point expansion arithmetic.
+ *
+ *  The input coordinates are taken as exact binary numbers. The predicates
+ *  assume round-to-nearest IEEE-754 arithmetic without overflow or
+ *  underflow (i.e. no -ffast-math).
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fun {
+
+    namespace detail {
+
+        /// Unit roundoff of double.
+        inline constexpr double unit_roundoff = std::numeric_limits<double>::epsilon() / 2;
+
+        /**
+         * @brief Error-free sum: a + b = x + y exactly, x = fl(a + b).
+         */
+        inline auto two_sum(double a, double b) -> std::pair<double, double> {
+            const double x = a + b;
+            const double b_virt = x - a;
+            const double a_virt = x - b_virt;
+            return {x, (a - a_virt) + (b - b_virt)};
+        }
+
+        /**
+         * @brief Error-free sum for |a| >= |b|.
+         */
+        inline auto fast_two_sum(double a, double b) -> std::pair<double, double> {
+            const double x = a + b;
+            return {x, b - (x - a)};
+        }
+
+        /**
+         * @brief Error-free product: a * b = x + y exactly, x = fl(a * b).
+         */
+        inline auto two_product(double a, double b) -> std::pair<double, double> {
+            const double x = a * b;
+            return {x, std::fma(a, b, -x)};
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Exact real number as a floating-point expansion (Shewchuk).
+     *
+     * The value is the exact sum of the components, which are
+     * non-overlapping and sorted by increasing magnitude, with zeros
+     * eliminated; hence the sign is the sign of the last component.
+     */
+    class Expansion {
+      public:
+        Expansion() = default;
+
+        /**
+         * @brief Construct from a double (exactly).
+         *
+         * @param[in] val
+         */
+        explicit Expansion(double val) {
+            if (val != 0.0) comp_.push_back(val);
+        }
+
+        /**
+         * @brief Sign of the exact value.
+         *
+         * @return int -1, 0 or +1
+         */
+        [[nodiscard]] auto sign() const -> int {
+            if (comp_.empty()) return 0;
+            return comp_.back() > 0.0 ? 1 : -1;
+        }
+
+        /**
+         * @brief Approximation of the value (the largest component dominates).
+         *
+         * @return double
+         */
+        [[nodiscard]] auto estimate() const -> double {
+            double sum = 0.0;
+            for (const auto val : comp_) sum += val;
+            return sum;
+        }
+
+        [[nodiscard]] auto components() const -> const std::vector<double>& { return comp_; }
+
+        friend auto operator+(const Expansion& lhs, const Expansion& rhs) -> Expansion {
+            auto res = lhs.comp_.size() >= rhs.comp_.size() ? lhs : rhs;
+            const auto& other = lhs.comp_.size() >= rhs.comp_.size() ? rhs : lhs;
+            for (const auto val : other.comp_) {
+                res.grow(val);
+            }
+            return res;
+        }
+
+        auto operator-() const -> Expansion {
+            auto res = *this;
+            for (auto& val : res.comp_) val = -val;
+            return res;
+        }
+
+        friend auto operator-(const Expansion& lhs, const Expansion& rhs) -> Expansion {
+            return lhs + (-rhs);
+        }
+
+        friend auto operator*(const Expansion& lhs, const Expansion& rhs) -> Expansion {
+            Expansion res;
+            for (const auto val : rhs.comp_) {
+                res = res + lhs.scale(val);
+            }
+            return res;
+        }
+
+      private:
+        /// Add a single double (Grow-Expansion with zero elimination).
+        void grow(double val) {
+            std::vector<double> out;
+            out.reserve(comp_.size() + 1);
+            double q = val;
+            for (const auto comp : comp_) {
+                const auto [sum, err] = detail::two_sum(q, comp);
+                if (err != 0.0) out.push_back(err);
+                q = sum;
+            }
+            if (q != 0.0 || out.empty()) out.push_back(q);
+            if (out.size() == 1 && out[0] == 0.0) out.clear();
+            comp_ = std::move(out);
+        }
+
+        /// Multiply by a single double (Scale-Expansion with zero elimination).
+        [[nodiscard]] auto scale(double val) const -> Expansion {
+            Expansion res;
+            if (comp_.empty() || val == 0.0) return res;
+            auto& out = res.comp_;
+            out.reserve(2 * comp_.size());
+            auto [q, err] = detail::two_product(comp_[0], val);
+            if (err != 0.0) out.push_back(err);
+            for (std::size_t i = 1; i < comp_.size(); ++i) {
+                const auto [prod_hi, prod_lo] = detail::two_product(comp_[i], val);
+                const auto [sum, err1] = detail::two_sum(q, prod_lo);
+                if (err1 != 0.0) out.push_back(err1);
+                const auto [q_new, err2] = detail::fast_two_sum(prod_hi, sum);
+                if (err2 != 0.0) out.push_back(err2);
+                q = q_new;
+            }
+            if (q != 0.0 || out.empty()) out.push_back(q);
+            if (out.size() == 1 && out[0] == 0.0) out.clear();
+            return res;
+        }
+
+        std::vector<double> comp_;
+    };
+
+    /**
+     * @brief Double value with a running absolute error bound.
+     *
+     * |exact - val| <= err holds after every operation, where each
+     * rounding contributes at most u |fl(result)|.
+     */
+    struct FilteredDouble {
+        double val{0.0};
+        double err{0.0};
+
+        FilteredDouble() = default;
+
+        /**
+         * @brief Exact input value.
+         *
+         * @param[in] value
+         */
+        explicit FilteredDouble(double value) : val{value} {}
+
+        FilteredDouble(double value, double error) : val{value}, err{error} {}
+
+        friend auto operator+(const FilteredDouble& lhs, const FilteredDouble& rhs)
+            -> FilteredDouble {
+            const double sum = lhs.val + rhs.val;
+            return {sum, lhs.err + rhs.err + detail::unit_roundoff * std::abs(sum)};
+        }
+
+        friend auto operator-(const FilteredDouble& lhs, const FilteredDouble& rhs)
+            -> FilteredDouble {
+            const double diff = lhs.val - rhs.val;
+            return {diff, lhs.err + rhs.err + detail::unit_roundoff * std::abs(diff)};
+        }
+
+        auto operator-() const -> FilteredDouble { return {-val, err}; }
+
+        friend auto operator*(const FilteredDouble& lhs, const FilteredDouble& rhs)
+            -> FilteredDouble {
+            const double prod = lhs.val * rhs.val;
+            return {prod, std::abs(lhs.val) * rhs.err + std::abs(rhs.val) * lhs.err
+                              + lhs.err * rhs.err + detail::unit_roundoff * std::abs(prod)};
+        }
+
+        /**
+         * @brief Sign of the exact value, or 2 if the bound cannot decide it.
+         *
+         * The bound itself is computed in floating point, so it is inflated by
+         * a small safety factor before use.
+         *
+         * @return int -1, +1, or 2 (uncertain)
+         */
+        [[nodiscard]] auto certain_sign() const -> int {
+            const double bound = err * (1.0 + 64.0 * detail::unit_roundoff);
+            if (val > bound) return 1;
+            if (-val > bound) return -1;
+            return 2;
+        }
+    };
+
+    namespace detail {
+
+        template <typename T> auto lift3(const std::array<double, 3>& v_a) -> std::array<T, 3> {
+            return {T(v_a[0]), T(v_a[1]), T(v_a[2])};
+        }
+
+        template <typename T> auto dot3(const std::array<T, 3>& v_a, const std::array<T, 3>& v_b)
+            -> T {
+            return v_a[0] * v_b[0] + v_a[1] * v_b[1] + v_a[2] * v_b[2];
+        }
+
+        template <typename T>
+        auto cross3(const std::array<T, 3>& v_a, const std::array<T, 3>& v_b)
+            -> std::array<T, 3> {
+            return {v_a[1] * v_b[2] - v_a[2] * v_b[1], v_a[2] * v_b[0] - v_a[0] * v_b[2],
+                    v_a[0] * v_b[1] - v_a[1] * v_b[0]};
+        }
+
+        /// Sign of poly(T...) evaluated first with FilteredDouble, then with Expansion.
+        template <typename Poly> auto filtered_sign(Poly&& poly) -> int {
+            const auto approx = poly(FilteredDouble{});
+            const auto sign = approx.certain_sign();
+            if (sign != 2) return sign;
+            return poly(Expansion{}).sign();
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief Exact sign of the dot product of a point and a line.
+     *
+     * @f[
+     *     \operatorname{sign}(p \cdot l)
+     * @f]
+     * @param[in] pt_p
+     * @param[in] ln_l
+     * @return int -1, 0 or +1
+     */
+    inline auto incident_sign(const std::array<double, 3>& pt_p, const std::array<double, 3>& ln_l)
+        -> int {
+        return detail::filtered_sign([&](auto tag) {
+            using T = decltype(tag);
+            return detail::dot3(detail::lift3<T>(pt_p), detail::lift3<T>(ln_l));
+        });
+    }
+
+    /**
+     * @brief Exact sign of the determinant of three homogeneous points.
+     *
+     * @f[
+     *     \operatorname{sign}\det[p, q, r] = \operatorname{sign}((p \times q) \cdot r)
+     * @f]
+     * @param[in] pt_p
+     * @param[in] pt_q
+     * @param[in] pt_r
+     * @return int -1, 0 or +1 (0 iff the points are collinear)
+     */
+    inline auto coincident_sign(const std::array<double, 3>& pt_p,
+                                const std::array<double, 3>& pt_q,
+                                const std::array<double, 3>& pt_r) -> int {
+        return detail::filtered_sign([&](auto tag) {
+            using T = decltype(tag);
+            return detail::dot3(
+                detail::cross3(detail::lift3<T>(pt_p), detail::lift3<T>(pt_q)),
+                detail::lift3<T>(pt_r));
+        });
+    }
+
+    /**
+     * @brief Exact sign of the perspectivity polynomial of two triangles.
+     *
+     * @f[
+     *     \operatorname{sign}\big(((A \times D) \times (B \times E)) \cdot (C \times F)\big)
+     * @f]
+     * @param[in] tri1 triangle ABC
+     * @param[in] tri2 triangle DEF
+     * @return int -1, 0 or +1 (0 iff AD, BE, CF are concurrent)
+     */
+    inline auto persp_sign(const std::array<std::array<double, 3>, 3>& tri1,
+                           const std::array<std::array<double, 3>, 3>& tri2) -> int {
+        return detail::filtered_sign([&](auto tag) {
+            using T = decltype(tag);
+            const auto ln_ad = detail::cross3(detail::lift3<T>(tri1[0]), detail::lift3<T>(tri2[0]));
+            const auto ln_be = detail::cross3(detail::lift3<T>(tri1[1]), detail::lift3<T>(tri2[1]));
+            const auto ln_cf = detail::cross3(detail::lift3<T>(tri1[2]), detail::lift3<T>(tri2[2]));
+            return detail::dot3(detail::cross3(ln_ad, ln_be), ln_cf);
+        });
+    }
+
+    /**
+     * @brief Exact incidence of a point and a line with double coordinates.
+     *
+     * @tparam Point type with a std::array<double, 3> coord member
+     * @tparam Line type with a std::array<double, 3> coord member
+     * @param[in] pt_p
+     * @param[in] ln_l
+     * @return true iff p . l = 0 exactly
+     */
+    template <typename Point, typename Line>
+    auto robust_incident(const Point& pt_p, const Line& ln_l) -> bool {
+        return incident_sign(pt_p.coord, ln_l.coord) == 0;
+    }
+
+    /**
+     * @brief Exact collinearity of three points with double coordinates.
+     *
+     * Robust counterpart of fun::coincident in pg_plane.hpp.
+     * @tparam Point type with a std::array<double, 3> coord member
+     * @param[in] pt_p
+     * @param[in] pt_q
+     * @param[in] pt_r
+     * @return true iff the points are collinear
+     */
+    template <typename Point>
+    auto robust_coincident(const Point& pt_p, const Point& pt_q, const Point& pt_r) -> bool {
+        return coincident_sign(pt_p.coord, pt_q.coord, pt_r.coord) == 0;
+    }
+
+    /**
+     * @brief Exact perspectivity of two triangles with double coordinates.
+     *
+     * Robust counterpart of fun::persp in pg_plane.hpp.
+     * @tparam Point type with a std::array<double, 3> coord member
+     * @param[in] tri1
+     * @param[in] tri2
+     * @return true iff the triangles are perspective from a point
+     */
+    template <typename Point>
+    auto robust_persp(const std::array<Point, 3>& tri1, const std::array<Point, 3>& tri2) -> bool {
+        return persp_sign({tri1[0].coord, tri1[1].coord, tri1[2].coord},
+                          {tri2[0].coord, tri2[1].coord, tri2[2].coord})
+               == 0;
+    }
+
+}  // namespace fun
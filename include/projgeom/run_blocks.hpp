@@ -0,0 +1,65 @@
+/** @file run_blocks.hpp
+ *  @brief Spread the blocks of a batch kernel over worker threads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace fun {
+
+    namespace detail {
+
+        /// The worker count to use for a num_threads argument (0: hardware concurrency).
+        inline auto resolve_threads(std::size_t num_threads) noexcept -> std::size_t {
+            if (num_threads != 0) return num_threads;
+            return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+
+        /**
+         * @brief Run task(block) for every block, spread over worker threads.
+         *
+         * The first exception thrown by a task is rethrown on the calling thread.
+         */
+        template <typename Task>
+        void run_blocks(std::size_t num_blocks, std::size_t num_threads, const Task& task) {
+            num_threads = std::min(resolve_threads(num_threads), num_blocks);
+            if (num_threads <= 1) {
+                for (std::size_t blk = 0; blk < num_blocks; ++blk) task(blk);
+                return;
+            }
+            std::atomic<std::size_t> next_block{0};
+            std::vector<std::exception_ptr> errors(num_threads);
+            auto worker = [&](std::size_t tid) {
+                try {
+                    for (auto blk = next_block.fetch_add(1); blk < num_blocks;
+                         blk = next_block.fetch_add(1)) {
+                        task(blk);
+                    }
+                } catch (...) {
+                    errors[tid] = std::current_exception();
+                    next_block = num_blocks;
+                }
+            };
+            std::vector<std::thread> pool;
+            pool.reserve(num_threads - 1);
+            for (std::size_t t = 1; t < num_threads; ++t) {
+                pool.emplace_back(worker, t);
+            }
+            worker(0);
+            for (auto& thread : pool) {
+                thread.join();
+            }
+            for (const auto& error : errors) {
+                if (error) std::rethrow_exception(error);
+            }
+        }
+
+    }  // namespace detail
+
+}  // namespace fun
@@ -0,0 +1,503 @@
+/** @file simd_kernels.hpp
+ *  @brief SIMD batch cross/dot/matrix/form kernels over column-wise coordinates with runtime
+ *         dispatch.
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "pg_soa.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define PROJGEOM_X86_DISPATCH 1
+#    include <immintrin.h>
+#else
+#    define PROJGEOM_X86_DISPATCH 0
+#endif
+
+namespace fun {
+
+    /**
+     * @brief Instruction set used by the batch kernels.
+     */
+    enum class SimdIsa { Scalar = 0, Avx2 = 1, Avx512 = 2 };
+
+    /**
+     * @brief Check whether the running CPU supports an instruction set.
+     *
+     * @param[in] isa
+     * @return true if the kernels for isa may be called on this machine
+     */
+    inline auto simd_supported(SimdIsa isa) -> bool {
+        switch (isa) {
+            case SimdIsa::Scalar:
+                return true;
+#if PROJGEOM_X86_DISPATCH
+            case SimdIsa::Avx2:
+                return __builtin_cpu_supports("avx2") != 0;
+            case SimdIsa::Avx512:
+                return __builtin_cpu_supports("avx512f") != 0
+                       && __builtin_cpu_supports("avx512dq") != 0;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Best instruction set available on this machine (detected once).
+     *
+     * @return SimdIsa
+     */
+    inline auto detect_simd_isa() -> SimdIsa {
+        static const SimdIsa best = simd_supported(SimdIsa::Avx512) ? SimdIsa::Avx512
+                                    : simd_supported(SimdIsa::Avx2) ? SimdIsa::Avx2
+                                                                    : SimdIsa::Scalar;
+        return best;
+    }
+
+    /// Integer 3×3 matrix, row-major.
+    using Mat3Int = std::array<std::array<std::int64_t, 3>, 3>;
+
+    namespace detail {
+
+        inline void cross_batch_scalar(CoordView lhs, CoordView rhs, CoordSpan out,
+                                       std::size_t first) {
+            for (std::size_t i = first; i < lhs.size(); ++i) {
+                const auto cx = lhs.y[i] * rhs.z[i] - lhs.z[i] * rhs.y[i];
+                const auto cy = lhs.z[i] * rhs.x[i] - lhs.x[i] * rhs.z[i];
+                const auto cz = lhs.x[i] * rhs.y[i] - lhs.y[i] * rhs.x[i];
+                out.x[i] = cx;
+                out.y[i] = cy;
+                out.z[i] = cz;
+            }
+        }
+
+        inline void dot_batch_scalar(CoordView lhs, CoordView rhs, std::span<std::int64_t> out,
+                                     std::size_t first) {
+            for (std::size_t i = first; i < lhs.size(); ++i) {
+                out[i] = lhs.x[i] * rhs.x[i] + lhs.y[i] * rhs.y[i] + lhs.z[i] * rhs.z[i];
+            }
+        }
+
+        inline void mat3_batch_scalar(const Mat3Int& mat, CoordView vecs, CoordSpan out,
+                                      std::size_t first) {
+            for (std::size_t i = first; i < vecs.size(); ++i) {
+                const auto vx = vecs.x[i];
+                const auto vy = vecs.y[i];
+                const auto vz = vecs.z[i];
+                out.x[i] = mat[0][0] * vx + mat[0][1] * vy + mat[0][2] * vz;
+                out.y[i] = mat[1][0] * vx + mat[1][1] * vy + mat[1][2] * vz;
+                out.z[i] = mat[2][0] * vx + mat[2][1] * vy + mat[2][2] * vz;
+            }
+        }
+
+        inline void form_sign_batch_scalar(const Mat3Int& sym, CoordView vecs,
+                                           std::span<std::int8_t> out, std::size_t first) {
+            for (std::size_t i = first; i < vecs.size(); ++i) {
+                const auto vx = vecs.x[i];
+                const auto vy = vecs.y[i];
+                const auto vz = vecs.z[i];
+                const auto val = vx * (sym[0][0] * vx + 2 * (sym[0][1] * vy + sym[0][2] * vz))
+                                 + vy * (sym[1][1] * vy + 2 * sym[1][2] * vz)
+                                 + vz * (sym[2][2] * vz);
+                out[i] = static_cast<std::int8_t>((val > 0) - (val < 0));
+            }
+        }
+
+#if PROJGEOM_X86_DISPATCH
+        /**
+         * @brief Low 64 bits of a 64x64-bit product (AVX2 has no vpmullq).
+         */
+        __attribute__((target("avx2"))) inline auto mullo_epi64_avx2(__m256i a, __m256i b)
+            -> __m256i {
+            const auto lo = _mm256_mul_epu32(a, b);
+            const auto hi_lo = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);
+            const auto lo_hi = _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32));
+            return _mm256_add_epi64(lo, _mm256_slli_epi64(_mm256_add_epi64(hi_lo, lo_hi), 32));
+        }
+
+        __attribute__((target("avx2"))) inline auto load_avx2(const std::int64_t* ptr)
+            -> __m256i {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        __attribute__((target("avx2"))) inline void store_avx2(std::int64_t* ptr, __m256i val) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), val);
+        }
+
+        __attribute__((target("avx2"))) inline void cross_batch_avx2(CoordView lhs, CoordView rhs,
+                                                                     CoordSpan out) {
+            const auto n = lhs.size();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const auto ax = load_avx2(&lhs.x[i]);
+                const auto ay = load_avx2(&lhs.y[i]);
+                const auto az = load_avx2(&lhs.z[i]);
+                const auto bx = load_avx2(&rhs.x[i]);
+                const auto by = load_avx2(&rhs.y[i]);
+                const auto bz = load_avx2(&rhs.z[i]);
+                store_avx2(&out.x[i], _mm256_sub_epi64(mullo_epi64_avx2(ay, bz),
+                                                       mullo_epi64_avx2(az, by)));
+                store_avx2(&out.y[i], _mm256_sub_epi64(mullo_epi64_avx2(az, bx),
+                                                       mullo_epi64_avx2(ax, bz)));
+                store_avx2(&out.z[i], _mm256_sub_epi64(mullo_epi64_avx2(ax, by),
+                                                       mullo_epi64_avx2(ay, bx)));
+            }
+            cross_batch_scalar(lhs, rhs, out, i);
+        }
+
+        __attribute__((target("avx2"))) inline void dot_batch_avx2(CoordView lhs, CoordView rhs,
+                                                                   std::span<std::int64_t> out) {
+            const auto n = lhs.size();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const auto xx = mullo_epi64_avx2(load_avx2(&lhs.x[i]), load_avx2(&rhs.x[i]));
+                const auto yy = mullo_epi64_avx2(load_avx2(&lhs.y[i]), load_avx2(&rhs.y[i]));
+                const auto zz = mullo_epi64_avx2(load_avx2(&lhs.z[i]), load_avx2(&rhs.z[i]));
+                store_avx2(&out[i], _mm256_add_epi64(_mm256_add_epi64(xx, yy), zz));
+            }
+            dot_batch_scalar(lhs, rhs, out, i);
+        }
+
+        __attribute__((target("avx2"))) inline void mat3_batch_avx2(const Mat3Int& mat,
+                                                                    CoordView vecs,
+                                                                    CoordSpan out) {
+            __m256i coef[3][3];  // NOLINT: std::array drops the vector type's alignment attribute
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t c = 0; c < 3; ++c) coef[r][c] = _mm256_set1_epi64x(mat[r][c]);
+            }
+            const auto n = vecs.size();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const auto vx = load_avx2(&vecs.x[i]);
+                const auto vy = load_avx2(&vecs.y[i]);
+                const auto vz = load_avx2(&vecs.z[i]);
+                __m256i res[3];  // NOLINT
+                for (std::size_t r = 0; r < 3; ++r) {
+                    res[r] = _mm256_add_epi64(
+                        _mm256_add_epi64(mullo_epi64_avx2(coef[r][0], vx),
+                                         mullo_epi64_avx2(coef[r][1], vy)),
+                        mullo_epi64_avx2(coef[r][2], vz));
+                }
+                store_avx2(&out.x[i], res[0]);
+                store_avx2(&out.y[i], res[1]);
+                store_avx2(&out.z[i], res[2]);
+            }
+            mat3_batch_scalar(mat, vecs, out, i);
+        }
+
+        __attribute__((target("avx2"))) inline void form_sign_batch_avx2(
+            const Mat3Int& sym, CoordView vecs, std::span<std::int8_t> out) {
+            const auto caa = _mm256_set1_epi64x(sym[0][0]);
+            const auto cab = _mm256_set1_epi64x(sym[0][1]);
+            const auto cac = _mm256_set1_epi64x(sym[0][2]);
+            const auto cbb = _mm256_set1_epi64x(sym[1][1]);
+            const auto cbc = _mm256_set1_epi64x(sym[1][2]);
+            const auto ccc = _mm256_set1_epi64x(sym[2][2]);
+            const auto zero = _mm256_setzero_si256();
+            const auto n = vecs.size();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const auto vx = load_avx2(&vecs.x[i]);
+                const auto vy = load_avx2(&vecs.y[i]);
+                const auto vz = load_avx2(&vecs.z[i]);
+                // x (a x + 2 (b y + d z)) + y (c y + 2 e z) + f z^2
+                const auto cross_x = _mm256_add_epi64(mullo_epi64_avx2(cab, vy),
+                                                      mullo_epi64_avx2(cac, vz));
+                const auto row_x = _mm256_add_epi64(mullo_epi64_avx2(caa, vx),
+                                                    _mm256_add_epi64(cross_x, cross_x));
+                const auto cross_y = mullo_epi64_avx2(cbc, vz);
+                const auto row_y = _mm256_add_epi64(mullo_epi64_avx2(cbb, vy),
+                                                    _mm256_add_epi64(cross_y, cross_y));
+                const auto val = _mm256_add_epi64(
+                    _mm256_add_epi64(mullo_epi64_avx2(vx, row_x), mullo_epi64_avx2(vy, row_y)),
+                    mullo_epi64_avx2(vz, mullo_epi64_avx2(ccc, vz)));
+                // the all-ones masks are -(val < 0) and -(val > 0)
+                const auto sign = _mm256_sub_epi64(_mm256_cmpgt_epi64(zero, val),
+                                                   _mm256_cmpgt_epi64(val, zero));
+                alignas(32) std::int64_t lanes[4];  // NOLINT
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sign);
+                for (std::size_t k = 0; k < 4; ++k) out[i + k] = static_cast<std::int8_t>(lanes[k]);
+            }
+            form_sign_batch_scalar(sym, vecs, out, i);
+        }
+
+        __attribute__((target("avx512f,avx512dq"))) inline void cross_batch_avx512(
+            CoordView lhs, CoordView rhs, CoordSpan out) {
+            const auto n = lhs.size();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto ax = _mm512_loadu_si512(&lhs.x[i]);
+                const auto ay = _mm512_loadu_si512(&lhs.y[i]);
+                const auto az = _mm512_loadu_si512(&lhs.z[i]);
+                const auto bx = _mm512_loadu_si512(&rhs.x[i]);
+                const auto by = _mm512_loadu_si512(&rhs.y[i]);
+                const auto bz = _mm512_loadu_si512(&rhs.z[i]);
+                _mm512_storeu_si512(&out.x[i], _mm512_sub_epi64(_mm512_mullo_epi64(ay, bz),
+                                                                _mm512_mullo_epi64(az, by)));
+                _mm512_storeu_si512(&out.y[i], _mm512_sub_epi64(_mm512_mullo_epi64(az, bx),
+                                                                _mm512_mullo_epi64(ax, bz)));
+                _mm512_storeu_si512(&out.z[i], _mm512_sub_epi64(_mm512_mullo_epi64(ax, by),
+                                                                _mm512_mullo_epi64(ay, bx)));
+            }
+            cross_batch_scalar(lhs, rhs, out, i);
+        }
+
+        __attribute__((target("avx512f,avx512dq"))) inline void dot_batch_avx512(
+            CoordView lhs, CoordView rhs, std::span<std::int64_t> out) {
+            const auto n = lhs.size();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto xx = _mm512_mullo_epi64(_mm512_loadu_si512(&lhs.x[i]),
+                                                   _mm512_loadu_si512(&rhs.x[i]));
+                const auto yy = _mm512_mullo_epi64(_mm512_loadu_si512(&lhs.y[i]),
+                                                   _mm512_loadu_si512(&rhs.y[i]));
+                const auto zz = _mm512_mullo_epi64(_mm512_loadu_si512(&lhs.z[i]),
+                                                   _mm512_loadu_si512(&rhs.z[i]));
+                _mm512_storeu_si512(&out[i], _mm512_add_epi64(_mm512_add_epi64(xx, yy), zz));
+            }
+            dot_batch_scalar(lhs, rhs, out, i);
+        }
+
+        __attribute__((target("avx512f,avx512dq"))) inline void mat3_batch_avx512(
+            const Mat3Int& mat, CoordView vecs, CoordSpan out) {
+            __m512i coef[3][3];  // NOLINT: std::array drops the vector type's alignment attribute
+            for (std::size_t r = 0; r < 3; ++r) {
+                for (std::size_t c = 0; c < 3; ++c) coef[r][c] = _mm512_set1_epi64(mat[r][c]);
+            }
+            const auto n = vecs.size();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto vx = _mm512_loadu_si512(&vecs.x[i]);
+                const auto vy = _mm512_loadu_si512(&vecs.y[i]);
+                const auto vz = _mm512_loadu_si512(&vecs.z[i]);
+                __m512i res[3];  // NOLINT
+                for (std::size_t r = 0; r < 3; ++r) {
+                    res[r] = _mm512_add_epi64(
+                        _mm512_add_epi64(_mm512_mullo_epi64(coef[r][0], vx),
+                                         _mm512_mullo_epi64(coef[r][1], vy)),
+                        _mm512_mullo_epi64(coef[r][2], vz));
+                }
+                _mm512_storeu_si512(&out.x[i], res[0]);
+                _mm512_storeu_si512(&out.y[i], res[1]);
+                _mm512_storeu_si512(&out.z[i], res[2]);
+            }
+            mat3_batch_scalar(mat, vecs, out, i);
+        }
+
+        __attribute__((target("avx512f,avx512dq"))) inline void form_sign_batch_avx512(
+            const Mat3Int& sym, CoordView vecs, std::span<std::int8_t> out) {
+            const auto caa = _mm512_set1_epi64(sym[0][0]);
+            const auto cab = _mm512_set1_epi64(sym[0][1]);
+            const auto cac = _mm512_set1_epi64(sym[0][2]);
+            const auto cbb = _mm512_set1_epi64(sym[1][1]);
+            const auto cbc = _mm512_set1_epi64(sym[1][2]);
+            const auto ccc = _mm512_set1_epi64(sym[2][2]);
+            const auto zero = _mm512_setzero_si512();
+            const auto plus = _mm512_set1_epi64(1);
+            const auto minus = _mm512_set1_epi64(-1);
+            const auto n = vecs.size();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const auto vx = _mm512_loadu_si512(&vecs.x[i]);
+                const auto vy = _mm512_loadu_si512(&vecs.y[i]);
+                const auto vz = _mm512_loadu_si512(&vecs.z[i]);
+                const auto cross_x = _mm512_add_epi64(_mm512_mullo_epi64(cab, vy),
+                                                      _mm512_mullo_epi64(cac, vz));
+                const auto row_x = _mm512_add_epi64(_mm512_mullo_epi64(caa, vx),
+                                                    _mm512_add_epi64(cross_x, cross_x));
+                const auto cross_y = _mm512_mullo_epi64(cbc, vz);
+                const auto row_y = _mm512_add_epi64(_mm512_mullo_epi64(cbb, vy),
+                                                    _mm512_add_epi64(cross_y, cross_y));
+                const auto val = _mm512_add_epi64(
+                    _mm512_add_epi64(_mm512_mullo_epi64(vx, row_x), _mm512_mullo_epi64(vy, row_y)),
+                    _mm512_mullo_epi64(vz, _mm512_mullo_epi64(ccc, vz)));
+                auto sign = _mm512_mask_mov_epi64(zero, _mm512_cmpgt_epi64_mask(val, zero), plus);
+                sign = _mm512_mask_mov_epi64(sign, _mm512_cmplt_epi64_mask(val, zero), minus);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(&out[i]),
+                                 _mm512_maskz_cvtepi64_epi8(0xFF, sign));
+            }
+            form_sign_batch_scalar(sym, vecs, out, i);
+        }
+#endif
+
+    }  // namespace detail
+
+    /**
+     * @brief Batched cross product with an explicit instruction set.
+     *
+     * @f[
+     *     o_i = a_i \times b_i
+     * @f]
+     * The caller must make sure that simd_supported(isa) holds.
+     * Products wrap modulo \f$2^{64}\f$ exactly like the scalar ::cross.
+     *
+     * @param[in] isa
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void cross_batch(SimdIsa isa, CoordView lhs, CoordView rhs, CoordSpan out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        switch (isa) {
+#if PROJGEOM_X86_DISPATCH
+            case SimdIsa::Avx512:
+                detail::cross_batch_avx512(lhs, rhs, out);
+                return;
+            case SimdIsa::Avx2:
+                detail::cross_batch_avx2(lhs, rhs, out);
+                return;
+#endif
+            default:
+                detail::cross_batch_scalar(lhs, rhs, out, 0);
+                return;
+        }
+    }
+
+    /**
+     * @brief Batched dot product with an explicit instruction set.
+     *
+     * @f[
+     *     o_i = a_i \cdot b_i
+     * @f]
+     * The caller must make sure that simd_supported(isa) holds.
+     *
+     * @param[in] isa
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void dot_batch(SimdIsa isa, CoordView lhs, CoordView rhs,
+                          std::span<std::int64_t> out) {
+        assert(lhs.size() == rhs.size() && out.size() == lhs.size());
+        switch (isa) {
+#if PROJGEOM_X86_DISPATCH
+            case SimdIsa::Avx512:
+                detail::dot_batch_avx512(lhs, rhs, out);
+                return;
+            case SimdIsa::Avx2:
+                detail::dot_batch_avx2(lhs, rhs, out);
+                return;
+#endif
+            default:
+                detail::dot_batch_scalar(lhs, rhs, out, 0);
+                return;
+        }
+    }
+
+    /**
+     * @brief Batched matrix-vector product with an explicit instruction set.
+     *
+     * @f[
+     *     o_i = M v_i
+     * @f]
+     * The caller must make sure that simd_supported(isa) holds. Products
+     * wrap modulo \f$2^{64}\f$; out may be the same buffer as vecs.
+     *
+     * @param[in] isa
+     * @param[in] mat
+     * @param[in] vecs
+     * @param[out] out must have the same size as vecs
+     */
+    inline void mat3_batch(SimdIsa isa, const Mat3Int& mat, CoordView vecs, CoordSpan out) {
+        assert(out.size() == vecs.size());
+        switch (isa) {
+#if PROJGEOM_X86_DISPATCH
+            case SimdIsa::Avx512:
+                detail::mat3_batch_avx512(mat, vecs, out);
+                return;
+            case SimdIsa::Avx2:
+                detail::mat3_batch_avx2(mat, vecs, out);
+                return;
+#endif
+            default:
+                detail::mat3_batch_scalar(mat, vecs, out, 0);
+                return;
+        }
+    }
+
+    /**
+     * @brief Batched sign of a quadratic form with an explicit instruction set.
+     *
+     * @f[
+     *     o_i = \operatorname{sgn}(v_i^T S v_i)
+     * @f]
+     * S must be symmetric; only its upper triangle is read. The caller must
+     * make sure that simd_supported(isa) holds. Products wrap modulo
+     * \f$2^{64}\f$, so the caller must bound the magnitudes: the result is
+     * exact if \f$|S_{jk}| < 2^a\f$, \f$|v_{ij}| < 2^b\f$ and a + 2b + 4 <= 63.
+     *
+     * @param[in] isa
+     * @param[in] sym
+     * @param[in] vecs
+     * @param[out] out must have the same size as vecs
+     */
+    inline void form_sign_batch(SimdIsa isa, const Mat3Int& sym, CoordView vecs,
+                                std::span<std::int8_t> out) {
+        assert(out.size() == vecs.size());
+        switch (isa) {
+#if PROJGEOM_X86_DISPATCH
+            case SimdIsa::Avx512:
+                detail::form_sign_batch_avx512(sym, vecs, out);
+                return;
+            case SimdIsa::Avx2:
+                detail::form_sign_batch_avx2(sym, vecs, out);
+                return;
+#endif
+            default:
+                detail::form_sign_batch_scalar(sym, vecs, out, 0);
+                return;
+        }
+    }
+
+    /**
+     * @brief Batched cross product using the best instruction set of this CPU.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void cross_batch(CoordView lhs, CoordView rhs, CoordSpan out) {
+        cross_batch(detect_simd_isa(), lhs, rhs, out);
+    }
+
+    /**
+     * @brief Batched dot product using the best instruction set of this CPU.
+     *
+     * @param[in] lhs
+     * @param[in] rhs
+     * @param[out] out must have the same size as lhs
+     */
+    inline void dot_batch(CoordView lhs, CoordView rhs, std::span<std::int64_t> out) {
+        dot_batch(detect_simd_isa(), lhs, rhs, out);
+    }
+
+    /**
+     * @brief Batched matrix-vector product using the best instruction set of this CPU.
+     *
+     * @param[in] mat
+     * @param[in] vecs
+     * @param[out] out must have the same size as vecs
+     */
+    inline void mat3_batch(const Mat3Int& mat, CoordView vecs, CoordSpan out) {
+        mat3_batch(detect_simd_isa(), mat, vecs, out);
+    }
+
+    /**
+     * @brief Batched sign of a quadratic form using the best instruction set of this CPU.
+     *
+     * @param[in] sym
+     * @param[in] vecs
+     * @param[out] out must have the same size as vecs
+     */
+    inline void form_sign_batch(const Mat3Int& sym, CoordView vecs, std::span<std::int8_t> out) {
+        form_sign_batch(detect_simd_isa(), sym, vecs, out);
+    }
+
+}  // namespace fun
@@ -0,0 +1,319 @@
+/** @file small_fraction.hpp
+ *  @brief Rational number stored inline as int64 that promotes to BigInt on overflow.
+ *
+ *  Most quadrances, spreads and measures of a run are small, but a few grow
+ *  beyond 64 bits. SmallFraction keeps its numerator and denominator inline
+ *  as int64_t while they fit; an operation whose exact result does not fit
+ *  moves the value transparently to a Fraction<BigInt> (limbs from the
+ *  per-thread arena). A big result that fits again is demoted, so one large
+ *  intermediate does not slow down the rest of a computation.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <utility>
+
+#include "big_int.hpp"
+#include "binary_gcd.hpp"
+#include "fractions.hpp"
+#include "int128.hpp"
+#include "limb_arena.hpp"
+
+namespace fun {
+
+    /**
+     * @brief Exact rational with an inline int64 representation and a BigInt fallback.
+     *
+     * Canonical form in both representations: lowest terms, positive
+     * denominator (the denominator must never be zero).
+     */
+    class SmallFraction {
+        using Big = Fraction<BigInt>;
+
+        /// Destroys a Big node and returns its storage to the arena.
+        struct BigDeleter {
+            void operator()(Big* ptr) const noexcept {
+                ptr->~Big();
+                arena_deallocate(ptr, sizeof(Big));
+            }
+        };
+
+        std::int64_t num_{0};
+        std::int64_t den_{1};
+        std::unique_ptr<Big, BigDeleter> big_;
+
+        static auto make_big(Big&& val) -> std::unique_ptr<Big, BigDeleter> {
+            void* mem = arena_allocate(sizeof(Big));
+            return std::unique_ptr<Big, BigDeleter>(::new (mem) Big(std::move(val)));
+        }
+
+        /// Demote to the inline form if the value fits.
+        void assign_big(Big&& val) {
+            if (val.num().fits_int64() && val.den().fits_int64()) {
+                num_ = val.num().to_int64();
+                den_ = val.den().to_int64();
+                big_.reset();
+                return;
+            }
+            if (big_) {
+                *big_ = std::move(val);
+            } else {
+                big_ = make_big(std::move(val));
+            }
+        }
+
+        /// Store an already reduced small value.
+        void assign_small(std::int64_t num, std::int64_t den) noexcept {
+            num_ = num;
+            den_ = den;
+            big_.reset();
+        }
+
+        [[nodiscard]] auto to_big() const -> Big {
+            if (big_) return *big_;
+            Big res;
+            res._num = BigInt(num_);
+            res._den = BigInt(den_);
+            return res;
+        }
+
+        static auto gcd64(std::int64_t lhs, std::int64_t rhs) noexcept -> std::int64_t {
+            return static_cast<std::int64_t>(binary_gcd(magnitude(lhs), magnitude(rhs)));
+        }
+
+        /// a/b + c/d on the inline form (Knuth 4.5.1); false if an intermediate overflows.
+        static auto add_small(std::int64_t a_num, std::int64_t b_den, std::int64_t c_num,
+                              std::int64_t d_den, std::int64_t& out_num, std::int64_t& out_den)
+            -> bool {
+            const auto common = gcd64(b_den, d_den);
+            const auto b_part = b_den / common;
+            const auto d_part = d_den / common;
+            std::int64_t lhs = 0;
+            std::int64_t rhs = 0;
+            std::int64_t num = 0;
+            if (mul_overflow(a_num, d_part, lhs) || mul_overflow(c_num, b_part, rhs)
+                || add_overflow(lhs, rhs, num)) {
+                return false;
+            }
+            if (num == 0) {
+                out_num = 0;
+                out_den = 1;
+                return true;
+            }
+            const auto common2 = gcd64(num, common);
+            out_num = num / common2;
+            return !mul_overflow(b_part, d_den / common2, out_den);
+        }
+
+        /// (a/b)(c/d) on the inline form; false if the product overflows.
+        static auto mul_small(std::int64_t a_num, std::int64_t b_den, std::int64_t c_num,
+                              std::int64_t d_den, std::int64_t& out_num, std::int64_t& out_den)
+            -> bool {
+            const auto common_ad = gcd64(a_num, d_den);
+            const auto common_cb = gcd64(c_num, b_den);
+            return !mul_overflow(a_num / common_ad, c_num / common_cb, out_num)
+                   && !mul_overflow(b_den / common_cb, d_den / common_ad, out_den);
+        }
+
+      public:
+        /**
+         * @brief Zero.
+         */
+        SmallFraction() noexcept = default;
+
+        /**
+         * @brief Construct an integer value.
+         *
+         * @param[in] num
+         */
+        explicit SmallFraction(std::int64_t num) noexcept : num_{num} {}
+
+        /**
+         * @brief Construct num / den in lowest terms.
+         *
+         * @param[in] num
+         * @param[in] den nonzero
+         */
+        SmallFraction(std::int64_t num, std::int64_t den) {
+            if (den < 0 && (num == INT64_MIN || den == INT64_MIN)) {
+                this->assign_big(Big(BigInt(num), BigInt(den)));
+                return;
+            }
+            const Fraction<std::int64_t> frac(num, den);
+            num_ = frac.num();
+            den_ = frac.den();
+        }
+
+        /**
+         * @brief Construct from an arbitrary-precision fraction.
+         *
+         * @param[in] frac
+         */
+        explicit SmallFraction(Fraction<BigInt> frac) { this->assign_big(std::move(frac)); }
+
+        SmallFraction(const SmallFraction& other)
+            : num_{other.num_}, den_{other.den_}, big_{other.big_ ? make_big(Big(*other.big_))
+                                                                  : nullptr} {}
+
+        SmallFraction(SmallFraction&& other) noexcept = default;
+
+        auto operator=(const SmallFraction& other) -> SmallFraction& {
+            if (this != &other) {
+                num_ = other.num_;
+                den_ = other.den_;
+                if (other.big_) {
+                    this->assign_big(Big(*other.big_));
+                } else {
+                    big_.reset();
+                }
+            }
+            return *this;
+        }
+
+        auto operator=(SmallFraction&& other) noexcept -> SmallFraction& = default;
+
+        ~SmallFraction() = default;
+
+        /**
+         * @brief Is the value held inline as int64?
+         *
+         * @return bool
+         */
+        [[nodiscard]] auto is_small() const noexcept -> bool { return !big_; }
+
+        /**
+         * @brief Numerator in lowest terms.
+         *
+         * @return BigInt
+         */
+        [[nodiscard]] auto num() const -> BigInt { return big_ ? big_->num() : BigInt(num_); }
+
+        /**
+         * @brief Denominator in lowest terms (positive).
+         *
+         * @return BigInt
+         */
+        [[nodiscard]] auto den() const -> BigInt { return big_ ? big_->den() : BigInt(den_); }
+
+        /**
+         * @brief The value as an arbitrary-precision fraction.
+         *
+         * @return Fraction<BigInt>
+         */
+        [[nodiscard]] auto to_fraction() const -> Fraction<BigInt> { return this->to_big(); }
+
+        explicit operator double() const {
+            if (!big_) return static_cast<double>(num_) / static_cast<double>(den_);
+            return static_cast<double>(big_->num()) / static_cast<double>(big_->den());
+        }
+
+        // ---- comparison ------------------------------------------------------
+
+        friend auto operator==(const SmallFraction& lhs, const SmallFraction& rhs) -> bool {
+            // both sides are canonical, and a big value never fits into int64
+            if (!lhs.big_ && !rhs.big_) return lhs.num_ == rhs.num_ && lhs.den_ == rhs.den_;
+            if (!lhs.big_ || !rhs.big_) return false;
+            return lhs.big_->num() == rhs.big_->num() && lhs.big_->den() == rhs.big_->den();
+        }
+
+        friend auto operator<=>(const SmallFraction& lhs, const SmallFraction& rhs)
+            -> std::strong_ordering {
+#if PROJGEOM_HAS_INT128
+            if (!lhs.big_ && !rhs.big_) {
+                return int128_t(lhs.num_) * rhs.den_ <=> int128_t(rhs.num_) * lhs.den_;
+            }
+#endif
+            const auto lhs_big = lhs.to_big();
+            const auto rhs_big = rhs.to_big();
+            return lhs_big.num() * rhs_big.den() <=> rhs_big.num() * lhs_big.den();
+        }
+
+        // ---- arithmetic ------------------------------------------------------
+
+        auto operator-() const -> SmallFraction {
+            if (!big_ && num_ != INT64_MIN) {
+                SmallFraction res;
+                res.num_ = -num_;
+                res.den_ = den_;
+                return res;
+            }
+            return SmallFraction(-this->to_big());
+        }
+
+        auto operator+=(const SmallFraction& rhs) -> SmallFraction& {
+            std::int64_t num = 0;
+            std::int64_t den = 0;
+            if (!big_ && !rhs.big_ && add_small(num_, den_, rhs.num_, rhs.den_, num, den)) {
+                this->assign_small(num, den);
+                return *this;
+            }
+            this->assign_big(this->to_big() + rhs.to_big());
+            return *this;
+        }
+
+        auto operator-=(const SmallFraction& rhs) -> SmallFraction& { return *this += -rhs; }
+
+        auto operator*=(const SmallFraction& rhs) -> SmallFraction& {
+            std::int64_t num = 0;
+            std::int64_t den = 0;
+            if (!big_ && !rhs.big_ && mul_small(num_, den_, rhs.num_, rhs.den_, num, den)) {
+                this->assign_small(num, den);
+                return *this;
+            }
+            this->assign_big(this->to_big() * rhs.to_big());
+            return *this;
+        }
+
+        /**
+         * @brief Divide and assign.
+         *
+         * @throws std::domain_error if rhs is zero
+         */
+        auto operator/=(const SmallFraction& rhs) -> SmallFraction& {
+            if (rhs.is_small() && rhs.num_ == 0) {
+                throw std::domain_error{"SmallFraction: division by zero"};
+            }
+            // multiply by the reciprocal, keeping the denominator positive
+            SmallFraction inv;
+            if (!rhs.big_ && rhs.num_ != INT64_MIN) {
+                inv.num_ = rhs.num_ < 0 ? -rhs.den_ : rhs.den_;
+                inv.den_ = rhs.num_ < 0 ? -rhs.num_ : rhs.num_;
+            } else {
+                auto big = rhs.to_big();
+                big.reciprocal();
+                inv.assign_big(std::move(big));
+            }
+            return *this *= inv;
+        }
+
+        friend auto operator+(SmallFraction lhs, const SmallFraction& rhs) -> SmallFraction {
+            return lhs += rhs;
+        }
+
+        friend auto operator-(SmallFraction lhs, const SmallFraction& rhs) -> SmallFraction {
+            return lhs -= rhs;
+        }
+
+        friend auto operator*(SmallFraction lhs, const SmallFraction& rhs) -> SmallFraction {
+            return lhs *= rhs;
+        }
+
+        friend auto operator/(SmallFraction lhs, const SmallFraction& rhs) -> SmallFraction {
+            return lhs /= rhs;
+        }
+
+        /**
+         * @brief Output in the same format as Fraction.
+         */
+        friend auto operator<<(std::ostream& os, const SmallFraction& frac) -> std::ostream& {
+            if (frac.big_) return os << *frac.big_;
+            return os << "(" << frac.num_ << "/" << frac.den_ << ")";
+        }
+    };
+
+}  // namespace fun
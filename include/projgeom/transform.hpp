@@ -4,30 +4,93 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
+#include "binary_gcd.hpp"
 #include "fractions.hpp"
+#include "int128.hpp"
 #include "pg_object.hpp"
+#include "pg_soa.hpp"
+#include "run_blocks.hpp"
+#include "simd_kernels.hpp"
 
 namespace fun {
 
+    namespace detail {
+
+        /// Points per block of the batch kernels; blocks are the unit of work of a thread.
+        constexpr std::size_t transform_block = 256;
+
+    }  // namespace detail
+
+    /**
+     * @brief Structure of a transformation matrix A, from the cheapest kernels to the most general.
+     *
+     * Identity: A = I. Translation: A = [cI t; 0 c] with t != 0. Diagonal: A is
+     * diagonal. Affine: last row (0, 0, c). Projective: anything else.
+     */
+    enum class TransformKind { Identity, Translation, Diagonal, Affine, Projective };
+
     /**
      * @brief A 3×3 projective transformation matrix.
      *
      * Operates on homogeneous coordinates \f$(x:y:z)\f$.
      * Supports translation, rotation, scaling, shear, composition, and inverse.
+     *
+     * The matrix is stored as M = A / d with an integer matrix A and a single
+     * positive common denominator d, in lowest terms. Since homogeneous
+     * coordinates are scale-invariant, points map by A alone, and
+     * apply_point, compose and inverse are int64 arithmetic with 128-bit
+     * intermediates; results that do not fit into int64_t throw
+     * std::overflow_error rather than being truncated.
+     *
+     * A Transform also keeps a multiple of its adjugate adj(A), fixed at
+     * construction. Lines map by the inverse transpose, and
+     * @f[
+     *     M^{-T} l \sim \operatorname{adj}(A)^T l,
+     * @f]
+     * so apply_line needs neither a determinant nor a division.
+     *
+     * apply_points maps whole buffers. A block of points whose coordinates
+     * are small enough that no product or sum can leave int64 goes through
+     * the SIMD kernel mat3_batch; other blocks take the exact per-point path.
+     *
+     * The kind of A (see TransformKind) is fixed at construction, and
+     * apply_point, apply_line, compose, inverse and the adjugate skip the
+     * entries that are known to be zero, with the same exact results as the
+     * general formulas.
      */
     class Transform {
       public:
-        using Mat3x3 = std::array<std::array<Fraction, 3>, 3>;
+        using Rational = Fraction<std::int64_t>;
+        using Mat3x3 = std::array<std::array<Rational, 3>, 3>;
+        using IntMat3x3 = Mat3Int;
+        using WideMat3x3 = std::array<std::array<detail::int_wide, 3>, 3>;
 
         /**
          * @brief Construct a new Transform from a matrix.
          * @param[in] matrix  The 3×3 matrix.
+         * @throws std::overflow_error if the common denominator does not fit into int64_t.
+         */
+        constexpr explicit Transform(const Mat3x3& matrix) : Transform{from_rational(matrix)} {}
+
+        /**
+         * @brief Construct the transform M = matrix / den.
+         * @param[in] matrix  Integer matrix.
+         * @param[in] den     Common denominator (nonzero).
+         * @throws std::domain_error if den is zero.
          */
-        constexpr explicit Transform(Mat3x3 matrix) : matrix_{std::move(matrix)} {}
+        constexpr explicit Transform(const IntMat3x3& matrix, std::int64_t den = 1)
+            : Transform{from_integer(matrix, den)} {}
 
         // ---- factory methods ------------------------------------------------
 
@@ -38,8 +101,7 @@ namespace fun {
          * @return constexpr Transform
          */
         static constexpr auto identity() -> Transform {
-            const Fraction Z{0, 1}, O{1, 1};
-            return Transform{Mat3x3{{{{O, Z, Z}}, {{Z, O, Z}}, {{Z, Z, O}}}}};
+            return Transform{IntMat3x3{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}}};
         }
 
         /**
@@ -53,10 +115,7 @@ namespace fun {
          * @return constexpr Transform
          */
         static constexpr auto translation(std::int64_t tx, std::int64_t ty) -> Transform {
-            const Fraction Z{0, 1}, O{1, 1};
-            return Transform{Mat3x3{{{{O, Z, Fraction{tx, 1}}},
-                                                      {{Z, O, Fraction{ty, 1}}},
-                                                      {{Z, Z, O}}}}};
+            return Transform{IntMat3x3{{{1, 0, tx}, {0, 1, ty}, {0, 0, 1}}}};
         }
 
         /**
@@ -69,15 +128,16 @@ namespace fun {
          *         0 & 0 & 1
          *     \end{bmatrix}
          *  \f]
-         * @param[in] cos_a  Cosine of the angle.
-         * @param[in] sin_a  Sine of the angle.
+         * @param[in] angle_cos  Cosine of the angle.
+         * @param[in] angle_sin  Sine of the angle.
          * @return constexpr Transform
          */
-        static constexpr auto rotation(const Fraction& angle_cos, const Fraction& angle_sin) -> Transform {
-            const Fraction Z{0, 1};
+        static constexpr auto rotation(const Rational& angle_cos, const Rational& angle_sin)
+            -> Transform {
+            const Rational Z{0, 1}, O{1, 1};
             return Transform{Mat3x3{{{{angle_cos, -angle_sin, Z}},
-                                                      {{angle_sin, angle_cos, Z}},
-                                                      {{Z, Z, Fraction{1, 1}}}}}};
+                                     {{angle_sin, angle_cos, Z}},
+                                     {{Z, Z, O}}}}};
         }
 
         /**
@@ -94,9 +154,9 @@ namespace fun {
          * @param[in] sy  Y scale factor.
          * @return constexpr Transform
          */
-        static constexpr auto scaling(const Fraction& sx, const Fraction& sy) -> Transform {
-            const Fraction Z{0, 1};
-            return Transform{Mat3x3{{{{sx, Z, Z}}, {{Z, sy, Z}}, {{Z, Z, Fraction{1, 1}}}}}};
+        static constexpr auto scaling(const Rational& sx, const Rational& sy) -> Transform {
+            const Rational Z{0, 1}, O{1, 1};
+            return Transform{Mat3x3{{{{sx, Z, Z}}, {{Z, sy, Z}}, {{Z, Z, O}}}}};
         }
 
         /**
@@ -113,8 +173,8 @@ namespace fun {
          * @param[in] shy  Y shear factor.
          * @return constexpr Transform
          */
-        static constexpr auto shear(const Fraction& shx, const Fraction& shy) -> Transform {
-            const Fraction Z{0, 1}, O{1, 1};
+        static constexpr auto shear(const Rational& shx, const Rational& shy) -> Transform {
+            const Rational Z{0, 1}, O{1, 1};
             return Transform{Mat3x3{{{{O, shx, Z}}, {{shy, O, Z}}, {{Z, Z, O}}}}};
         }
 
@@ -126,149 +186,614 @@ namespace fun {
          *  \f[ (M_1 M_2)_{ij} = \sum_k (M_1)_{ik} (M_2)_{kj} \f]
          * @param[in] other  The transform to apply after this one.
          * @return Transform
+         * @throws std::overflow_error if the reduced product does not fit into int64_t.
          */
         constexpr auto compose(const Transform& other) const -> Transform {
-            Mat3x3 result{};
-            for (int i = 0; i < 3; ++i) {
-                for (int j = 0; j < 3; ++j) {
-                    Fraction sum{0, 1};
-                    for (int k = 0; k < 3; ++k) {
-                        sum = sum + matrix_[i][k] * other.matrix_[k][j];
+            if (kind_ == TransformKind::Identity && den_ == 1) return other;
+            if (other.kind_ == TransformKind::Identity && other.den_ == 1) return *this;
+            const auto& rhs = other.matrix_;
+            WideMat3x3 result{};
+            if (is_diagonal(kind_) && is_diagonal(other.kind_)) {
+                for (std::size_t i = 0; i < 3; ++i) {
+                    result[i][i] = detail::wide_mul(matrix_[i][i], rhs[i][i]);
+                }
+            } else if (is_affine(kind_) && is_affine(other.kind_)) {
+                // [L1 t1; 0 c1] [L2 t2; 0 c2] = [L1 L2, L1 t2 + c2 t1; 0, c1 c2]
+                for (std::size_t i = 0; i < 2; ++i) {
+                    for (std::size_t j = 0; j < 2; ++j) {
+                        result[i][j] = detail::checked_add(
+                            detail::wide_mul(matrix_[i][0], rhs[0][j]),
+                            detail::wide_mul(matrix_[i][1], rhs[1][j]));
+                    }
+                    result[i][2] = this->row_dot(i, {rhs[0][2], rhs[1][2], rhs[2][2]});
+                }
+                result[2][2] = detail::wide_mul(matrix_[2][2], rhs[2][2]);
+            } else {
+                for (std::size_t i = 0; i < 3; ++i) {
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        result[i][j] = this->row_dot(i, {rhs[0][j], rhs[1][j], rhs[2][j]});
                     }
-                    result[i][j] = sum;
                 }
             }
-            return Transform{result};
+            return canonical(result, detail::wide_mul(den_, other.den_));
         }
 
         /**
          * @brief Apply the transformation to a point.
          *
-         *  \f[ p' = M p \f]
-         * @param[in] pt  The point.
+         *  \f[ p' = M p \sim A p \f]
+         * @param[in] point  The point.
          * @return PgPoint
+         * @throws std::overflow_error if the image does not fit into int64_t.
          */
         constexpr auto apply_point(const PgPoint& point) const -> PgPoint {
-            const Fraction x{point.coord[0], 1};
-            const Fraction y{point.coord[1], 1};
-            const Fraction z{point.coord[2], 1};
+            return this->with_kind([&](auto tag) {
+                return PgPoint{this->image_as<decltype(tag)::value>(point.coord)};
+            });
+        }
 
-            const auto& m = matrix_;
-            const auto xn = m[0][0] * x + m[0][1] * y + m[0][2] * z;
-            const auto yn = m[1][0] * x + m[1][1] * y + m[1][2] * z;
-            const auto zn = m[2][0] * x + m[2][1] * y + m[2][2] * z;
+        /**
+         * @brief Apply the transformation to a buffer of points (SoA).
+         *
+         * Exact like apply_point: each image is A p, reduced by its common
+         * factor only if it would not fit into int64_t.
+         *
+         * @param[in] points
+         * @param[out] out  same size as points; may be the same buffers as points
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         * @throws std::overflow_error if an image does not fit into int64_t.
+         */
+        void apply_points(CoordView points, CoordSpan out, std::size_t num_threads = 1) const {
+            assert(out.size() == points.size());
+            const auto isa = detect_simd_isa();
+            const auto mat_bits = this->entry_bits();
+            const auto n = points.size();
+            const auto num_blocks = (n + detail::transform_block - 1) / detail::transform_block;
+            detail::run_blocks(num_blocks, num_threads, [&](std::size_t blk) {
+                const auto first = blk * detail::transform_block;
+                const auto len = std::min(detail::transform_block, n - first);
+                this->apply_block(isa, mat_bits,
+                                  CoordView{points.x.subspan(first, len),
+                                            points.y.subspan(first, len),
+                                            points.z.subspan(first, len)},
+                                  CoordSpan{out.x.subspan(first, len), out.y.subspan(first, len),
+                                            out.z.subspan(first, len)});
+            });
+        }
 
-            return PgPoint{{xn.numer() / xn.denom(), yn.numer() / yn.denom(),
-                            zn.numer() / zn.denom()}};
+        /**
+         * @brief Apply the transformation to a PointSoA (out is resized).
+         *
+         * @param[in] points
+         * @param[out] out
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         */
+        void apply_points(const PointSoA& points, PointSoA& out,
+                          std::size_t num_threads = 1) const {
+            out.resize(points.size());
+            this->apply_points(points.view(), out.span(), num_threads);
+        }
+
+        /**
+         * @brief Apply the transformation to an array of points.
+         *
+         * For a projective map, blocks of points are transposed into column
+         * buffers on the stack so that they can use the same SIMD kernel as
+         * the SoA variant. The other kinds need at most six products per
+         * point, and their per-point kernels beat the transpose.
+         *
+         * @param[in] points
+         * @param[out] out  same size as points; may be the same array as points
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         * @throws std::overflow_error if an image does not fit into int64_t.
+         */
+        void apply_points(std::span<const PgPoint> points, std::span<PgPoint> out,
+                          std::size_t num_threads = 1) const {
+            assert(out.size() == points.size());
+            const auto isa = detect_simd_isa();
+            const auto mat_bits = this->entry_bits();
+            const auto n = points.size();
+            const auto num_blocks = (n + detail::transform_block - 1) / detail::transform_block;
+            detail::run_blocks(num_blocks, num_threads, [&](std::size_t blk) {
+                const auto first = blk * detail::transform_block;
+                const auto len = std::min(detail::transform_block, n - first);
+                if (kind_ != TransformKind::Projective) {
+                    this->with_kind([&](auto tag) {
+                        this->images_as<decltype(tag)::value>(points.subspan(first, len),
+                                                              out.subspan(first, len));
+                    });
+                    return;
+                }
+                using Column = std::array<std::int64_t, detail::transform_block>;
+                Column col_x;
+                Column col_y;
+                Column col_z;
+                for (std::size_t i = 0; i < len; ++i) {
+                    const auto& coord = points[first + i].coord;
+                    col_x[i] = coord[0];
+                    col_y[i] = coord[1];
+                    col_z[i] = coord[2];
+                }
+                const std::span<std::int64_t> sx{col_x.data(), len};
+                const std::span<std::int64_t> sy{col_y.data(), len};
+                const std::span<std::int64_t> sz{col_z.data(), len};
+                this->apply_block(isa, mat_bits, CoordView{sx, sy, sz}, CoordSpan{sx, sy, sz});
+                for (std::size_t i = 0; i < len; ++i) {
+                    out[first + i].coord = {col_x[i], col_y[i], col_z[i]};
+                }
+            });
         }
 
         /**
          * @brief Apply the transformation to a line (via inverse transpose).
          *
-         *  \f[ l' = M^{-T} l \f]
+         *  \f[ l' = M^{-T} l \sim \operatorname{adj}(A)^T l \f]
          * @param[in] line  The line.
          * @return PgLine
+         * @throws std::domain_error if the matrix is singular.
+         * @throws std::overflow_error if the image does not fit into int64_t.
          */
         constexpr auto apply_line(const PgLine& line) const -> PgLine {
-            const auto inv = inverse();
-            const Fraction x{line.coord[0], 1};
-            const Fraction y{line.coord[1], 1};
-            const Fraction z{line.coord[2], 1};
-
-            const auto& m = inv.matrix_;
-            const auto xn = m[0][0] * x + m[1][0] * y + m[2][0] * z;
-            const auto yn = m[0][1] * x + m[1][1] * y + m[2][1] * z;
-            const auto zn = m[0][2] * x + m[1][2] * y + m[2][2] * z;
+            this->require_invertible();
+            return this->with_kind([&](auto tag) {
+                return PgLine{this->line_image_as<decltype(tag)::value>(line.coord)};
+            });
+        }
 
-            return PgLine{{xn.numer() / xn.denom(), yn.numer() / yn.denom(),
-                           zn.numer() / zn.denom()}};
+        /**
+         * @brief Apply the transformation to a batch of lines.
+         *
+         * @param[in] lines
+         * @param[out] out  same size as lines; out[i] = apply_line(lines[i])
+         * @throws std::domain_error if the matrix is singular.
+         */
+        void apply_lines(std::span<const PgLine> lines, std::span<PgLine> out) const {
+            assert(out.size() == lines.size());
+            this->require_invertible();
+            this->with_kind([&](auto tag) {
+                for (std::size_t i = 0; i < lines.size(); ++i) {
+                    out[i].coord = this->line_image_as<decltype(tag)::value>(lines[i].coord);
+                }
+            });
         }
 
         /**
          * @brief Compute the inverse transformation.
          *
-         *  \f[ M^{-1} = \frac{\operatorname{adj}(M)}{\det(M)} \f]
+         *  \f[ M^{-1} = \frac{d \operatorname{adj}(A)}{\det(A)} \f]
+         *
+         * The cached adjugate is a multiple g adj(A), and its determinant
+         * pairing with A is g det(A), so the factor g cancels.
+         *
          * @return Transform
          * @throws std::domain_error if the matrix is singular.
+         * @throws std::overflow_error if the reduced inverse does not fit into int64_t.
          */
         constexpr auto inverse() const -> Transform {
-            const auto& m = matrix_;
-            const auto& a = m[0][0];
-            const auto& b = m[0][1];
-            const auto& c = m[0][2];
-            const auto& d = m[1][0];
-            const auto& e = m[1][1];
-            const auto& f = m[1][2];
-            const auto& g = m[2][0];
-            const auto& h = m[2][1];
-            const auto& i_ = m[2][2];
-
-            const auto det = a * (e * i_ - f * h) - b * (d * i_ - f * g) + c * (d * h - e * g);
-            if (det == Fraction{0, 1}) {
+            if (kind_ == TransformKind::Identity && den_ == 1) return *this;
+            const auto det = this->det_int(adjugate_);
+            if (det == 0) {
                 throw std::domain_error{"Cannot invert singular transformation matrix"};
             }
-            const auto inv_det = Fraction{1, 1} / det;
+            WideMat3x3 scaled{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    if (adjugate_[i][j] != 0) {
+                        scaled[i][j] = detail::checked_mul(adjugate_[i][j], den_);
+                    }
+                }
+            }
+            return canonical(scaled, det);
+        }
 
-            return Transform{Mat3x3{{{
-                {inv_det * (e * i_ - f * h), inv_det * (c * h - b * i_),
-                 inv_det * (b * f - c * e)},
-                {inv_det * (f * g - d * i_), inv_det * (a * i_ - c * g),
-                 inv_det * (c * d - a * f)},
-                {inv_det * (d * h - e * g), inv_det * (b * g - a * h),
-                 inv_det * (a * e - b * d)},
-            }}};
+        /**
+         * @brief Determinant of M.
+         *
+         *  \f[ \det M = \det(A) / d^3 \f]
+         * @return Rational
+         * @throws std::overflow_error if the reduced value does not fit into int64_t.
+         */
+        constexpr auto determinant() const -> Rational {
+            const auto det = this->det_int(cofactors(matrix_, kind_));
+            const auto den3 = detail::checked_mul(detail::wide_mul(den_, den_), den_);
+            const auto common = detail::wide_gcd(det, den3);
+            return Rational{detail::checked_narrow(det / common),
+                            detail::checked_narrow(den3 / common)};
         }
 
-        /** @brief Access the matrix. */
-        constexpr auto matrix() const -> const Mat3x3& { return matrix_; }
+        /** @brief The matrix M as fractions. */
+        constexpr auto matrix() const -> Mat3x3 {
+            Mat3x3 result{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    result[i][j] = Rational{matrix_[i][j], den_};
+                }
+            }
+            return result;
+        }
+
+        /** @brief The integer matrix A = d M (lowest terms together with d). */
+        constexpr auto int_matrix() const -> const IntMat3x3& { return matrix_; }
+
+        /** @brief The common denominator d > 0. */
+        constexpr auto denominator() const -> std::int64_t { return den_; }
+
+        /** @brief A positive multiple of adj(A), with the common factor of its entries removed. */
+        constexpr auto adjugate() const -> const WideMat3x3& { return adjugate_; }
 
         constexpr auto operator==(const Transform& other) const -> bool {
-            return matrix_ == other.matrix_;
+            return den_ == other.den_ && matrix_ == other.matrix_;
         }
 
         constexpr auto operator!=(const Transform& other) const -> bool {
             return !(*this == other);
         }
 
+        /** @brief The structure of A, which selects the kernels. */
+        constexpr auto kind() const noexcept -> TransformKind { return kind_; }
+
       private:
-        Mat3x3 matrix_;
+        constexpr Transform(const IntMat3x3& matrix, std::int64_t den, const WideMat3x3& adjugate,
+                            TransformKind kind)
+            : matrix_{matrix}, den_{den}, adjugate_{adjugate}, kind_{kind} {
+#if PROJGEOM_HAS_INT128
+            for (const auto& row : adjugate_) {
+                for (const auto& val : row) adjugate_small_ = adjugate_small_ && fits_int64(val);
+            }
+#endif
+        }
+
+        /// Call fn with the kind of A as a std::integral_constant.
+        template <typename Fn> constexpr auto with_kind(Fn&& fn) const
+            -> std::invoke_result_t<Fn, std::integral_constant<TransformKind,
+                                                               TransformKind::Projective>> {
+            using K = TransformKind;
+            switch (kind_) {
+                case K::Identity:
+                    return fn(std::integral_constant<K, K::Identity>{});
+                case K::Translation:
+                    return fn(std::integral_constant<K, K::Translation>{});
+                case K::Diagonal:
+                    return fn(std::integral_constant<K, K::Diagonal>{});
+                case K::Affine:
+                    return fn(std::integral_constant<K, K::Affine>{});
+                case K::Projective:
+                    break;
+            }
+            return fn(std::integral_constant<K, K::Projective>{});
+        }
+
+        static constexpr auto is_diagonal(TransformKind kind) noexcept -> bool {
+            return kind == TransformKind::Identity || kind == TransformKind::Diagonal;
+        }
+
+        static constexpr auto is_affine(TransformKind kind) noexcept -> bool {
+            return kind != TransformKind::Projective;
+        }
+
+        static constexpr auto classify(const IntMat3x3& m) noexcept -> TransformKind {
+            if (m[2][0] != 0 || m[2][1] != 0 || m[2][2] == 0) return TransformKind::Projective;
+            if (m[0][1] != 0 || m[1][0] != 0) return TransformKind::Affine;
+            const bool moves = m[0][2] != 0 || m[1][2] != 0;
+            if (m[0][0] == m[2][2] && m[1][1] == m[2][2]) {
+                if (moves) return TransformKind::Translation;
+                if (m[2][2] == 1) return TransformKind::Identity;
+            }
+            return moves ? TransformKind::Affine : TransformKind::Diagonal;
+        }
+
+        /// A v for a matrix of kind K, reduced by the common factor only if needed.
+        ///
+        /// int64 arithmetic first; 128-bit intermediates only if that overflows.
+        template <TransformKind K>
+        constexpr auto image_as(const std::array<std::int64_t, 3>& vec) const
+            -> std::array<std::int64_t, 3> {
+            if constexpr (K == TransformKind::Identity) {
+                return vec;
+            } else {
+                std::array<std::int64_t, 3> res{};
+                if (this->image_small<K>(vec, res)) return res;
+                return detail::checked_narrow(std::array<detail::int_wide, 3>{
+                    this->row_dot(0, vec), this->row_dot(1, vec), this->row_dot(2, vec)});
+            }
+        }
+
+        /// image_as over an array of points, with the 128-bit fallback kept out of the loop.
+        template <TransformKind K>
+        void images_as(std::span<const PgPoint> points, std::span<PgPoint> out) const {
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                if constexpr (K == TransformKind::Identity) {
+                    out[i].coord = points[i].coord;
+                } else {
+                    std::array<std::int64_t, 3> img{};
+                    if (!this->image_small<K>(points[i].coord, img)) {
+                        img = this->image_as<K>(points[i].coord);
+                    }
+                    out[i].coord = img;
+                }
+            }
+        }
+
+        /// A v in int64 arithmetic, skipping the zero entries of kind K; false on overflow.
+        template <TransformKind K>
+        constexpr auto image_small(const std::array<std::int64_t, 3>& vec,
+                                   std::array<std::int64_t, 3>& res) const noexcept -> bool {
+            const auto& m = matrix_;
+            if constexpr (K == TransformKind::Translation) {
+                if (m[2][2] == 1) {
+                    std::int64_t shift_x = 0;
+                    std::int64_t shift_y = 0;
+                    res[2] = vec[2];
+                    return !mul_overflow(m[0][2], vec[2], shift_x)
+                           && !mul_overflow(m[1][2], vec[2], shift_y)
+                           && !add_overflow(vec[0], shift_x, res[0])
+                           && !add_overflow(vec[1], shift_y, res[1]);
+                }
+            }
+            if constexpr (K == TransformKind::Diagonal) {
+                return !mul_overflow(m[0][0], vec[0], res[0])
+                       && !mul_overflow(m[1][1], vec[1], res[1])
+                       && !mul_overflow(m[2][2], vec[2], res[2]);
+            } else if constexpr (K == TransformKind::Projective) {
+                return row_dot_small(m[0], vec, res[0]) && row_dot_small(m[1], vec, res[1])
+                       && row_dot_small(m[2], vec, res[2]);
+            } else {
+                return row_dot_small(m[0], vec, res[0]) && row_dot_small(m[1], vec, res[1])
+                       && !mul_overflow(m[2][2], vec[2], res[2]);
+            }
+        }
+
+        /// row · vec in int64 arithmetic; false if an intermediate overflows.
+        static constexpr auto row_dot_small(const std::array<std::int64_t, 3>& row,
+                                            const std::array<std::int64_t, 3>& vec,
+                                            std::int64_t& res) noexcept -> bool {
+            std::int64_t prod0 = 0;
+            std::int64_t prod1 = 0;
+            std::int64_t prod2 = 0;
+            std::int64_t acc = 0;
+            return !mul_overflow(row[0], vec[0], prod0) && !mul_overflow(row[1], vec[1], prod1)
+                   && !mul_overflow(row[2], vec[2], prod2) && !add_overflow(prod0, prod1, acc)
+                   && !add_overflow(acc, prod2, res);
+        }
+
+        /**
+         * @brief adj(A)^T l for a matrix of kind K, skipping the known zeros.
+         *
+         * For an affine A the last row of adj(A) is (0, 0, det L); a
+         * translation also has a diagonal 2×2 block.
+         */
+        template <TransformKind K>
+        constexpr auto line_image_as(const std::array<std::int64_t, 3>& line) const
+            -> std::array<std::int64_t, 3> {
+            if constexpr (K == TransformKind::Identity) {
+                return line;
+            } else {
+                using detail::checked_add;
+                const auto& adj = adjugate_;
+                // entries that fit into int64 need no overflow check on the product
+                const auto prod = [this](const detail::int_wide& entry, std::int64_t val) {
+                    return adjugate_small_
+                               ? detail::wide_mul(static_cast<std::int64_t>(entry), val)
+                               : detail::checked_mul(entry, val);
+                };
+                std::array<detail::int_wide, 3> res{};
+                if constexpr (K == TransformKind::Diagonal) {
+                    for (std::size_t i = 0; i < 3; ++i) res[i] = prod(adj[i][i], line[i]);
+                } else if constexpr (K == TransformKind::Projective) {
+                    for (std::size_t i = 0; i < 3; ++i) {
+                        const auto acc
+                            = checked_add(prod(adj[0][i], line[0]), prod(adj[1][i], line[1]));
+                        res[i] = checked_add(acc, prod(adj[2][i], line[2]));
+                    }
+                } else {
+                    if constexpr (K == TransformKind::Translation) {
+                        res[0] = prod(adj[0][0], line[0]);
+                        res[1] = prod(adj[1][1], line[1]);
+                    } else {
+                        res[0] = checked_add(prod(adj[0][0], line[0]), prod(adj[1][0], line[1]));
+                        res[1] = checked_add(prod(adj[0][1], line[0]), prod(adj[1][1], line[1]));
+                    }
+                    const auto acc
+                        = checked_add(prod(adj[0][2], line[0]), prod(adj[1][2], line[1]));
+                    res[2] = checked_add(acc, prod(adj[2][2], line[2]));
+                }
+                return detail::checked_narrow(res);
+            }
+        }
+
+        /// Bit width of the largest entry of A in magnitude.
+        [[nodiscard]] auto entry_bits() const noexcept -> int {
+            std::uint64_t mags = 0;
+            for (const auto& row : matrix_) {
+                for (const auto val : row) mags |= magnitude(val);
+            }
+            return std::bit_width(mags);
+        }
+
+        /**
+         * @brief One block of apply_points.
+         *
+         * If every coordinate has at most b bits and every entry of A at most
+         * a bits, each image coordinate is below 3 * 2^(a + b) <= 2^63 when
+         * a + b + 2 <= 63, so the wrapping SIMD products are exact.
+         */
+        void apply_block(SimdIsa isa, int mat_bits, CoordView points, CoordSpan out) const {
+            std::uint64_t mags = 0;
+            for (std::size_t i = 0; i < points.size(); ++i) {
+                mags |= magnitude(points.x[i]) | magnitude(points.y[i]) | magnitude(points.z[i]);
+            }
+            if (std::bit_width(mags) + mat_bits + 2 <= 63) {
+                mat3_batch(isa, matrix_, points, out);
+                return;
+            }
+            this->with_kind([&](auto tag) {
+                for (std::size_t i = 0; i < points.size(); ++i) {
+                    const auto img = this->image_as<decltype(tag)::value>(
+                        {points.x[i], points.y[i], points.z[i]});
+                    out.x[i] = img[0];
+                    out.y[i] = img[1];
+                    out.z[i] = img[2];
+                }
+            });
+        }
+
+        /// Row i of A times an integer vector.
+        constexpr auto row_dot(std::size_t row, const std::array<std::int64_t, 3>& vec) const
+            -> detail::int_wide {
+            const auto& arow = matrix_[row];
+            const auto acc = detail::checked_add(detail::wide_mul(arow[0], vec[0]),
+                                                 detail::wide_mul(arow[1], vec[1]));
+            return detail::checked_add(acc, detail::wide_mul(arow[2], vec[2]));
+        }
+
+        /// det(A), expanded along the first row.
+        constexpr auto det_int(const WideMat3x3& cof) const -> detail::int_wide {
+            auto acc = detail::checked_mul(matrix_[0][0], cof[0][0]);
+            acc = detail::checked_add(acc, detail::checked_mul(matrix_[0][1], cof[1][0]));
+            return detail::checked_add(acc, detail::checked_mul(matrix_[0][2], cof[2][0]));
+        }
+
+        /// A singular matrix has no line image: adj(A) collapses lines onto a point or to zero.
+        constexpr void require_invertible() const {
+            if (kind_ == TransformKind::Identity || kind_ == TransformKind::Translation) return;
+            if (this->det_int(adjugate_) == 0) {
+                throw std::domain_error{"Cannot map lines by a singular transformation matrix"};
+            }
+        }
+
+        /// Exact adj(m), skipping the entries that are zero for its kind.
+        static constexpr auto cofactors(const IntMat3x3& m, TransformKind kind) -> WideMat3x3 {
+            using detail::wide_mul;
+            auto minor = [&m](std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1) {
+                return detail::checked_add(wide_mul(m[r0][c0], m[r1][c1]),
+                                           -wide_mul(m[r0][c1], m[r1][c0]));
+            };
+            if (kind == TransformKind::Identity) {
+                return WideMat3x3{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+            }
+            if (is_diagonal(kind)) {
+                return WideMat3x3{{{wide_mul(m[1][1], m[2][2]), 0, 0},
+                                   {0, wide_mul(m[0][0], m[2][2]), 0},
+                                   {0, 0, wide_mul(m[0][0], m[1][1])}}};
+            }
+            if (is_affine(kind)) {
+                const auto corner = m[2][2];
+                return WideMat3x3{{
+                    {wide_mul(m[1][1], corner), -wide_mul(m[0][1], corner),
+                     minor(0, 1, 1, 2)},
+                    {-wide_mul(m[1][0], corner), wide_mul(m[0][0], corner),
+                     minor(0, 2, 1, 0)},
+                    {0, 0, minor(0, 0, 1, 1)},
+                }};
+            }
+            return WideMat3x3{{
+                {minor(1, 1, 2, 2), minor(0, 2, 2, 1), minor(0, 1, 1, 2)},
+                {minor(1, 2, 2, 0), minor(0, 0, 2, 2), minor(0, 2, 1, 0)},
+                {minor(1, 0, 2, 1), minor(0, 1, 2, 0), minor(0, 0, 1, 1)},
+            }};
+        }
+
+        /// Reduce matrix / den to lowest terms with den > 0 and cache the adjugate.
+        static constexpr auto canonical(WideMat3x3 matrix, detail::int_wide den)
+            -> Transform {
+            // once the gcd is 1 no further entry can change it, and no division is needed
+            auto common = den < 0 ? -den : den;
+            for (std::size_t k = 0; k < 9 && common != 1; ++k) {
+                common = detail::wide_gcd(common, matrix[k / 3][k % 3]);
+            }
+            if (den < 0) common = -common;
+            IntMat3x3 reduced{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    reduced[i][j] = detail::checked_narrow(common == 1 ? matrix[i][j]
+                                                                       : matrix[i][j] / common);
+                }
+            }
+            const auto kind = classify(reduced);
+            auto adj = cofactors(reduced, kind);
+            detail::int_wide adj_common = 0;
+            for (std::size_t k = 0; k < 9 && adj_common != 1; ++k) {
+                adj_common = detail::wide_gcd(adj_common, adj[k / 3][k % 3]);
+            }
+            if (adj_common > 1) {
+                for (auto& row : adj) {
+                    for (auto& val : row) val /= adj_common;
+                }
+            }
+            return Transform{reduced, detail::checked_narrow(den / common), adj, kind};
+        }
+
+        static constexpr auto from_integer(const IntMat3x3& matrix, std::int64_t den)
+            -> Transform {
+            if (den == 0) throw std::domain_error{"Transform: zero denominator"};
+            WideMat3x3 wide{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) wide[i][j] = matrix[i][j];
+            }
+            return canonical(wide, den);
+        }
+
+        /// Bring all entries to their least common denominator.
+        static constexpr auto from_rational(const Mat3x3& matrix) -> Transform {
+            detail::int_wide lcd = 1;
+            for (const auto& row : matrix) {
+                for (const auto& val : row) {
+                    lcd = detail::checked_mul(lcd / detail::wide_gcd(lcd, val.den()),
+                                              val.den());
+                }
+            }
+            WideMat3x3 wide{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    const auto& val = matrix[i][j];
+                    wide[i][j] = detail::checked_mul(val.num(), lcd / val.den());
+                }
+            }
+            return canonical(wide, lcd);
+        }
+
+        IntMat3x3 matrix_;
+        std::int64_t den_;
+        WideMat3x3 adjugate_;
+        TransformKind kind_;
+        bool adjugate_small_{true};  ///< every entry of adjugate_ fits into int64_t
     };
 
     // ---- convenience free functions -----------------------------------------
 
     /**
      * @brief Rotate a point around the origin.
-     * @param[in] pt       The point.
-     * @param[in] cos_a    Cosine of the rotation angle.
-     * @param[in] sin_a    Sine of the rotation angle.
+     * @param[in] point      The point.
+     * @param[in] angle_cos  Cosine of the rotation angle.
+     * @param[in] angle_sin  Sine of the rotation angle.
      * @return PgPoint
      */
-    inline     constexpr auto rotate_point(const PgPoint& point, const Fraction& angle_cos,
-                                       const Fraction& angle_sin) -> PgPoint {
+    inline constexpr auto rotate_point(const PgPoint& point, const Transform::Rational& angle_cos,
+                                       const Transform::Rational& angle_sin) -> PgPoint {
         return Transform::rotation(angle_cos, angle_sin).apply_point(point);
     }
 
     /**
      * @brief Translate a point by (tx, ty).
-     * @param[in] pt  The point.
+     * @param[in] point  The point.
      * @param[in] tx  X translation.
      * @param[in] ty  Y translation.
      * @return PgPoint
      */
-    inline     constexpr auto translate_point(const PgPoint& point, std::int64_t tx, std::int64_t ty)
+    inline constexpr auto translate_point(const PgPoint& point, std::int64_t tx, std::int64_t ty)
         -> PgPoint {
         return Transform::translation(tx, ty).apply_point(point);
     }
 
     /**
      * @brief Scale a point by (sx, sy).
-     * @param[in] pt  The point.
+     * @param[in] point  The point.
      * @param[in] sx  X scale factor.
      * @param[in] sy  Y scale factor.
      * @return PgPoint
      */
-    inline     constexpr auto scale_point(const PgPoint& point, const Fraction& sx, const Fraction& sy)
-        -> PgPoint {
+    inline constexpr auto scale_point(const PgPoint& point, const Transform::Rational& sx,
+                                      const Transform::Rational& sy) -> PgPoint {
         return Transform::scaling(sx, sy).apply_point(point);
     }
 
@@ -0,0 +1,322 @@
+/** @file transform_expr.hpp
+ *  @brief Lazy chains of transformations that fold their factors before application.
+ *
+ *  A chain such as rotation ∘ translation ∘ scaling built with
+ *  Transform::compose canonicalizes a full 3×3 matrix and its adjugate at
+ *  every step. TransformExpr records the chain instead and folds adjacent
+ *  factors analytically as they are appended: translations add, scalings
+ *  multiply and any mix of affine factors becomes a single affine map. Only
+ *  a general projective factor falls back to a Transform.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "pg_object.hpp"
+#include "pg_soa.hpp"
+#include "transform.hpp"
+
+namespace fun {
+
+    /**
+     * @brief A lazily folded product of transformations.
+     *
+     * Affine chains are kept as one integer matrix over its corner entry d,
+     * @f[
+     *     A = \begin{bmatrix} L & t \\ 0 & d \end{bmatrix}, \qquad M = A / d,
+     * @f]
+     * with an integer 2×2 block L, an integer translation t and d > 0. The
+     * entries are not kept in lowest terms: a common factor is divided out
+     * only when a product would not fit into int64_t, so folding a factor
+     * costs at most twelve multiplications and no gcd in the common case.
+     *
+     * compose has the same meaning as Transform::compose, and evaluate()
+     * returns the Transform that the same chain of eager compose calls
+     * produces. apply_point maps by A with a kernel specialized for the kind
+     * of the chain; its image is the eager one up to a projective scale.
+     */
+    class TransformExpr {
+      public:
+        using Rational = Transform::Rational;
+
+        /// As for Transform, except that Identity covers every multiple of I.
+        using Kind = TransformKind;
+
+        /**
+         * @brief The identity.
+         */
+        constexpr TransformExpr() = default;
+
+        /**
+         * @brief Start a chain from an eager transform.
+         *
+         * A transform whose matrix has last row (0, 0, 1) joins the affine
+         * fold; any other transform is kept as a projective factor.
+         *
+         * @param[in] xform
+         */
+        constexpr explicit TransformExpr(const Transform& xform) {
+            const auto& mat = xform.int_matrix();
+            if (mat[2][0] != 0 || mat[2][1] != 0 || mat[2][2] != xform.denominator()) {
+                kind_ = Kind::Projective;
+                projective_.emplace(xform);
+                return;
+            }
+            lin_ = {{{mat[0][0], mat[0][1]}, {mat[1][0], mat[1][1]}}};
+            trans_ = {mat[0][2], mat[1][2]};
+            den_ = mat[2][2];
+            kind_ = this->affine_kind();
+        }
+
+        // ---- factory methods ------------------------------------------------
+
+        /** @brief Identity transformation. */
+        static constexpr auto identity() -> TransformExpr { return TransformExpr{}; }
+
+        /**
+         * @brief Translation by \f$(t_x, t_y)\f$.
+         * @param[in] tx  X translation.
+         * @param[in] ty  Y translation.
+         * @return TransformExpr
+         */
+        static constexpr auto translation(std::int64_t tx, std::int64_t ty) -> TransformExpr {
+            TransformExpr res;
+            res.trans_ = {tx, ty};
+            res.kind_ = res.affine_kind();
+            return res;
+        }
+
+        /**
+         * @brief Rotation with the given cosine and sine.
+         * @param[in] angle_cos  Cosine of the angle.
+         * @param[in] angle_sin  Sine of the angle.
+         * @return TransformExpr
+         * @throws std::overflow_error if the common denominator does not fit into int64_t.
+         */
+        static constexpr auto rotation(const Rational& angle_cos, const Rational& angle_sin)
+            -> TransformExpr {
+            return linear(angle_cos, -angle_sin, angle_sin, angle_cos);
+        }
+
+        /**
+         * @brief Scaling by \f$(s_x, s_y)\f$.
+         * @param[in] sx  X scale factor.
+         * @param[in] sy  Y scale factor.
+         * @return TransformExpr
+         * @throws std::overflow_error if the common denominator does not fit into int64_t.
+         */
+        static constexpr auto scaling(const Rational& sx, const Rational& sy) -> TransformExpr {
+            return linear(sx, Rational{0}, Rational{0}, sy);
+        }
+
+        /**
+         * @brief Shear transformation.
+         * @param[in] shx  X shear factor.
+         * @param[in] shy  Y shear factor.
+         * @return TransformExpr
+         * @throws std::overflow_error if the common denominator does not fit into int64_t.
+         */
+        static constexpr auto shear(const Rational& shx, const Rational& shy) -> TransformExpr {
+            return linear(Rational{1}, shx, shy, Rational{1});
+        }
+
+        // ---- operations -----------------------------------------------------
+
+        /**
+         * @brief Append a factor to the chain (the product this · other).
+         *
+         * Translations add, scalings multiply and other affine factors
+         * multiply as 2×3 blocks; a projective factor on either side
+         * evaluates both sides and composes the Transforms.
+         *
+         * @param[in] other
+         * @return TransformExpr
+         * @throws std::overflow_error if the folded matrix does not fit into int64_t.
+         */
+        constexpr auto compose(const TransformExpr& other) const -> TransformExpr {
+            if (kind_ == Kind::Projective || other.kind_ == Kind::Projective) {
+                return TransformExpr{this->evaluate().compose(other.evaluate())};
+            }
+            if (other.kind_ == Kind::Identity) return *this;
+            if (kind_ == Kind::Identity) return other;
+            using detail::checked_add;
+            using detail::int_wide;
+            using detail::wide_mul;
+            std::array<int_wide, 7> res{};  // L00 L01 L10 L11 t0 t1 d
+            if (kind_ == Kind::Translation && other.kind_ == Kind::Translation) {
+                res = {1, 0, 0, 1, checked_add(trans_[0], other.trans_[0]),
+                       checked_add(trans_[1], other.trans_[1]), 1};
+            } else if (kind_ == Kind::Diagonal && other.kind_ == Kind::Diagonal) {
+                res = {wide_mul(lin_[0][0], other.lin_[0][0]), 0, 0,
+                       wide_mul(lin_[1][1], other.lin_[1][1]), 0, 0,
+                       wide_mul(den_, other.den_)};
+            } else {
+                // [L1 t1; 0 d1] [L2 t2; 0 d2] = [L1 L2, L1 t2 + d2 t1; 0, d1 d2]
+                for (std::size_t i = 0; i < 2; ++i) {
+                    for (std::size_t j = 0; j < 2; ++j) {
+                        res[2 * i + j] = checked_add(wide_mul(lin_[i][0], other.lin_[0][j]),
+                                                     wide_mul(lin_[i][1], other.lin_[1][j]));
+                    }
+                    const auto rot = checked_add(wide_mul(lin_[i][0], other.trans_[0]),
+                                                 wide_mul(lin_[i][1], other.trans_[1]));
+                    res[4 + i] = checked_add(rot, wide_mul(other.den_, trans_[i]));
+                }
+                res[6] = wide_mul(den_, other.den_);
+            }
+            return from_folded(res);
+        }
+
+        /**
+         * @brief Materialize the chain as one Transform.
+         *
+         * @return Transform
+         */
+        constexpr auto evaluate() const -> Transform {
+            if (kind_ == Kind::Projective) return *projective_;
+            return Transform{this->int_matrix(), den_};
+        }
+
+        /**
+         * @brief Apply the folded chain to a point.
+         *
+         * @param[in] point
+         * @return PgPoint, projectively equal to evaluate().apply_point(point)
+         * @throws std::overflow_error if the image does not fit into int64_t.
+         */
+        constexpr auto apply_point(const PgPoint& point) const -> PgPoint {
+            using detail::checked_add;
+            using detail::wide_mul;
+            const auto& [x, y, z] = point.coord;
+            switch (kind_) {
+                case Kind::Identity:
+                    return PgPoint{point.coord};
+                case Kind::Translation:
+                    return PgPoint{detail::checked_narrow(std::array<detail::int_wide, 3>{
+                        checked_add(x, wide_mul(trans_[0], z)),
+                        checked_add(y, wide_mul(trans_[1], z)), z})};
+                case Kind::Diagonal:
+                    return PgPoint{detail::checked_narrow(std::array<detail::int_wide, 3>{
+                        wide_mul(lin_[0][0], x), wide_mul(lin_[1][1], y),
+                        wide_mul(den_, z)})};
+                case Kind::Affine:
+                    break;
+                case Kind::Projective:
+                    return projective_->apply_point(point);
+            }
+            std::array<detail::int_wide, 3> res{};
+            for (std::size_t i = 0; i < 2; ++i) {
+                res[i] = checked_add(
+                    checked_add(wide_mul(lin_[i][0], x), wide_mul(lin_[i][1], y)),
+                    wide_mul(trans_[i], z));
+            }
+            res[2] = wide_mul(den_, z);
+            return PgPoint{detail::checked_narrow(res)};
+        }
+
+        /**
+         * @brief Apply the folded chain to a buffer of points.
+         *
+         * The chain is evaluated once and applied with the batch kernels of
+         * Transform::apply_points.
+         *
+         * @param[in] points
+         * @param[out] out  same size as points; may be the same array as points
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         * @throws std::overflow_error if an image does not fit into int64_t.
+         */
+        void apply_points(std::span<const PgPoint> points, std::span<PgPoint> out,
+                          std::size_t num_threads = 1) const {
+            if (kind_ == Kind::Identity) {
+                if (out.data() != points.data()) {
+                    std::copy(points.begin(), points.end(), out.begin());
+                }
+                return;
+            }
+            this->evaluate().apply_points(points, out, num_threads);
+        }
+
+        /**
+         * @brief Apply the folded chain to a buffer of points (SoA).
+         *
+         * @param[in] points
+         * @param[out] out  resized to points.size(); may be the same object as points
+         * @param[in] num_threads worker threads (0: std::thread::hardware_concurrency())
+         * @throws std::overflow_error if an image does not fit into int64_t.
+         */
+        void apply_points(const PointSoA& points, PointSoA& out,
+                          std::size_t num_threads = 1) const {
+            this->evaluate().apply_points(points, out, num_threads);
+        }
+
+        /** @brief The kind of the folded chain. */
+        constexpr auto kind() const noexcept -> Kind { return kind_; }
+
+      private:
+        Kind kind_{Kind::Identity};
+        std::array<std::array<std::int64_t, 2>, 2> lin_{{{1, 0}, {0, 1}}};
+        std::array<std::int64_t, 2> trans_{0, 0};
+        std::int64_t den_{1};
+        std::optional<Transform> projective_;
+
+        /// The kind of an affine chain, read off its entries.
+        constexpr auto affine_kind() const noexcept -> Kind {
+            const bool diagonal = lin_[0][1] == 0 && lin_[1][0] == 0;
+            const bool unit = diagonal && lin_[0][0] == den_ && lin_[1][1] == den_;
+            const bool moves = trans_[0] != 0 || trans_[1] != 0;
+            if (unit && !moves) return Kind::Identity;
+            if (unit && den_ == 1) return Kind::Translation;
+            if (diagonal && !moves) return Kind::Diagonal;
+            return Kind::Affine;
+        }
+
+        constexpr auto int_matrix() const -> Transform::IntMat3x3 {
+            return Transform::IntMat3x3{{{lin_[0][0], lin_[0][1], trans_[0]},
+                                         {lin_[1][0], lin_[1][1], trans_[1]},
+                                         {0, 0, den_}}};
+        }
+
+        /// The linear map [[a, b], [c, d]] over the common denominator of its entries.
+        static constexpr auto linear(const Rational& a, const Rational& b, const Rational& c,
+                                     const Rational& d) -> TransformExpr {
+            detail::int_wide lcd = 1;
+            for (const auto* val : {&a, &b, &c, &d}) {
+                lcd = detail::checked_mul(lcd / detail::wide_gcd(lcd, val->den()),
+                                          val->den());
+            }
+            const auto scaled = [lcd](const Rational& val) {
+                return detail::checked_mul(val.num(), lcd / val.den());
+            };
+            return from_folded({scaled(a), scaled(b), scaled(c), scaled(d), 0, 0, lcd});
+        }
+
+        /// Narrow a folded result, dividing out the common factor only if needed.
+        static constexpr auto from_folded(const std::array<detail::int_wide, 7>& res)
+            -> TransformExpr {
+            TransformExpr out;
+            std::array<std::int64_t, 7> val{};
+            bool fits = true;
+#if PROJGEOM_HAS_INT128
+            for (const auto& entry : res) fits = fits && fits_int64(entry);
+#endif
+            detail::int_wide common = 1;
+            if (!fits) {
+                common = 0;
+                for (const auto& entry : res) common = detail::wide_gcd(common, entry);
+            }
+            for (std::size_t k = 0; k < 7; ++k) val[k] = detail::checked_narrow(res[k] / common);
+            out.lin_ = {{{val[0], val[1]}, {val[2], val[3]}}};
+            out.trans_ = {val[4], val[5]};
+            out.den_ = val[6];
+            out.kind_ = out.affine_kind();
+            return out;
+        }
+    };
+
+}  // namespace fun
@@ -0,0 +1,476 @@
+/** @file wide_int.hpp
+ *  @brief Fixed-width signed integers Int128 and Int256 satisfying Ring/Integral.
+ *
+ *  WideInt<N> is an N x 64-bit two's complement integer stored inline (no heap
+ *  allocation). Arithmetic wraps modulo 2^(64 N) like the builtin unsigned
+ *  types; choose N so that the construction depth at hand cannot overflow.
+ *
+ *  Multiplication is tuned for the difference-of-products pattern of
+ *  cross0/cross1/cross2: when both factors fit into int64_t (the common case
+ *  at shallow depth) a single 64 x 64 -> 128 bit multiply is used instead of
+ *  the full schoolbook product. Int128 maps directly onto the compiler's
+ *  unsigned __int128 where available.
+ */
+
+#pragma once
+
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "int128.hpp"
+
+#if defined(__GNUC__)
+#    define PROJGEOM_UNROLL _Pragma("GCC unroll 8")
+#else
+#    define PROJGEOM_UNROLL
+#endif
+
+namespace fun {
+
+    /**
+     * @brief Fixed-width signed integer of N 64-bit limbs (two's complement).
+     *
+     * @tparam N number of 64-bit limbs (N >= 2)
+     */
+    template <std::size_t N> class WideInt {
+        static_assert(N >= 2, "use std::int64_t for a single limb");
+
+      public:
+        using limb_type = std::uint64_t;
+        static constexpr std::size_t limb_count = N;
+        static constexpr std::size_t bits = 64 * N;
+
+        /**
+         * @brief Zero.
+         */
+        constexpr WideInt() noexcept = default;
+
+        /**
+         * @brief Construct from a builtin integer (sign-extended).
+         *
+         * @param[in] val
+         */
+        template <std::integral T> constexpr WideInt(T val) noexcept {  // NOLINT
+            limbs_[0] = static_cast<limb_type>(val);
+            const limb_type fill = (std::is_signed_v<T> && val < 0) ? ~limb_type{0} : 0;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 1; i < N; ++i) limbs_[i] = fill;
+        }
+
+        /**
+         * @brief Convert from another width (sign-extend, or truncate if narrower).
+         *
+         * @param[in] other
+         */
+        template <std::size_t M>
+            requires(M != N)
+        constexpr explicit(M > N) WideInt(const WideInt<M>& other) noexcept {
+            const auto& src = other.limbs();
+            const limb_type fill = other.is_negative() ? ~limb_type{0} : 0;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 0; i < N; ++i) limbs_[i] = i < M ? src[i] : fill;
+        }
+
+        /**
+         * @brief Construct from raw little-endian limbs.
+         *
+         * @param[in] limbs
+         * @return WideInt
+         */
+        static constexpr auto from_limbs(const std::array<limb_type, N>& limbs) noexcept
+            -> WideInt {
+            WideInt res;
+            res.limbs_ = limbs;
+            return res;
+        }
+
+        [[nodiscard]] constexpr auto limbs() const noexcept -> const std::array<limb_type, N>& {
+            return limbs_;
+        }
+
+        [[nodiscard]] constexpr auto is_negative() const noexcept -> bool {
+            return (limbs_[N - 1] >> 63) != 0;
+        }
+
+        /**
+         * @brief Is the value representable as int64_t?
+         *
+         * @return bool
+         */
+        [[nodiscard]] constexpr auto fits_int64() const noexcept -> bool {
+            const limb_type fill = (limbs_[0] >> 63) != 0 ? ~limb_type{0} : 0;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 1; i < N; ++i) {
+                if (limbs_[i] != fill) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Lowest 64 bits as int64_t (exact iff fits_int64()).
+         *
+         * @return std::int64_t
+         */
+        [[nodiscard]] constexpr auto to_int64() const noexcept -> std::int64_t {
+            return static_cast<std::int64_t>(limbs_[0]);
+        }
+
+        explicit constexpr operator bool() const noexcept { return !this->is_zero(); }
+
+        explicit operator double() const noexcept {
+            const auto mag = this->magnitude();
+            double res = 0.0;
+            for (std::size_t i = N; i-- > 0;) {
+                res = res * 18446744073709551616.0 + static_cast<double>(mag.limbs_[i]);
+            }
+            return this->is_negative() ? -res : res;
+        }
+
+        // ---- comparison ------------------------------------------------------
+
+        friend constexpr auto operator==(const WideInt& lhs, const WideInt& rhs) noexcept -> bool
+            = default;
+
+        friend constexpr auto operator<=>(const WideInt& lhs, const WideInt& rhs) noexcept
+            -> std::strong_ordering {
+            const auto top_l = static_cast<std::int64_t>(lhs.limbs_[N - 1]);
+            const auto top_r = static_cast<std::int64_t>(rhs.limbs_[N - 1]);
+            if (top_l != top_r) return top_l <=> top_r;
+            for (std::size_t i = N - 1; i-- > 0;) {
+                if (lhs.limbs_[i] != rhs.limbs_[i]) return lhs.limbs_[i] <=> rhs.limbs_[i];
+            }
+            return std::strong_ordering::equal;
+        }
+
+        // ---- additive --------------------------------------------------------
+
+        constexpr auto operator+=(const WideInt& rhs) noexcept -> WideInt& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (N == 2) {
+                return *this = from_native(this->to_native() + rhs.to_native());
+            }
+#endif
+            limb_type carry = 0;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 0; i < N; ++i) {
+                const limb_type sum = limbs_[i] + rhs.limbs_[i];
+                const limb_type res = sum + carry;
+                carry = static_cast<limb_type>(sum < limbs_[i]) | static_cast<limb_type>(res < sum);
+                limbs_[i] = res;
+            }
+            return *this;
+        }
+
+        constexpr auto operator-=(const WideInt& rhs) noexcept -> WideInt& {
+#if PROJGEOM_HAS_INT128
+            if constexpr (N == 2) {
+                return *this = from_native(this->to_native() - rhs.to_native());
+            }
+#endif
+            limb_type borrow = 0;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 0; i < N; ++i) {
+                const limb_type diff = limbs_[i] - rhs.limbs_[i];
+                const limb_type res = diff - borrow;
+                borrow = static_cast<limb_type>(limbs_[i] < rhs.limbs_[i])
+                         | static_cast<limb_type>(diff < borrow);
+                limbs_[i] = res;
+            }
+            return *this;
+        }
+
+        constexpr auto operator-() const noexcept -> WideInt {
+            WideInt res;
+            res -= *this;
+            return res;
+        }
+
+        constexpr auto operator+() const noexcept -> WideInt { return *this; }
+
+        friend constexpr auto operator+(WideInt lhs, const WideInt& rhs) noexcept -> WideInt {
+            return lhs += rhs;
+        }
+
+        friend constexpr auto operator-(WideInt lhs, const WideInt& rhs) noexcept -> WideInt {
+            return lhs -= rhs;
+        }
+
+        // ---- multiplicative --------------------------------------------------
+
+        friend constexpr auto operator*(const WideInt& lhs, const WideInt& rhs) noexcept
+            -> WideInt {
+#if PROJGEOM_HAS_INT128
+            if constexpr (N == 2) {
+                return from_native(lhs.to_native() * rhs.to_native());
+            }
+#endif
+            WideInt res;
+            if (lhs.fits_int64() && rhs.fits_int64()) {
+                // fast path: one widening multiply, then sign-extend
+                const auto lhs64 = static_cast<std::int64_t>(lhs.limbs_[0]);
+                const auto rhs64 = static_cast<std::int64_t>(rhs.limbs_[0]);
+                limb_type hi = 0;
+                res.limbs_[0] = mul_wide(lhs.limbs_[0], rhs.limbs_[0], hi);
+                // signed correction of the unsigned high word
+                if (lhs64 < 0) hi -= rhs.limbs_[0];
+                if (rhs64 < 0) hi -= lhs.limbs_[0];
+                res.limbs_[1] = hi;
+                const limb_type fill = (hi >> 63) != 0 ? ~limb_type{0} : 0;
+                PROJGEOM_UNROLL
+                for (std::size_t i = 2; i < N; ++i) res.limbs_[i] = fill;
+                return res;
+            }
+            return mul_full(lhs, rhs);
+        }
+
+        constexpr auto operator*=(const WideInt& rhs) noexcept -> WideInt& {
+            return *this = *this * rhs;
+        }
+
+        /**
+         * @brief Truncating division (rounds toward zero, like builtin integers).
+         *
+         * @throws std::domain_error on division by zero
+         */
+        friend constexpr auto operator/(const WideInt& lhs, const WideInt& rhs) -> WideInt {
+            WideInt quot;
+            WideInt rem;
+            divmod(lhs, rhs, quot, rem);
+            return quot;
+        }
+
+        /**
+         * @brief Remainder with the sign of the dividend (like builtin integers).
+         *
+         * @throws std::domain_error on division by zero
+         */
+        friend constexpr auto operator%(const WideInt& lhs, const WideInt& rhs) -> WideInt {
+            WideInt quot;
+            WideInt rem;
+            divmod(lhs, rhs, quot, rem);
+            return rem;
+        }
+
+        constexpr auto operator/=(const WideInt& rhs) -> WideInt& { return *this = *this / rhs; }
+
+        constexpr auto operator%=(const WideInt& rhs) -> WideInt& { return *this = *this % rhs; }
+
+        // ---- shifts ----------------------------------------------------------
+
+        constexpr auto operator<<=(unsigned shift) noexcept -> WideInt& {
+            if (shift >= bits) return *this = WideInt{};
+            const auto limb_shift = shift / 64;
+            const auto bit_shift = shift % 64;
+            for (std::size_t i = N; i-- > 0;) {
+                limb_type val = i >= limb_shift ? limbs_[i - limb_shift] << bit_shift : 0;
+                if (bit_shift != 0 && i > limb_shift) {
+                    val |= limbs_[i - limb_shift - 1] >> (64 - bit_shift);
+                }
+                limbs_[i] = val;
+            }
+            return *this;
+        }
+
+        /// Arithmetic (sign-propagating) right shift.
+        constexpr auto operator>>=(unsigned shift) noexcept -> WideInt& {
+            const limb_type fill = this->is_negative() ? ~limb_type{0} : 0;
+            if (shift >= bits) {
+                limbs_.fill(fill);
+                return *this;
+            }
+            const auto limb_shift = shift / 64;
+            const auto bit_shift = shift % 64;
+            for (std::size_t i = 0; i < N; ++i) {
+                const auto src = i + limb_shift;
+                const limb_type lo = src < N ? limbs_[src] : fill;
+                const limb_type hi = src + 1 < N ? limbs_[src + 1] : fill;
+                limbs_[i] = bit_shift == 0 ? lo : (lo >> bit_shift) | (hi << (64 - bit_shift));
+            }
+            return *this;
+        }
+
+        friend constexpr auto operator<<(WideInt lhs, unsigned shift) noexcept -> WideInt {
+            return lhs <<= shift;
+        }
+
+        friend constexpr auto operator>>(WideInt lhs, unsigned shift) noexcept -> WideInt {
+            return lhs >>= shift;
+        }
+
+        /**
+         * @brief Absolute value (wraps for the most negative value).
+         */
+        friend constexpr auto abs(const WideInt& val) noexcept -> WideInt {
+            return val.is_negative() ? -val : val;
+        }
+
+        /**
+         * @brief Decimal representation.
+         *
+         * @return std::string
+         */
+        [[nodiscard]] auto to_string() const -> std::string {
+            constexpr limb_type kChunk = 10000000000000000000ULL;  // 10^19
+            auto mag = this->magnitude();
+            std::string digits;
+            do {
+                const auto rem = mag.divmod_small(kChunk);
+                auto chunk = std::to_string(rem);
+                if (!mag.is_zero()) chunk.insert(0, 19 - chunk.size(), '0');
+                digits.insert(0, chunk);
+            } while (!mag.is_zero());
+            return this->is_negative() ? "-" + digits : digits;
+        }
+
+        friend auto operator<<(std::ostream& os, const WideInt& val) -> std::ostream& {
+            return os << val.to_string();
+        }
+
+      private:
+        [[nodiscard]] constexpr auto is_zero() const noexcept -> bool {
+            for (const auto limb : limbs_) {
+                if (limb != 0) return false;
+            }
+            return true;
+        }
+
+        /// |*this| read as an unsigned N-limb number.
+        [[nodiscard]] constexpr auto magnitude() const noexcept -> WideInt {
+            return this->is_negative() ? -*this : *this;
+        }
+
+        /// Index of the highest nonzero limb plus one, treating limbs as unsigned.
+        [[nodiscard]] constexpr auto used_limbs() const noexcept -> std::size_t {
+            std::size_t len = N;
+            while (len > 0 && limbs_[len - 1] == 0) --len;
+            return len;
+        }
+
+#if PROJGEOM_HAS_INT128
+        /// Two limbs as a builtin unsigned 128-bit integer (wrapping arithmetic).
+        [[nodiscard]] constexpr auto to_native() const noexcept -> uint128_t {
+            return (uint128_t(limbs_[1]) << 64) | limbs_[0];
+        }
+
+        static constexpr auto from_native(uint128_t val) noexcept -> WideInt {
+            WideInt res;
+            res.limbs_[0] = static_cast<limb_type>(val);
+            res.limbs_[1] = static_cast<limb_type>(val >> 64);
+            return res;
+        }
+#endif
+
+        /// Truncated schoolbook product (two's complement is closed under it).
+        static constexpr auto mul_full(const WideInt& lhs, const WideInt& rhs) noexcept
+            -> WideInt {
+            WideInt res;
+            PROJGEOM_UNROLL
+            for (std::size_t i = 0; i < N; ++i) {
+                if (lhs.limbs_[i] == 0) continue;
+                limb_type carry = 0;
+                PROJGEOM_UNROLL
+                for (std::size_t j = 0; i + j < N; ++j) {
+                    limb_type hi = 0;
+                    const limb_type lo = mul_wide(lhs.limbs_[i], rhs.limbs_[j], hi);
+                    limb_type acc = res.limbs_[i + j] + lo;
+                    hi += static_cast<limb_type>(acc < lo);
+                    acc += carry;
+                    hi += static_cast<limb_type>(acc < carry);
+                    res.limbs_[i + j] = acc;
+                    carry = hi;
+                }
+            }
+            return res;
+        }
+
+        /// Unsigned in-place division by a single limb; returns the remainder.
+        constexpr auto divmod_small(limb_type div) noexcept -> limb_type {
+#if PROJGEOM_HAS_INT128
+            uint128_t rem = 0;
+            for (std::size_t i = N; i-- > 0;) {
+                const uint128_t cur = (rem << 64) | limbs_[i];
+                limbs_[i] = static_cast<limb_type>(cur / div);
+                rem = cur % div;
+            }
+            return static_cast<limb_type>(rem);
+#else
+            limb_type rem = 0;
+            for (std::size_t i = N * 64; i-- > 0;) {
+                const bool top = (rem >> 63) != 0;
+                rem = (rem << 1) | ((limbs_[i / 64] >> (i % 64)) & 1U);
+                limbs_[i / 64] &= ~(limb_type{1} << (i % 64));
+                if (top || rem >= div) {
+                    rem -= div;
+                    limbs_[i / 64] |= limb_type{1} << (i % 64);
+                }
+            }
+            return rem;
+#endif
+        }
+
+        /// Unsigned long division of magnitudes: num = quot * div + rem.
+        static constexpr void divmod_unsigned(const WideInt& num, const WideInt& div,
+                                              WideInt& quot, WideInt& rem) noexcept {
+            if (div.used_limbs() == 1) {
+                quot = num;
+                rem = WideInt(quot.divmod_small(div.limbs_[0]));
+                return;
+            }
+            quot = WideInt{};
+            rem = WideInt{};
+            const auto num_bits = num.used_limbs() * 64;
+            for (std::size_t i = num_bits; i-- > 0;) {
+                const bool top = (rem.limbs_[N - 1] >> 63) != 0;
+                rem <<= 1;
+                rem.limbs_[0] |= (num.limbs_[i / 64] >> (i % 64)) & 1U;
+                if (top || !unsigned_less(rem, div)) {
+                    rem -= div;
+                    quot.limbs_[i / 64] |= limb_type{1} << (i % 64);
+                }
+            }
+        }
+
+        static constexpr auto unsigned_less(const WideInt& lhs, const WideInt& rhs) noexcept
+            -> bool {
+            for (std::size_t i = N; i-- > 0;) {
+                if (lhs.limbs_[i] != rhs.limbs_[i]) return lhs.limbs_[i] < rhs.limbs_[i];
+            }
+            return false;
+        }
+
+        static constexpr void divmod(const WideInt& lhs, const WideInt& rhs, WideInt& quot,
+                                     WideInt& rem) {
+            if (rhs.is_zero()) {
+                throw std::domain_error{"WideInt: division by zero"};
+            }
+            if (lhs.fits_int64() && rhs.fits_int64()) {
+                const auto num = lhs.to_int64();
+                const auto div = rhs.to_int64();
+                if (div != -1) {
+                    quot = WideInt(num / div);
+                    rem = WideInt(num % div);
+                    return;
+                }
+            }
+            divmod_unsigned(lhs.magnitude(), rhs.magnitude(), quot, rem);
+            if (lhs.is_negative() != rhs.is_negative()) quot = -quot;
+            if (lhs.is_negative()) rem = -rem;
+        }
+
+        std::array<limb_type, N> limbs_{};
+    };
+
+    /// 128-bit signed integer (two limbs).
+    using Int128 = WideInt<2>;
+
+    /// 256-bit signed integer (four limbs).
+    using Int256 = WideInt<4>;
+
+}  // namespace fun
@@ -0,0 +1,157 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/big_int.hpp>
+#include <projgeom/common_concepts.h>
+#include <projgeom/euclid_plane_measure.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/int128.hpp>
+#include <projgeom/limb_arena.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using fun::BigInt;
+
+static_assert(fun::Integral<BigInt>);
+
+TEST_CASE("big_int: agrees with the builtin 128-bit integer") {
+    std::mt19937_64 gen(99);
+    auto to_big = [](fun::int128_t val) { return BigInt::from_int128(val); };
+    bool all_ok = true;
+    for (int trial = 0; trial < 3000; ++trial) {
+        const auto a = fun::int128_t(static_cast<std::int64_t>(gen()))
+                       * static_cast<std::int64_t>(gen() >> (gen() % 64));
+        auto b = fun::int128_t(static_cast<std::int64_t>(gen() >> (gen() % 64)));
+        if (trial % 3 == 0) b *= static_cast<std::int64_t>(gen() >> 40);
+        if (b == 0) b = 7;
+        const auto big_a = to_big(a);
+        const auto big_b = to_big(b);
+        all_ok = all_ok && big_a + big_b == to_big(a + b) && big_a - big_b == to_big(a - b)
+                 && big_a / big_b == to_big(a / b) && big_a % big_b == to_big(a % b)
+                 && (big_a < big_b) == (a < b) && -big_a == to_big(-a);
+        const auto small = fun::int128_t(1) << 62;
+        if (a > -small && a < small && b > -small && b < small) {
+            all_ok = all_ok && big_a * big_b == to_big(a * b);
+        }
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("big_int: multi-limb products, division and printing") {
+    const auto big = BigInt::from_string("-123456789012345678901234567890123456789");
+    CHECK_EQ(big.to_string(), "-123456789012345678901234567890123456789");
+    const auto two200 = BigInt(1) << 200;
+    const auto prod = (two200 + 3) * (two200 - 3);
+    CHECK_EQ(prod, (BigInt(1) << 400) - 9);
+    CHECK_EQ(prod / (two200 - 3), two200 + 3);
+    CHECK_EQ(prod % (two200 - 3), BigInt(0));
+    CHECK_EQ(((BigInt(1) << 400) - 8) % (two200 + 3), BigInt(1));
+    CHECK_EQ((-prod) / BigInt(7), -(prod / BigInt(7)));
+    CHECK_EQ((big * big) / big, big);
+    CHECK_EQ((BigInt(1) << 128).to_string(), "340282366920938463463374607431768211456");
+    CHECK_EQ((BigInt(-5) << 70) >> 70, BigInt(-5));
+    CHECK_EQ(BigInt(INT64_MIN).to_int64(), INT64_MIN);
+    CHECK(BigInt(INT64_MIN).fits_int64());
+    CHECK(!(-BigInt(INT64_MIN)).fits_int64());
+    std::ostringstream os;
+    os << BigInt(0) << ' ' << BigInt(-42);
+    CHECK_EQ(os.str(), "0 -42");
+    CHECK_THROWS_AS(BigInt(1) / BigInt(0), std::domain_error);
+    CHECK_THROWS_AS(BigInt::from_string("12a"), std::invalid_argument);
+}
+
+TEST_CASE("big_int: Knuth division with random multi-limb operands") {
+    std::mt19937_64 gen(5);
+    bool all_ok = true;
+    for (int trial = 0; trial < 300; ++trial) {
+        BigInt num;
+        BigInt div;
+        const auto num_limbs = 1 + gen() % 6;
+        const auto div_limbs = 1 + gen() % 4;
+        for (std::size_t i = 0; i < num_limbs; ++i) num = (num << 64) + BigInt(gen());
+        for (std::size_t i = 0; i < div_limbs; ++i) div = (div << 64) + BigInt(gen() >> (i % 3));
+        if (div.is_zero()) div = BigInt(3);
+        BigInt quot;
+        BigInt rem;
+        BigInt::divmod(num, div, quot, rem);
+        all_ok = all_ok && quot * div + rem == num && rem < div && !rem.is_negative();
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("big_int: Fraction<BigInt> and the limb arena") {
+    using F = fun::Fraction<BigInt>;
+    const auto huge = BigInt(1) << 100;
+    const auto sum = F(BigInt(1), huge) + F(BigInt(1), huge * 3);
+    CHECK_EQ(sum.num(), BigInt(1));
+    CHECK_EQ(sum.den(), (huge * 3) / 4);
+    void* first = fun::arena_allocate(40);
+    fun::arena_deallocate(first, 40);
+    void* second = fun::arena_allocate(48);  // same 64-byte bucket
+    CHECK_EQ(first, second);
+    fun::arena_deallocate(second, 48);
+    // a thread that only frees still releases its cache when it exits
+    void* produced = fun::arena_allocate(40);
+    bool registered = false;
+    std::thread consumer([&] {
+        fun::arena_deallocate(produced, 40);
+        registered = fun::detail::arena_state().registered;
+    });
+    consumer.join();
+    CHECK(registered);
+}
+
+TEST_CASE("big_int: small values stay inline") {
+    const auto val = BigInt::from_int128(-(fun::int128_t(1) << 100));
+    CHECK(val.limbs().is_inline());
+    CHECK(!(val * val).limbs().is_inline());
+    auto moved = val * val;
+    const auto stolen = std::move(moved);
+    CHECK_EQ(stolen, BigInt(1) << 200);
+}
+
+TEST_CASE("big_int: Karatsuba products agree with the schoolbook method") {
+    std::mt19937_64 gen(17);
+    auto random_big = [&gen](std::size_t limbs) {
+        BigInt res;
+        for (std::size_t i = 0; i < limbs; ++i) res = (res << 64) + BigInt(gen());
+        return res;
+    };
+    bool all_ok = true;
+    // 40 limbs: one Karatsuba level; 150 x 45 limbs: the unbalanced slicing
+    for (const auto [a_len, b_len] : std::array<std::array<std::size_t, 2>, 4>{
+             {{40, 40}, {150, 45}, {100, 70}, {31, 200}}}) {
+        const auto lhs = random_big(a_len);
+        const auto rhs = random_big(b_len);
+        const auto low = random_big(20);  // below the threshold: schoolbook
+        const auto prod = lhs * rhs;
+        all_ok = all_ok && prod / rhs == lhs && prod % rhs == BigInt(0)
+                 && lhs * (rhs + low) == prod + lhs * low && (-lhs) * rhs == -prod;
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("big_int: gcd") {
+    const auto prime = (BigInt(1) << 127) - 1;  // Mersenne prime
+    const auto lhs = prime * prime * BigInt(6);
+    const auto rhs = -(prime * BigInt(10));
+    CHECK_EQ(gcd(lhs, rhs), prime * BigInt(2));
+    CHECK_EQ(gcd(BigInt(0), rhs), abs(rhs));
+    CHECK_EQ(gcd(BigInt(12), BigInt(-18)), BigInt(6));
+    CHECK_EQ(fun::Fraction<BigInt>(lhs, rhs), fun::Fraction<BigInt>(BigInt(-3) * prime, BigInt(5)));
+}
+
+TEST_CASE("big_int: euclid_plane_measure runs exactly") {
+    // three collinear points on one axis satisfy the triple quad formula
+    const auto huge = BigInt(1) << 90;
+    const std::array<BigInt, 3> num{huge + 7, BigInt(-11), BigInt(3) * huge - 1};
+    const std::array<BigInt, 3> den{huge - 5, BigInt(17), huge * huge + 1};
+    const auto q_bc = fun::quad1(num[1], den[1], num[2], den[2]);
+    const auto q_ac = fun::quad1(num[0], den[0], num[2], den[2]);
+    const auto q_ab = fun::quad1(num[0], den[0], num[1], den[1]);
+    CHECK(q_ac.den().bit_length() > 256);
+    CHECK_EQ(fun::archimedes(q_bc, q_ac, q_ab), fun::Fraction<BigInt>(BigInt(0)));
+}
@@ -0,0 +1,33 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <numeric>
+#include <projgeom/binary_gcd.hpp>
+#include <projgeom/pg_line.hpp>
+#include <projgeom/pg_point.hpp>
+
+TEST_CASE("binary_gcd: agrees with std::gcd") {
+    CHECK_EQ(fun::binary_gcd(0, 0), 0U);
+    CHECK_EQ(fun::binary_gcd(0, 12), 12U);
+    CHECK_EQ(fun::binary_gcd(12, 0), 12U);
+    for (uint64_t a = 1; a < 60; a += 7) {
+        for (uint64_t b = 1; b < 200; b += 13) {
+            CHECK_EQ(fun::binary_gcd(a * 48, b * 36), std::gcd(a * 48, b * 36));
+        }
+    }
+    CHECK_EQ(fun::binary_gcd(uint64_t{1} << 63, uint64_t{3} << 40), uint64_t{1} << 40);
+}
+
+TEST_CASE("binary_gcd: magnitude and gcd_iterative") {
+    CHECK_EQ(fun::magnitude(INT64_MIN), uint64_t{1} << 63);
+    CHECK_EQ(fun::magnitude(-5), 5U);
+    CHECK_EQ(fun::gcd_iterative(-12, 18), 6);
+    CHECK_EQ(fun::gcd_iterative(0, -7), 7);
+}
+
+TEST_CASE("binary_gcd: fun::pg_point canonicalize") {
+    const fun::pg_point<int64_t> pt_p(-4, 6, 8);
+    CHECK_EQ(pt_p.canonicalize().coord, (std::array<int64_t, 3>{2, -3, -4}));
+    const fun::pg_line<int> ln_l(0, 0, -5);
+    CHECK_EQ(ln_l.canonicalize().coord, (std::array<int, 3>{0, 0, 1}));
+}
@@ -0,0 +1,281 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <projgeom/conic.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_soa.hpp>
+#include <projgeom/quad_ext.hpp>
+#include <projgeom/wide_int.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using fun::Conic;
+using fun::ConicMeet;
+using R = Conic::Rational;
+using Q = fun::QuadExt<R>;
+
+static_assert(fun::Ring<Q>);
+static_assert(std::is_trivially_copyable_v<ConicMeet>);
+static_assert(sizeof(Conic) == 6 * sizeof(std::int64_t));
+
+TEST_CASE("quad_ext: arithmetic in Q(sqrt d)") {
+    const Q one_plus{R(1), R(1), R(2)};
+    const Q three_plus{R(3), R(2), R(2)};
+    const Q half_plus{R(3, 2), R(1), R(2)};
+    const Q inverse{R(-1), R(1), R(2)};
+    const Q root_three{R(0), R(1), R(3)};
+    CHECK_EQ(one_plus * one_plus.conj(), Q(-1));
+    CHECK_EQ(one_plus.norm(), R(-1));
+    CHECK_EQ(one_plus * one_plus, three_plus);
+    CHECK_EQ(one_plus - one_plus, Q(0));
+    CHECK_EQ(Q(R(1, 2)) + one_plus, half_plus);
+    CHECK_EQ(Q(1) / one_plus, inverse);
+    CHECK_FALSE(one_plus.is_rational());
+    CHECK_THROWS_AS(one_plus + root_three, std::domain_error);
+}
+
+TEST_CASE("conic: packed integer form with exact contains and polar") {
+    const Conic::Coeffs doubled{2, 0, 2, 0, 0, -2};
+    CHECK_EQ(Conic(doubled), Conic::unit_circle());
+    const R one{1}, zero{0};
+    const Conic from_matrix{Conic::Mat3x3{{
+        {{one, zero, zero}},
+        {{R(2), one, zero}},
+        {{zero, zero, R(-1)}},
+    }}};
+    const Conic::Coeffs symmetrized{1, 1, 1, 0, 0, -1};
+    CHECK_EQ(from_matrix.coefficients(), symmetrized);
+
+    // y = x^2 / 3 has the form 6 y z - 2 x^2; its tangent at (3, 3) is y = 2 x - 3
+    const auto parab = Conic::parabola(R(1, 3));
+    const Conic::Coeffs packed{-2, 0, 0, 0, 3, 0};
+    CHECK_EQ(parab.coefficients(), packed);
+    CHECK(parab.contains(PgPoint({3, 3, 1})));
+    CHECK(parab.contains(PgPoint({-6, 12, 1})));
+    CHECK_FALSE(parab.contains(PgPoint({3, 4, 1})));
+    CHECK_EQ(parab.tangent(PgPoint({3, 3, 1})), PgLine({2, -1, -3}));
+    CHECK_EQ(parab.polar(PgPoint({0, 0, 1})), PgLine({0, 1, 0}));
+
+    constexpr std::int64_t kBig = std::int64_t{1} << 30;
+    const auto wide = Conic::circle(kBig, -kBig, 2 * kBig * kBig);
+    CHECK(wide.contains(PgPoint({0, 0, 1})));
+    CHECK(wide.contains(PgPoint({2 * kBig, -2 * kBig, 1})));
+    CHECK(wide.conic_type() == fun::ConicType::Ellipse);
+    CHECK(parab.conic_type() == fun::ConicType::Parabola);
+
+    // a common factor of 2^63 keeps the sign of the form
+    constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+    const Conic lowest{Conic::Coeffs{kMin, 0, 0, 0, 0, 0}};
+    const Conic::Coeffs unit{-1, 0, 0, 0, 0, 0};
+    CHECK_EQ(lowest.coefficients(), unit);
+    CHECK_EQ(lowest.classify(PgPoint({1, 0, 1})), -1);
+}
+
+TEST_CASE("conic: classify agrees with the exact form at every magnitude") {
+    const auto circle = Conic::circle(5, -3, 169);
+    CHECK_EQ(circle.classify(PgPoint({5, -3, 1})), -1);
+    CHECK_EQ(circle.classify(PgPoint({10, 9, 1})), 0);
+    CHECK_EQ(circle.classify(PgPoint({100, 0, 1})), 1);
+    CHECK_EQ(circle.classify(PgPoint({1, 1, 0})), 1);
+
+    // 3-4-5 triples on the unit circle beyond 128-bit intermediates
+    constexpr std::int64_t kHuge = std::int64_t{1} << 60;
+    const auto unit = Conic::unit_circle();
+    CHECK_EQ(unit.classify(PgPoint({3 * kHuge, 4 * kHuge, 5 * kHuge})), 0);
+    CHECK_EQ(unit.classify(PgPoint({3 * kHuge, 4 * kHuge + 1, 5 * kHuge})), 1);
+    CHECK_EQ(unit.classify(PgPoint({3 * kHuge, 4 * kHuge - 1, 5 * kHuge})), -1);
+    CHECK(unit.contains(PgPoint({3 * kHuge, 4 * kHuge, 5 * kHuge})));
+
+    // blocks of small, medium (128-bit) and huge (256-bit) coordinates
+    std::vector<PgPoint> pts;
+    std::uint64_t state = 12345;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const int shift = i < 600 ? 40 : (i < 800 ? 20 : 0);
+        const auto next = [&](std::uint64_t salt) {
+            return static_cast<std::int64_t>((state ^ salt) * 0x9E3779B97F4A7C15ULL) >> shift;
+        };
+        const auto k = static_cast<std::int64_t>(i) + 1;
+        pts.push_back(i % 7 == 0 ? PgPoint({10 * k, 9 * k, k})
+                                 : PgPoint({next(1), next(2), next(3) | 1}));
+    }
+    std::vector<std::int8_t> out(pts.size());
+    circle.classify(pts, out);
+    fun::PointSoA soa;
+    for (const auto& pt : pts) soa.push_back(pt);
+    std::vector<std::int8_t> out_soa(pts.size());
+    circle.classify(soa, out_soa);
+    bool all_ok = true;
+    std::array<std::size_t, 3> counts{};
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        const auto [a, b, c, d, e, f] = circle.coefficients();
+        const fun::Int256 x{pts[i].coord[0]}, y{pts[i].coord[1]}, z{pts[i].coord[2]};
+        const auto val = fun::Int256{a} * x * x + fun::Int256{c} * y * y + fun::Int256{f} * z * z
+                         + fun::Int256{2 * b} * x * y + fun::Int256{2 * d} * x * z
+                         + fun::Int256{2 * e} * y * z;
+        const int expect = val.is_negative() ? -1 : (val == fun::Int256{0} ? 0 : 1);
+        all_ok = all_ok && out[i] == expect && out_soa[i] == expect;
+        ++counts[static_cast<std::size_t>(expect + 1)];
+    }
+    CHECK(all_ok);
+    CHECK(counts[0] > 0);
+    CHECK(counts[1] > 0);
+    CHECK(counts[2] > 0);
+}
+
+TEST_CASE("conic: intersect returns exact rational and irrational points") {
+    const auto circle = Conic::unit_circle();
+
+    const auto vertical = circle.intersect(PgLine({1, 0, 0}));
+    REQUIRE(vertical.size() == 2);
+    REQUIRE(vertical.is_rational());
+    CHECK((vertical[0] == PgPoint({0, 1, 1}) || vertical[0] == PgPoint({0, -1, 1})));
+    CHECK_FALSE(vertical[0] == vertical[1]);
+    for (const auto& pt : vertical) CHECK(circle.contains(pt));
+
+    const auto touch = circle.intersect(PgLine({1, 0, -1}));
+    REQUIRE(touch.size() == 1);
+    CHECK_EQ(touch[0], PgPoint({1, 0, 1}));
+    CHECK(circle.intersect(PgLine({1, 0, -2})).empty());
+
+    // y = x meets the circle at (±1/√2, ±1/√2)
+    const auto diagonal = circle.intersect(PgLine({1, -1, 0}));
+    REQUIRE(diagonal.size() == 2);
+    REQUIRE(!diagonal.is_rational());
+    CHECK(diagonal.begin() == diagonal.end());
+    for (std::size_t i = 0; i < 2; ++i) {
+        const auto pt = diagonal.irrational_point(i);
+        CHECK_EQ(pt[0], pt[1]);
+        CHECK_EQ(pt[0] * pt[0] + pt[1] * pt[1] - pt[2] * pt[2], Q(0));
+        CHECK_EQ(pt[0].radicand(), R(2));
+    }
+    CHECK_FALSE(diagonal.irrational_point(0)[0] == diagonal.irrational_point(1)[0]);
+}
+
+TEST_CASE("conic: intersect handles points at infinity and degenerate conics") {
+    // x = 0 meets y = x^2 at the origin and at its point at infinity
+    const auto parab = Conic::parabola(R(1));
+    const auto axis = parab.intersect(PgLine({1, 0, 0}));
+    REQUIRE(axis.size() == 2);
+    CHECK_EQ(axis[0], PgPoint({0, 1, 0}));
+    CHECK_EQ(axis[1], PgPoint({0, 0, 1}));
+
+    // the line pair x y = 0 contains y = 0 and meets x = y + z on each line
+    const R zero{0}, half{1, 2};
+    const Conic pair{Conic::Mat3x3{{
+        {{zero, half, zero}},
+        {{half, zero, zero}},
+        {{zero, zero, zero}},
+    }}};
+    CHECK(pair.intersect(PgLine({0, 1, 0})).contains_line());
+    const auto cut = pair.intersect(PgLine({1, -1, -1}));
+    REQUIRE(cut.size() == 2);
+    CHECK(pair.contains(cut[0]));
+    CHECK(pair.contains(cut[1]));
+}
+
+TEST_CASE("conic: batched intersect agrees with single calls") {
+    const auto conic = Conic::circle(3, -2, 25);
+    std::vector<PgLine> lines;
+    for (std::int64_t a = -4; a <= 4; ++a) {
+        for (std::int64_t c = -40; c <= 40; c += 7) {
+            lines.emplace_back(std::array<std::int64_t, 3>{a, 3 - a, c});
+        }
+    }
+    std::vector<ConicMeet> out(lines.size());
+    conic.intersect(lines, out);
+    bool all_ok = true;
+    std::size_t rational = 0, irrational = 0, missed = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        all_ok = all_ok && out[i] == conic.intersect(lines[i]);
+        for (const auto& pt : out[i]) all_ok = all_ok && conic.contains(pt);
+        missed += out[i].empty() ? 1 : 0;
+        rational += !out[i].empty() && out[i].is_rational() ? 1 : 0;
+        irrational += out[i].is_rational() ? 0 : 1;
+    }
+    CHECK(all_ok);
+    CHECK(rational > 0);
+    CHECK(irrational > 0);
+    CHECK(missed > 0);
+}
+
+TEST_CASE("conic: through five points") {
+    const std::array<PgPoint, 5> on_circle{PgPoint({8, -2, 1}), PgPoint({-2, -2, 1}),
+                                           PgPoint({3, 3, 1}), PgPoint({6, 2, 1}),
+                                           PgPoint({-6, 14, -2})};
+    CHECK_EQ(Conic::through(on_circle), Conic::circle(3, -2, 25));
+
+    const std::array<PgPoint, 5> on_parabola{PgPoint({0, 0, 1}), PgPoint({3, 3, 1}),
+                                             PgPoint({-3, 3, 1}), PgPoint({6, 12, 1}),
+                                             PgPoint({0, 1, 0})};
+    const Conic::Coeffs flipped{2, 0, 0, 0, -3, 0};
+    CHECK_EQ(Conic::through(on_parabola).coefficients(), flipped);
+
+    // three collinear points: the line pair x y = 0
+    const std::array<PgPoint, 5> on_axes{PgPoint({0, 0, 1}), PgPoint({1, 0, 1}),
+                                         PgPoint({2, 0, 1}), PgPoint({0, 1, 1}),
+                                         PgPoint({0, 2, 1})};
+    const Conic::Coeffs axes{0, 1, 0, 0, 0, 0};
+    CHECK_EQ(Conic::through(on_axes).coefficients(), axes);
+
+    auto four_collinear = on_axes;
+    four_collinear[4] = PgPoint({3, 0, 1});
+    CHECK_THROWS_AS(Conic::through(four_collinear), std::domain_error);
+
+    // Pythagorean points beyond the 128-bit kernel still give the unit circle
+    auto triple = [](std::int64_t m_val, std::int64_t n_val) {
+        return PgPoint({m_val * m_val - n_val * n_val, 2 * m_val * n_val,
+                        m_val * m_val + n_val * n_val});
+    };
+    const std::array<PgPoint, 5> wide{triple(3000, 1), triple(2999, 7), triple(1, 4000),
+                                      triple(1234, 4321), triple(5, 3)};
+    CHECK_EQ(Conic::through(wide), Conic::unit_circle());
+
+    const std::array<PgPoint, 5> huge{PgPoint({1 << 30, 3, 1}), PgPoint({5, 1 << 29, 1}),
+                                      PgPoint({7, 11, 1 << 28}), PgPoint({13, 17, 19}),
+                                      PgPoint({23, 1 << 27, 29})};
+    CHECK_THROWS_AS(Conic::through(huge), std::overflow_error);
+}
+
+TEST_CASE("conic: batched through agrees with single fits") {
+    std::vector<std::array<PgPoint, 5>> samples;
+    std::uint64_t state = 777;
+    auto next = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<std::int64_t>(state >> 59) - 16;
+    };
+    for (std::size_t i = 0; i < 600; ++i) {
+        std::array<PgPoint, 5> sample{PgPoint({next(), next(), 1}), PgPoint({next(), next(), 1}),
+                                      PgPoint({next(), next(), 1}), PgPoint({next(), next(), 1}),
+                                      PgPoint({next(), next(), 1})};
+        if (i % 50 == 0) sample[3] = sample[1];
+        samples.push_back(sample);
+    }
+    std::vector<std::optional<Conic>> out(samples.size());
+    Conic::through(samples, out, 2);
+    bool all_ok = true;
+    std::size_t fitted = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (!out[i]) {
+            // only repeated points occur at this size
+            bool degenerate = false;
+            try {
+                (void)Conic::through(samples[i]);
+            } catch (const std::domain_error&) {
+                degenerate = true;
+            }
+            all_ok = all_ok && degenerate;
+            continue;
+        }
+        all_ok = all_ok && i % 50 != 0;
+        ++fitted;
+        all_ok = all_ok && *out[i] == Conic::through(samples[i]);
+        for (const auto& pt : samples[i]) all_ok = all_ok && out[i]->contains(pt);
+    }
+    CHECK(all_ok);
+    CHECK(fitted > 500);
+}
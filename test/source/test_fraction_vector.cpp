@@ -0,0 +1,122 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <projgeom/fraction_vector.hpp>
+#include <projgeom/fractions.hpp>
+#include <random>
+#include <vector>
+
+using F = fun::Fraction<std::int64_t>;
+
+namespace {
+    auto random_fractions(std::size_t n, std::uint64_t seed, std::int64_t range)
+        -> fun::FractionVector {
+        std::mt19937_64 gen(seed);
+        fun::FractionVector res;
+        res.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto num = static_cast<std::int64_t>(gen() % (2 * range + 1)) - range;
+            const auto den = static_cast<std::int64_t>(gen() % range) + 1;
+            res.push_back(num, den);
+        }
+        return res;
+    }
+}  // namespace
+
+TEST_CASE("fraction_vector: container round trip") {
+    const std::vector<F> fracs{F(1, 2), F(-6, 4), F(0, 5), F(7)};
+    const fun::FractionVector vec{fracs};
+    CHECK_EQ(vec.size(), 4U);
+    CHECK_EQ(vec[1], F(-3, 2));
+    CHECK_EQ(vec.den()[1], 2);
+    CHECK_EQ(vec[2], F(0));
+    fun::FractionVector zeros(3);
+    zeros.set(1, F(2, 3));
+    CHECK_EQ(zeros[0], F(0));
+    CHECK_EQ(zeros[1], F(2, 3));
+}
+
+TEST_CASE("fraction_vector: batched add/mul/compare agree with Fraction") {
+    for (const std::int64_t range : {std::int64_t{1000}, std::int64_t{1} << 40}) {
+        const auto lhs = random_fractions(1000, 5, range);
+        const auto rhs = random_fractions(1000, 6, range);
+        fun::FractionVector sum(lhs.size());
+        fun::FractionVector prod(lhs.size());
+        std::vector<std::int8_t> cmp(lhs.size());
+        bool all_ok = true;
+        if (range < 1000000) {
+            fun::add(lhs.view(), rhs.view(), sum.span());
+            fun::mul(lhs.view(), rhs.view(), prod.span());
+            for (std::size_t i = 0; i < lhs.size(); ++i) {
+                all_ok = all_ok && sum[i] == lhs[i] + rhs[i] && prod[i] == lhs[i] * rhs[i]
+                         && sum.den()[i] == (lhs[i] + rhs[i]).den();
+            }
+        }
+        fun::compare(lhs.view(), rhs.view(), cmp);
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            const int expect = lhs[i] < rhs[i] ? -1 : (rhs[i] < lhs[i] ? 1 : 0);
+            all_ok = all_ok && cmp[i] == expect;
+        }
+        CHECK(all_ok);
+    }
+}
+
+TEST_CASE("fraction_vector: large operands take the 128-bit path") {
+    fun::FractionVector lhs;
+    fun::FractionVector rhs;
+    constexpr std::int64_t kP = 4294967291;  // 2^32 - 5, prime
+    lhs.push_back(1, 2 * kP);
+    rhs.push_back(1, 3 * kP);
+    fun::FractionVector out(1);
+    fun::add(lhs.view(), rhs.view(), out.span());
+    CHECK_EQ(out[0], F(5, 6 * kP));
+    fun::FractionVector scale;
+    scale.push_back(kP, 1);
+    fun::mul(lhs.view(), scale.view(), out.span());
+    CHECK_EQ(out[0], F(1, 2));
+    CHECK_THROWS_AS(fun::mul(lhs.view(), lhs.view(), out.span()), std::overflow_error);
+}
+
+TEST_CASE("fraction_vector: parallel sort is exact") {
+    auto fracs = random_fractions(50000, 9, std::int64_t{1} << 40);
+    fracs.push_back(F(1, 3));
+    fracs.push_back(F(1, 3));
+    std::vector<F> expect;
+    for (std::size_t i = 0; i < fracs.size(); ++i) {
+        expect.push_back(fracs[i]);
+    }
+    std::sort(expect.begin(), expect.end());
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{3}, std::size_t{8}}) {
+        auto sorted = fracs;
+        fun::sort(sorted, threads);
+        bool all_ok = sorted.size() == expect.size();
+        for (std::size_t i = 0; all_ok && i < expect.size(); ++i) {
+            all_ok = sorted[i] == expect[i];
+        }
+        CHECK(all_ok);
+    }
+}
+
+TEST_CASE("fraction_vector: sort separates fractions that round to the same double") {
+    constexpr std::int64_t kBig = std::int64_t{1} << 60;
+    fun::FractionVector fracs;
+    fracs.push_back(kBig + 3, kBig + 1);  // above 2^53: exact compare only
+    fracs.push_back(kBig + 2, kBig + 1);
+    fracs.push_back(1, 1);
+    fracs.push_back(-5, 7);
+    const auto idx = fun::argsort(fracs.view(), 1);
+    const std::vector<std::size_t> expect{3, 2, 1, 0};
+    CHECK_EQ(idx, expect);
+    fun::FractionVector close;  // exact doubles, equal keys
+    constexpr std::int64_t kN = std::int64_t{1} << 52;
+    close.push_back(kN + 1, kN);
+    close.push_back(kN + 2, kN + 1);
+    close.push_back(1, 1);
+    CHECK_EQ(static_cast<double>(kN + 1) / static_cast<double>(kN),
+             static_cast<double>(kN + 2) / static_cast<double>(kN + 1));
+    fun::sort(close, 1);
+    CHECK_EQ(close[0], F(1));
+    CHECK_EQ(close[1], F(kN + 2, kN + 1));
+    CHECK_EQ(close[2], F(kN + 1, kN));
+}
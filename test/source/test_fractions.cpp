@@ -0,0 +1,133 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <limits>
+#include <projgeom/fractions.hpp>
+#include <projgeom/lazy_fraction.hpp>
+#include <projgeom/wide_int.hpp>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using fun::Fraction;
+using fun::LazyFraction;
+
+TEST_CASE("fractions: gcd agrees with std::gcd") {
+    std::mt19937_64 gen(12);
+    bool all_ok = true;
+    for (int trial = 0; trial < 2000; ++trial) {
+        const auto common = static_cast<std::int64_t>(gen() % 1000) + 1;
+        const auto a = static_cast<std::int64_t>(gen() % 2000000) - 1000000;
+        const auto b = static_cast<std::int64_t>(gen() % 2000000) - 1000000;
+        all_ok = all_ok && fun::gcd(a * common, b * common) == std::gcd(a * common, b * common);
+    }
+    CHECK(all_ok);
+    CHECK_EQ(fun::gcd(std::int64_t{0}, std::int64_t{-6}), 6);
+    CHECK_EQ(fun::gcd(std::int64_t{0}, std::int64_t{0}), 0);
+    CHECK_EQ(fun::gcd(fun::Int128(-48), fun::Int128(180)), fun::Int128(12));
+    CHECK_EQ(fun::lcm(4, -6), 12);
+}
+
+TEST_CASE("fractions: Fraction stays in lowest terms") {
+    const Fraction<std::int64_t> half(3, -6);
+    CHECK_EQ(half.num(), -1);
+    CHECK_EQ(half.den(), 2);
+    const auto sum = Fraction<std::int64_t>(1, 6) + Fraction<std::int64_t>(1, 3);
+    CHECK_EQ(sum, Fraction<std::int64_t>(1, 2));
+    CHECK(Fraction<std::int64_t>(2, 3) < Fraction<std::int64_t>(3, 4));
+}
+
+TEST_CASE("fractions: LazyFraction defers reduction") {
+    using LF = LazyFraction<std::int64_t>;
+    const LF six_twelfths(6, 12);
+    CHECK_EQ(six_twelfths.num(), 6);  // not reduced yet
+    CHECK_EQ(six_twelfths.den(), 12);
+    CHECK_EQ(six_twelfths, LF(1, 2));
+    CHECK_EQ(six_twelfths.reduced(), Fraction<std::int64_t>(1, 2));
+    CHECK_EQ(LF(-4, -8).den(), 8);  // sign is normalized eagerly
+    CHECK(LF(2, 3) < LF(3, 4));
+    CHECK(LF(-1, 3) < std::int64_t{0});
+    CHECK(LF(10, 5) == std::int64_t{2});
+    std::ostringstream os;
+    os << LF(6, 12);
+    CHECK_EQ(os.str(), "(1/2)");
+}
+
+TEST_CASE("fractions: LazyFraction sums agree with Fraction") {
+    std::mt19937_64 gen(34);
+    LazyFraction<std::int64_t> lazy;
+    Fraction<std::int64_t> eager;
+    bool all_ok = true;
+    for (int trial = 0; trial < 500; ++trial) {
+        // denominators share small factors, so the sums stay representable
+        const auto num = static_cast<std::int64_t>(gen() % 199) - 99;
+        const auto den = std::int64_t{1} << (gen() % 12);
+        lazy += LazyFraction<std::int64_t>(num, den);
+        eager += Fraction<std::int64_t>(num, den);
+        all_ok = all_ok && lazy.reduced() == eager;
+        all_ok = all_ok && lazy.den() <= fun::lazy_reduce_limit<std::int64_t>::value() << 12;
+    }
+    CHECK(all_ok);
+    const auto prod = LazyFraction<std::int64_t>(3, 4) * LazyFraction<std::int64_t>(8, 9);
+    CHECK_EQ(prod, LazyFraction<std::int64_t>(2, 3));
+    CHECK_EQ(prod / LazyFraction<std::int64_t>(-2, 3), LazyFraction<std::int64_t>(-1));
+    CHECK_EQ((prod / LazyFraction<std::int64_t>(-2, 3)).den(), 72);
+}
+
+TEST_CASE("fractions: LazyFraction arithmetic past the reduce limit is exact") {
+    using LF = LazyFraction<std::int64_t>;
+    constexpr std::int64_t kPrime = 4294967291;  // largest prime below 2^32
+    const LF sum = LF(1, 2 * kPrime) + LF(1, 3 * kPrime);
+    CHECK_EQ(sum.reduced(), Fraction<std::int64_t>(5, 6 * kPrime));
+    CHECK(sum.den() > 0);
+    CHECK_EQ(LF(kPrime, 3) * LF(2, kPrime), LF(2, 3));
+    CHECK_EQ(LF(kPrime, 3) / LF(kPrime, 5), LF(5, 3));
+    CHECK(LF(kPrime * 4, 2) == kPrime * 2);
+    CHECK_THROWS_AS(LF(kPrime, 1) * LF(kPrime, 1), std::overflow_error);
+    constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+    CHECK_THROWS_AS(LF(1) - LF(kMin), std::overflow_error);  // 2^63 + 1
+    CHECK_EQ(LF(-1) - LF(kMin), LF(std::numeric_limits<std::int64_t>::max()));
+    const auto small = LazyFraction<std::int32_t>(1, 40009) + LazyFraction<std::int32_t>(1, 40013);
+    CHECK_EQ(small.reduced(), Fraction<std::int32_t>(80022, 40009 * 40013));
+}
+
+TEST_CASE("fractions: LazyFraction comparisons do not overflow for int64") {
+    constexpr auto kBig = std::numeric_limits<std::int64_t>::max() / 2;
+    const auto lhs = LazyFraction<std::int64_t>(kBig, kBig - 1);
+    const auto rhs = LazyFraction<std::int64_t>(kBig - 1, kBig - 2);
+    CHECK(lhs < rhs);  // the cross products need ~125 bits
+    CHECK(lhs != rhs);
+}
+
+TEST_CASE("fractions: Fraction<int64_t> large operands use 128-bit intermediates") {
+    using F = Fraction<std::int64_t>;
+    constexpr std::int64_t kP = 4294967291;  // 2^32 - 5, prime
+    constexpr std::int64_t kQ = 4294967279;  // 2^32 - 17, prime
+    // the cross products overflow int64_t but the reduced results fit
+    CHECK_EQ(F(1, 2 * kP) + F(1, 3 * kP), F(5, 6 * kP));
+    CHECK_EQ(F(1, 2 * kP) - F(1, 3 * kP), F(1, 6 * kP));
+    CHECK_EQ(F(kP, kQ) * F(kQ, kP), F(1));
+    CHECK_EQ(F(kP, kQ) / F(kP, kQ), F(1));
+    CHECK_EQ(F(kP, 3) - F(kP - 3, 3), F(1));
+    CHECK_EQ(F(kP, kQ) * kQ, F(kP));
+    CHECK_EQ(F(kP, 2) / kP, F(1, 2));
+    CHECK(F(kP, kQ) < F(kP - 1, kQ - 1));  // exact compare without overflow
+    CHECK(F(kP, kQ) == F(kP, kQ));
+    CHECK(F(kQ, kP) < std::int64_t{1});
+    CHECK(std::int64_t{1} < F(kP, kQ));
+    CHECK_THROWS_AS(F(1, kP) * F(1, kQ), std::overflow_error);
+    CHECK_THROWS_AS(F(1, kP) + F(1, kQ), std::overflow_error);
+    // sums with INT64_MIN are representable and must not negate it first
+    constexpr auto kMin = std::numeric_limits<std::int64_t>::min();
+    CHECK_EQ(F(1) + F(kMin), F(kMin + 1));
+    auto acc = F(1);
+    acc += F(kMin);
+    CHECK_EQ(acc, F(kMin + 1));
+    acc = F(1);
+    acc += kMin;
+    CHECK_EQ(acc, F(kMin + 1));
+    constexpr auto kMax = std::numeric_limits<std::int64_t>::max();
+    CHECK_EQ(F(-1) - F(kMax), F(kMin));
+    CHECK_EQ(F(-1) - kMax, F(kMin));
+    CHECK_EQ(kMin - F(-1), F(kMin + 1));
+}
@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <projgeom/incidence_matrix.hpp>
+#include <projgeom/pg_object.hpp>
+#include <vector>
+
+namespace {
+    // Points (i mod 7, i mod 5, 1) against horizontal/vertical lines of the 7x5 grid.
+    auto grid_points(std::size_t n) -> std::vector<PgPoint> {
+        std::vector<PgPoint> pts;
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto k = static_cast<int64_t>(i);
+            pts.emplace_back(std::array<int64_t, 3>{k % 7, k % 5, 1});
+        }
+        return pts;
+    }
+
+    auto grid_lines() -> std::vector<PgLine> {
+        std::vector<PgLine> lns;
+        for (int64_t a = 0; a < 70; ++a) {
+            lns.emplace_back(std::array<int64_t, 3>{1, 0, -(a % 7)});  // x = a mod 7
+        }
+        for (int64_t b = 0; b < 5; ++b) {
+            lns.emplace_back(std::array<int64_t, 3>{0, 1, -b});  // y = b
+        }
+        return lns;
+    }
+}  // namespace
+
+TEST_CASE("incidence_matrix: set, test and popcounts") {
+    fun::IncidenceMatrix mat{3, 130};
+    mat.set(0, 0);
+    mat.set(0, 129);
+    mat.set(2, 129);
+    CHECK(mat.test(0, 129));
+    CHECK(!mat.test(1, 129));
+    CHECK_EQ(mat.words_per_row(), 3U);
+    CHECK_EQ(mat.row_count(0), 2U);
+    CHECK_EQ(mat.col_count(129), 2U);
+    CHECK_EQ(mat.count(), 3U);
+    const auto cols = mat.col_counts();
+    CHECK_EQ(cols[0], 1U);
+    CHECK_EQ(cols[129], 2U);
+}
+
+TEST_CASE("incidence_matrix: build matches naive incident loop") {
+    const auto pts = grid_points(150);
+    const auto lns = grid_lines();
+    for (std::size_t threads : {1U, 3U}) {
+        const auto mat = fun::build_incidence(pts, lns, threads);
+        CHECK_EQ(mat.rows(), pts.size());
+        CHECK_EQ(mat.cols(), lns.size());
+        bool all_match = true;
+        for (std::size_t i = 0; i < pts.size(); ++i) {
+            for (std::size_t j = 0; j < lns.size(); ++j) {
+                all_match = all_match && (mat.test(i, j) == pts[i].incident(lns[j]));
+            }
+        }
+        CHECK(all_match);
+        // every point lies on 10 of the vertical lines and on 1 horizontal line
+        CHECK_EQ(mat.row_count(42), 11U);
+        const auto counts = mat.col_counts();
+        CHECK_EQ(counts[70], mat.col_count(70));
+    }
+}
@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/common_concepts.h>
+#include <projgeom/int128.hpp>
+#include <projgeom/mod_int.hpp>
+#include <projgeom/pg_line.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/pg_point.hpp>
+#include <projgeom/wide_int.hpp>
+#include <random>
+
+using K = fun::ModInt61;
+using PointM = fun::pg_point<K>;
+
+static_assert(fun::Integral<K>);
+static_assert(fun::Integral<fun::ModInt<9223372036854775783ULL>>);
+
+TEST_CASE("mod_int: arithmetic agrees with 128-bit reference") {
+    constexpr auto kP = K::modulus;
+    std::mt19937_64 gen(7);
+    bool all_ok = true;
+    for (int trial = 0; trial < 5000; ++trial) {
+        const auto a = gen() % kP;
+        const auto b = gen() % kP;
+        const K ka(a);
+        const K kb(b);
+        all_ok = all_ok && (ka * kb).value() == fun::uint128_t(a) * b % kP
+                 && (ka + kb).value() == (a + b) % kP && (ka - kb).value() == (a + kP - b) % kP;
+        if (b != 0) {
+            all_ok = all_ok && (kb * kb.inverse()).value() == 1 && ka / kb * kb == ka
+                     && ka % kb == K(0);
+        }
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("mod_int: conversions and signed residues") {
+    CHECK_EQ(K(-1).value(), K::modulus - 1);
+    CHECK_EQ(K(-1).signed_value(), -1);
+    CHECK_EQ(K(5).signed_value(), 5);
+    CHECK_EQ(-K(3), K(-3));
+    CHECK_EQ(K(2).pow(61), K(1));  // 2^61 = 1 mod 2^61 - 1
+    CHECK(K(0) < K(-1));
+    CHECK_THROWS_AS(K(0).inverse(), std::domain_error);
+    CHECK(fun::detail::is_prime_u64(K::modulus));
+    CHECK(!fun::detail::is_prime_u64(3215031751ULL));  // strong pseudoprime to bases 2, 3, 5, 7
+}
+
+TEST_CASE("mod_int: pg_plane theorems over GF(p)") {
+    const std::array<PointM, 3> tri1{PointM(1, 1, 1), PointM(-3, 5, 2), PointM(7, -2, 3)};
+    const std::array<PointM, 3> tri2{PointM(11, 4, -1), PointM(2, 9, 5), PointM(-6, 1, 4)};
+    CHECK(fun::check_desargue(tri1, tri2));
+    const auto pt_c = PointM::parametrize(K(3), tri1[0], K(-5), tri1[1]);
+    const auto pt_f = PointM::parametrize(K(2), tri2[0], K(7), tri2[1]);
+    const std::array<PointM, 3> coline1{PointM(1, 1, 1), PointM(-3, 5, 2), PointM(pt_c)};
+    const std::array<PointM, 3> coline2{PointM(11, 4, -1), PointM(2, 9, 5), PointM(pt_f)};
+    CHECK(fun::check_pappus(coline1, coline2));
+    CHECK(fun::coincident(coline1[0], coline1[1], coline1[2]));
+    CHECK(!fun::coincident(tri1[0], tri1[1], tri1[2]));
+    const auto pt_d = fun::harm_conj<K>(coline1[0], coline1[1], coline1[2]);
+    CHECK(fun::harm_conj<K>(coline1[0], coline1[1], pt_d) == coline1[2]);
+}
+
+TEST_CASE("mod_int: deep construction agrees with exact Int256 result mod p") {
+    auto construct = [](const auto& pt_a, const auto& pt_b, const auto& pt_c, const auto& pt_d) {
+        const auto pt_e = (pt_a * pt_b) * (pt_c * pt_d);
+        const auto pt_f = (pt_a * pt_c) * (pt_b * pt_d);
+        const auto pt_g = (pt_a * pt_d) * (pt_b * pt_c);
+        const auto pt_h = (pt_e * pt_b) * (pt_f * pt_d);
+        return (pt_e * pt_f) * (pt_g * pt_h);
+    };
+    using PointW = fun::pg_point<fun::Int256>;
+    const auto pw_r = construct(PointW(1009, 2, 1), PointW(-3, 1013, 1), PointW(907, -911, 1),
+                                PointW(-5, 17, 1019));
+    const auto pm_r = construct(PointM(1009, 2, 1), PointM(-3, 1013, 1), PointM(907, -911, 1),
+                                PointM(-5, 17, 1019));
+    const fun::Int256 modulus(K::modulus);
+    auto reduce = [&modulus](const fun::Int256& val) { return K((val % modulus).to_int64()); };
+    CHECK(pm_r == PointM(reduce(pw_r.coord[0]), reduce(pw_r.coord[1]), reduce(pw_r.coord[2])));
+    CHECK(pm_r.canonicalize().coord[2] == K(1));
+}
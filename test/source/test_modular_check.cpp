@@ -0,0 +1,117 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/modular_check.hpp>
+#include <projgeom/pg_line.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/pg_point.hpp>
+#include <projgeom/wide_int.hpp>
+#include <stdexcept>
+
+namespace {
+    /// Pappus configuration on two lines; the last point is moved off its line by `offset`.
+    template <typename K> auto pappus(K /*tag*/, int64_t scale, int64_t offset) -> bool {
+        using Point = fun::pg_point<K>;
+        const Point pt_a(K(1000003 * scale), K(-7), K(1));
+        const Point pt_b(K(-3), K(999983 * scale), K(2));
+        const Point pt_d(K(17), K(5), K(1000033 * scale));
+        const Point pt_e(K(-999979 * scale), K(11), K(3));
+        const auto pt_c = Point::parametrize(K(123457), pt_a, K(-98765), pt_b);
+        auto pt_f = Point::parametrize(K(31337), pt_d, K(271828), pt_e);
+        pt_f.coord[2] += K(offset);
+        const std::array<Point, 3> coline1{Point(pt_a), Point(pt_b), Point(pt_c)};
+        const std::array<Point, 3> coline2{Point(pt_d), Point(pt_e), Point(pt_f)};
+        return fun::check_pappus(coline1, coline2);
+    }
+}  // namespace
+
+TEST_CASE("modular_check: fixed Pappus configuration beyond int64 range") {
+    const auto ok = fun::modular_check([](auto tag) { return pappus(tag, 1000, 0); }, 600);
+    CHECK(ok.holds);
+    CHECK(ok.certain());
+    CHECK_EQ(ok.primes_used, 10U);
+    const auto bad = fun::modular_check([](auto tag) { return pappus(tag, 1000, 1); }, 600);
+    CHECK(!bad.holds);
+    CHECK(bad.certain());
+    CHECK_EQ(bad.primes_used, 1U);
+    // the Pappus value above needs ~600 bits; a value known to be below 2^61 needs one prime
+    const auto small = fun::modular_check([](auto tag) { return pappus(tag, 1, 0); }, 60);
+    CHECK(small.certain());
+    CHECK_EQ(small.primes_used, 1U);
+}
+
+TEST_CASE("modular_check: Schwartz-Zippel identity tests") {
+    const auto pappus_sz = fun::identity_test(
+        [](auto& rnd) {
+            using Point = fun::pg_point<typename std::decay_t<decltype(rnd)>::value_type>;
+            const Point pt_a(rnd(), rnd(), rnd());
+            const Point pt_b(rnd(), rnd(), rnd());
+            const Point pt_d(rnd(), rnd(), rnd());
+            const Point pt_e(rnd(), rnd(), rnd());
+            const std::array<Point, 3> coline1{Point(pt_a), Point(pt_b),
+                                               Point::parametrize(rnd(), pt_a, rnd(), pt_b)};
+            const std::array<Point, 3> coline2{Point(pt_d), Point(pt_e),
+                                               Point::parametrize(rnd(), pt_d, rnd(), pt_e)};
+            return fun::check_pappus(coline1, coline2);
+        },
+        64);
+    CHECK(pappus_sz.holds);
+    CHECK(pappus_sz.error_bound <= 1e-30);
+    CHECK(pappus_sz.primes_used >= 2U);
+
+    const auto collinear = fun::identity_test(
+        [](auto& rnd) {
+            using Point = fun::pg_point<typename std::decay_t<decltype(rnd)>::value_type>;
+            return fun::coincident(Point(rnd(), rnd(), rnd()), Point(rnd(), rnd(), rnd()),
+                                   Point(rnd(), rnd(), rnd()));
+        },
+        3);
+    CHECK(!collinear.holds);
+}
+
+TEST_CASE("modular_check: CRT reconstruction matches Int256") {
+    auto construct = [](auto tag) {
+        using K = decltype(tag);
+        using Point = fun::pg_point<K>;
+        const Point pt_a(K(1009), K(2), K(1));
+        const Point pt_b(K(-3), K(1013), K(1));
+        const Point pt_c(K(907), K(-911), K(1));
+        const Point pt_d(K(-5), K(17), K(1019));
+        const auto pt_e = (pt_a * pt_b) * (pt_c * pt_d);
+        const auto pt_f = (pt_a * pt_c) * (pt_b * pt_d);
+        const auto pt_g = (pt_a * pt_d) * (pt_b * pt_c);
+        return (pt_e * pt_f) * (pt_g * pt_a);
+    };
+    const auto exact = construct(fun::Int256(0));
+    for (std::size_t i = 0; i < 3; ++i) {
+        const auto val = fun::crt_value([&](auto tag) { return construct(tag).coord[i]; }, 200);
+        CHECK_EQ(val, exact.coord[i]);
+    }
+    CHECK_EQ(fun::crt_value([](auto tag) { return decltype(tag)(-5) * decltype(tag)(7); }, 10),
+             fun::Int256(-35));
+    CHECK_THROWS_AS(fun::crt_value([](auto tag) { return tag; }, 300), std::invalid_argument);
+}
+
+TEST_CASE("modular_check: batch verdicts are independent of the thread count") {
+    auto pred = [](std::size_t i, auto tag) {
+        return pappus(tag, static_cast<int64_t>(i % 7) + 1, static_cast<int64_t>(i % 2));
+    };
+    const auto serial = fun::modular_check_batch(600, pred, 600, {}, 1);
+    const auto parallel = fun::modular_check_batch(600, pred, 600, {}, 3);
+    bool all_ok = true;
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        all_ok = all_ok && serial[i].holds == (i % 2 == 0) && parallel[i].holds == serial[i].holds
+                 && parallel[i].primes_used == serial[i].primes_used;
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("modular_check: batch rethrows an exception from pred") {
+    auto pred = [](std::size_t i, auto tag) -> bool {
+        if (i == 3 || i == 300) throw std::domain_error{"bad configuration"};
+        return pappus(tag, 1, 0);
+    };
+    CHECK_THROWS_AS(fun::modular_check_batch(600, pred, 600, {}, 2), std::domain_error);
+    CHECK_THROWS_AS(fun::modular_check_batch(600, pred, 600, {}, 1), std::domain_error);
+}
@@ -0,0 +1,84 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <projgeom/pg_checked.hpp>
+#include <projgeom/pg_object.hpp>
+
+TEST_CASE("pg_checked: small inputs agree with the unchecked kernels") {
+    const std::array<int64_t, 3> a{1, 2, 3};
+    const std::array<int64_t, 3> b{4, 5, 6};
+    fun::OverflowFlag flag{};
+    CHECK_EQ(fun::checked_dot(a, b, flag), dot(a, b));
+    CHECK_EQ(fun::checked_cross(a, b, flag), cross(a, b));
+    CHECK_EQ(fun::checked_plckr(2, a, 3, b, flag), plckr(2, a, 3, b));
+    CHECK(!flag);
+}
+
+TEST_CASE("pg_checked: overflow raises a sticky flag") {
+    constexpr int64_t big = int64_t{1} << 40;
+    const std::array<int64_t, 3> a{big, 1, 1};
+    const std::array<int64_t, 3> b{1, big, 1};
+    fun::OverflowFlag flag{};
+    (void)fun::checked_cross(a, b, flag);  // z component is 2^80 - 1
+    CHECK(static_cast<bool>(flag));
+    (void)fun::checked_dot({1, 2, 3}, {4, 5, 6}, flag);
+    CHECK(static_cast<bool>(flag));  // stays raised
+    flag.clear();
+    CHECK(!flag);
+}
+
+TEST_CASE("pg_checked: exact intermediate products that cancel do not overflow") {
+#if PROJGEOM_HAS_INT128
+    constexpr int64_t big = std::numeric_limits<int64_t>::max();
+    const std::array<int64_t, 3> a{big, big, 1};
+    const std::array<int64_t, 3> b{big, big, 1};
+    fun::OverflowFlag flag{};
+    const auto res = fun::checked_cross(a, b, flag);
+    CHECK(!flag);
+    CHECK_EQ(res[2], 0);
+#endif
+}
+
+TEST_CASE("pg_checked: products at INT64_MIN raise the flag without overflowing int128") {
+    constexpr int64_t low = std::numeric_limits<int64_t>::min();
+    fun::OverflowFlag flag{};
+    (void)fun::detail::checked_sum_of_products(low, low, low, low, flag);  // 2^127
+    CHECK(static_cast<bool>(flag));
+    flag.clear();
+    const std::array<int64_t, 3> a{low, low, low};
+    (void)fun::checked_dot(a, a, flag);  // 3 * 2^126
+    CHECK(static_cast<bool>(flag));
+    flag.clear();
+    const PgPoint pt(a);
+    const PgLine ln(a);
+    CHECK(!fun::checked_incident(pt, ln, flag));
+#if PROJGEOM_HAS_INT128
+    CHECK(static_cast<bool>(flag));
+#endif
+}
+
+TEST_CASE("pg_checked: try_ variants report overflow as nullopt") {
+    constexpr int64_t big = int64_t{1} << 40;
+    CHECK(!fun::try_cross({big, 0, 0}, {0, big, 0}).has_value());
+    CHECK(fun::try_cross({1, 0, 0}, {0, 1, 0}).has_value());
+    CHECK(!fun::try_dot({big, 0, 0}, {big, 0, 0}).has_value());
+    CHECK(!fun::try_plckr(big, {big, 0, 0}, 1, {0, 0, 0}).has_value());
+}
+
+TEST_CASE("pg_checked: chained construction detects overflow") {
+    PgPoint pt_a({1003, 2029, 1});
+    PgPoint pt_b({-3017, 5011, 7});
+    PgPoint pt_c({4037, -1033, 3});
+    fun::OverflowFlag flag{};
+    auto ln = fun::checked_meet(pt_a, pt_b, flag);
+    auto pt = fun::checked_meet(ln, fun::checked_meet(pt_c, pt_a, flag), flag);
+    CHECK(!flag);
+    CHECK(fun::checked_incident(pt, ln, flag));
+    for (int i = 0; i < 4 && !flag; ++i) {
+        ln = fun::checked_meet(pt, pt_c, flag);
+        pt = fun::checked_meet(ln, fun::checked_meet(pt_b, pt, flag), flag);
+    }
+    CHECK(static_cast<bool>(flag));
+}
@@ -181,3 +181,20 @@ TEST_CASE("pg_object: cross product self is zero line") {
     CHECK(ln.coord[1] == 0);
     CHECK(ln.coord[2] == 0);
 }
+
+TEST_CASE("pg_object: canonicalize divides out the gcd and fixes the sign") {
+    PgPoint pt({-6, 4, 10});
+    auto can = pt.canonicalize();
+    CHECK_EQ(can.coord, (std::array<int64_t, 3>{3, -2, -5}));
+    CHECK(can == pt);
+    CHECK_EQ(PgLine({0, -4, 6}).canonicalize().coord, (std::array<int64_t, 3>{0, 2, -3}));
+    CHECK_EQ(PgPoint({0, 0, 0}).canonicalize().coord, (std::array<int64_t, 3>{0, 0, 0}));
+    CHECK_EQ(canonical({INT64_MIN, 0, 0}), (std::array<int64_t, 3>{1, 0, 0}));
+    CHECK_EQ(canonical({INT64_MIN, 1, 0}), (std::array<int64_t, 3>{INT64_MIN, 1, 0}));
+}
+
+TEST_CASE("pg_object: canonical forms of equal points coincide") {
+    PgPoint pt_p({3, 5, 7});
+    PgPoint pt_q({-9, -15, -21});
+    CHECK_EQ(pt_p.canonicalize().coord, pt_q.canonicalize().coord);
+}
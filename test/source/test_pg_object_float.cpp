@@ -0,0 +1,44 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <projgeom/pg_line.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/pg_point.hpp>
+
+using PointD = fun::pg_point<double>;
+using LineD = fun::pg_line<double>;
+
+TEST_CASE("pg_object<double>: diff_of_products is accurate") {
+    // (1 + 2^-27)(1 - 2^-27) - 1 * 1 = -2^-54, whereas the naive formula rounds to 0
+    const double a = 1.0 + std::ldexp(1.0, -27);
+    const double b = 1.0 - std::ldexp(1.0, -27);
+    CHECK_EQ(fun::diff_of_products(a, b, 1.0, 1.0), -std::ldexp(1.0, -54));
+}
+
+TEST_CASE("pg_object<double>: meet is normalized and incident with both points") {
+    const PointD pt_p(0.1, 0.2, 1.0);
+    const PointD pt_q(3.7, -1.3, 1.0);
+    const LineD ln = pt_p * pt_q;
+    CHECK(std::abs(fun::norm3(ln.coord) - 1.0) < 1e-15);
+    CHECK(pt_p.incident(ln));
+    CHECK(ln.incident(pt_q));
+}
+
+TEST_CASE("pg_object<double>: tolerance-aware incidence after rounding") {
+    const PointD pt_p(0.1, 0.7, 0.3);
+    const PointD pt_q(1e3, -2e3, 7.0);
+    const auto pt_r = PointD::parametrize(0.3, pt_p, 1.7, pt_q);
+    const LineD ln = pt_p * pt_q;
+    CHECK(pt_r.incident(ln));
+    const PointD off(pt_r.coord[0] * (1 + 1e-6), pt_r.coord[1], pt_r.coord[2]);
+    CHECK(!off.incident(ln));
+}
+
+TEST_CASE("pg_object<double>: equality up to scale") {
+    const PointD pt_p(1.0, 2.0, 3.0);
+    const PointD pt_q(-0.1, -0.2, -0.3);
+    CHECK(pt_p == pt_q);
+    CHECK(pt_p != PointD(1.0, 2.0, 3.001));
+    CHECK(pt_q.normalize() == pt_p);
+}
@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_soa.hpp>
+#include <vector>
+
+TEST_CASE("pg_soa: push_back and gather") {
+    fun::PointSoA pts;
+    pts.push_back(PgPoint({1, 2, 3}));
+    pts.push_back(PgPoint({4, 5, 6}));
+    CHECK_EQ(pts.size(), 2U);
+    CHECK_EQ(pts.x()[1], 4);
+    CHECK_EQ(pts.y()[1], 5);
+    CHECK_EQ(pts.z()[1], 6);
+    CHECK(pts[0] == PgPoint({1, 2, 3}));
+}
+
+TEST_CASE("pg_soa: batched meet matches scalar meet") {
+    const std::vector<PgPoint> lhs{PgPoint({1, 2, 3}), PgPoint({1, 0, 0}), PgPoint({-7, 3, 2})};
+    const std::vector<PgPoint> rhs{PgPoint({4, 5, 6}), PgPoint({0, 1, 0}), PgPoint({5, 11, -4})};
+    const fun::PointSoA soa_l{lhs};
+    const fun::PointSoA soa_r{rhs};
+    fun::LineSoA lines;
+    fun::meet(soa_l, soa_r, lines);
+    CHECK_EQ(lines.size(), 3U);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK_EQ(lines[i].coord, lhs[i].meet(rhs[i]).coord);
+    }
+
+    std::vector<PgLine> out(lhs.size(), PgLine({0, 0, 0}));
+    fun::meet<PgPoint>(lhs, rhs, out);
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        CHECK_EQ(out[i].coord, lhs[i].meet(rhs[i]).coord);
+    }
+}
+
+TEST_CASE("pg_soa: batched incident packs bits") {
+    fun::PointSoA pts;
+    fun::LineSoA lns;
+    for (int64_t i = 0; i < 70; ++i) {
+        pts.push_back(PgPoint({i, 1, 1}));
+        // even rows: line x = i (incident); odd rows: line x = i + 1 (not incident)
+        lns.push_back(PgLine({1, 0, (i % 2 == 0) ? -i : -(i + 1)}));
+    }
+    std::vector<std::uint64_t> bits;
+    fun::incident(pts, lns, bits);
+    CHECK_EQ(bits.size(), 2U);
+    for (std::size_t i = 0; i < 70; ++i) {
+        const bool bit = ((bits[i / 64] >> (i % 64)) & 1U) != 0;
+        CHECK_EQ(bit, i % 2 == 0);
+    }
+}
+
+TEST_CASE("pg_soa: batched parametrize matches scalar parametrize") {
+    const fun::PointSoA pts_p{std::vector<PgPoint>{PgPoint({1, 2, 3}), PgPoint({0, 1, 1})}};
+    const fun::PointSoA pts_q{std::vector<PgPoint>{PgPoint({4, 5, 6}), PgPoint({2, -1, 3})}};
+    const std::vector<int64_t> lambda{2, -1};
+    const std::vector<int64_t> mu{3, 5};
+    fun::PointSoA out(2);
+    fun::parametrize(lambda, pts_p.view(), mu, pts_q.view(), out.span());
+    for (std::size_t i = 0; i < 2; ++i) {
+        CHECK_EQ(out[i].coord,
+                 PgPoint::parametrize(lambda[i], pts_p[i], mu[i], pts_q[i]).coord);
+    }
+
+    fun::parametrize(1, pts_p.view(), 1, pts_q.view(), out.span());
+    CHECK_EQ(out[0].coord, (std::array<int64_t, 3>{5, 7, 9}));
+}
+
+TEST_CASE("pg_soa: batched canonicalize") {
+    std::vector<PgPoint> pts{PgPoint({2, 4, 6}), PgPoint({0, -3, 9}), PgPoint({-5, 0, 0})};
+    fun::PointSoA soa{pts};
+    fun::canonicalize(soa.span());
+    fun::canonicalize(std::span<PgPoint>{pts});
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        CHECK_EQ(soa[i].coord, pts[i].coord);
+    }
+    CHECK_EQ(pts[0].coord, (std::array<int64_t, 3>{1, 2, 3}));
+    CHECK_EQ(pts[1].coord, (std::array<int64_t, 3>{0, 1, -3}));
+    CHECK_EQ(pts[2].coord, (std::array<int64_t, 3>{1, 0, 0}));
+}
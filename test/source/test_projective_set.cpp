@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <functional>
+#include <projgeom/ell_object.hpp>
+#include <projgeom/hyp_object.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/projective_set.hpp>
+#include <unordered_set>
+#include <vector>
+
+TEST_CASE("pg_hash: proportional objects hash equally") {
+    std::hash<PgPoint> hasher;
+    CHECK_EQ(hasher(PgPoint({1, 2, 3})), hasher(PgPoint({-2, -4, -6})));
+    CHECK_EQ(std::hash<EllipticPoint>{}(EllipticPoint({0, 3, 6})),
+             std::hash<EllipticPoint>{}(EllipticPoint({0, 1, 2})));
+    CHECK_EQ(std::hash<HyperbolicLine>{}(HyperbolicLine({5, 0, -5})),
+             std::hash<HyperbolicLine>{}(HyperbolicLine({-1, 0, 1})));
+    CHECK_EQ(std::hash<fun::pg_point<int64_t>>{}(fun::pg_point<int64_t>(2, 4, 6)),
+             std::hash<fun::pg_point<int64_t>>{}(fun::pg_point<int64_t>(1, 2, 3)));
+}
+
+TEST_CASE("pg_hash: usable with std::unordered_set") {
+    std::unordered_set<PgLine> lines;
+    lines.insert(PgLine({1, 1, 1}));
+    lines.insert(PgLine({3, 3, 3}));
+    lines.insert(PgLine({1, 2, 3}));
+    CHECK_EQ(lines.size(), 2U);
+}
+
+TEST_CASE("projective_set: insert, contains and erase") {
+    fun::ProjectiveSet<PgPoint> set;
+    CHECK(set.insert(PgPoint({1, 2, 3})));
+    CHECK(!set.insert(PgPoint({2, 4, 6})));
+    CHECK(set.contains(PgPoint({-1, -2, -3})));
+    CHECK(!set.contains(PgPoint({1, 2, 4})));
+    CHECK_EQ(set.size(), 1U);
+    CHECK(set.erase(PgPoint({3, 6, 9})));
+    CHECK(!set.erase(PgPoint({3, 6, 9})));
+    CHECK(set.empty());
+}
+
+TEST_CASE("projective_set: many elements with growth and erasure") {
+    fun::ProjectiveSet<PgPoint> set;
+    for (int64_t i = 0; i < 1000; ++i) {
+        set.insert(PgPoint({i, i * i % 97, 1}));
+    }
+    CHECK_EQ(set.size(), 1000U);
+    for (int64_t i = 0; i < 1000; i += 2) {
+        CHECK(set.erase(PgPoint({3 * i, 3 * (i * i % 97), 3})));
+    }
+    CHECK_EQ(set.size(), 500U);
+    bool all_ok = true;
+    for (int64_t i = 0; i < 1000; ++i) {
+        all_ok = all_ok && (set.contains(PgPoint({i, i * i % 97, 1})) == (i % 2 == 1));
+    }
+    CHECK(all_ok);
+    std::size_t visited = 0;
+    set.for_each([&visited](const PgPoint&) { ++visited; });
+    CHECK_EQ(visited, 500U);
+}
+
+TEST_CASE("projective_map: operator[] and find") {
+    fun::ProjectiveMap<PgLine, int> counts;
+    ++counts[PgLine({1, 0, -1})];
+    ++counts[PgLine({-2, 0, 2})];
+    ++counts[PgLine({0, 1, 0})];
+    CHECK_EQ(counts.size(), 2U);
+    CHECK_EQ(*counts.find(PgLine({1, 0, -1})), 2);
+    CHECK(counts.find(PgLine({1, 1, 1})) == nullptr);
+    CHECK(counts.insert(PgLine({1, 1, 1}), 7));
+    CHECK(!counts.insert(PgLine({2, 2, 2}), 8));
+    CHECK_EQ(*counts.find(PgLine({1, 1, 1})), 7);
+}
+
+TEST_CASE("projective_set: unique_objects keeps first occurrences") {
+    const std::vector<PgPoint> pts{PgPoint({1, 2, 3}), PgPoint({0, 0, 1}), PgPoint({2, 4, 6}),
+                                   PgPoint({0, 0, -5})};
+    const auto uniq = fun::unique_objects<PgPoint>(pts);
+    CHECK_EQ(uniq.size(), 2U);
+    CHECK_EQ(uniq[0].coord, pts[0].coord);
+    CHECK_EQ(uniq[1].coord, pts[1].coord);
+}
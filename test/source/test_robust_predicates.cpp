@@ -0,0 +1,97 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <projgeom/int128.hpp>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/robust_predicates.hpp>
+#include <random>
+
+namespace {
+    struct DPoint {
+        std::array<double, 3> coord;
+    };
+
+    auto to_double(const std::array<int64_t, 3>& k) -> std::array<double, 3> {
+        return {std::ldexp(static_cast<double>(k[0]), -20),
+                std::ldexp(static_cast<double>(k[1]), -20),
+                std::ldexp(static_cast<double>(k[2]), -20)};
+    }
+
+    auto exact_det_sign(const std::array<int64_t, 3>& a, const std::array<int64_t, 3>& b,
+                        const std::array<int64_t, 3>& c) -> int {
+        using fun::int128_t;
+        const int128_t det = int128_t(a[0]) * (int128_t(b[1]) * c[2] - int128_t(b[2]) * c[1])
+                             - int128_t(a[1]) * (int128_t(b[0]) * c[2] - int128_t(b[2]) * c[0])
+                             + int128_t(a[2]) * (int128_t(b[0]) * c[1] - int128_t(b[1]) * c[0]);
+        return (det > 0) - (det < 0);
+    }
+}  // namespace
+
+TEST_CASE("robust_predicates: expansion arithmetic is exact") {
+    const fun::Expansion one(1.0);
+    const fun::Expansion tiny(std::ldexp(1.0, -80));
+    const auto sum = one + tiny;
+    CHECK_EQ((sum - one).sign(), 1);
+    CHECK_EQ((sum - one - tiny).sign(), 0);
+    // (1 + 2^-80)^2 - 1 - 2^-79 = 2^-160 > 0
+    const auto sq = sum * sum;
+    CHECK_EQ((sq - one - tiny - tiny).sign(), 1);
+    CHECK_EQ((sq - one - tiny - tiny - tiny * tiny).sign(), 0);
+}
+
+TEST_CASE("robust_predicates: filter decides well-separated cases") {
+    CHECK_EQ(fun::incident_sign({1.0, 2.0, 3.0}, {1.0, 1.0, -1.0}), 0);
+    CHECK_EQ(fun::incident_sign({1.0, 2.0, 3.0}, {1.0, 1.0, 1.0}), 1);
+    CHECK_EQ(fun::coincident_sign({0.0, 0.0, 1.0}, {1.0, 0.0, 1.0}, {0.0, 1.0, 1.0}), 1);
+    CHECK(fun::robust_coincident(DPoint{{0.1, 0.1, 1.0}}, DPoint{{0.3, 0.3, 1.0}},
+                                 DPoint{{0.7, 0.7, 1.0}}));
+}
+
+TEST_CASE("robust_predicates: coincident_sign agrees with exact integer determinant") {
+    std::mt19937_64 gen(12345);
+    std::uniform_int_distribution<int64_t> dist(-(int64_t(1) << 29), int64_t(1) << 29);
+    std::uniform_int_distribution<int64_t> perturb(-1, 1);
+    bool all_ok = true;
+    int zeros = 0;
+    for (int trial = 0; trial < 2000; ++trial) {
+        const std::array<int64_t, 3> pk{dist(gen), dist(gen), dist(gen) / 4 + 1};
+        const std::array<int64_t, 3> qk{dist(gen) / 4, dist(gen) / 4, dist(gen) / 8 + 1};
+        // r = q + (q - p) + tiny perturbation: (nearly) collinear with p and q
+        std::array<int64_t, 3> rk{};
+        for (std::size_t i = 0; i < 3; ++i) {
+            rk[i] = 2 * qk[i] - pk[i];
+        }
+        rk[static_cast<std::size_t>(trial % 3)] += perturb(gen);
+        const int expected = exact_det_sign(pk, qk, rk);
+        zeros += static_cast<int>(expected == 0);
+        all_ok = all_ok
+                 && fun::coincident_sign(to_double(pk), to_double(qk), to_double(rk)) == expected;
+    }
+    CHECK(all_ok);
+    CHECK(zeros > 0);
+}
+
+TEST_CASE("robust_predicates: robust_persp matches integer persp") {
+    const auto pt_a = PgPoint({3, 1, 1});
+    const auto pt_b = PgPoint({1, 4, 1});
+    const auto pt_c = PgPoint({-2, -1, 1});
+    const auto pt_o = PgPoint({7, 5, 1});
+    const auto pt_d = PgPoint::parametrize(2, pt_a, 3, pt_o);
+    const auto pt_e = PgPoint::parametrize(5, pt_b, -1, pt_o);
+    const auto pt_f = PgPoint::parametrize(1, pt_c, 4, pt_o);
+    const auto pt_g = PgPoint({-1, 5, 3});
+    auto as_double = [](const PgPoint& pt) {
+        return DPoint{{static_cast<double>(pt.coord[0]), static_cast<double>(pt.coord[1]),
+                       static_cast<double>(pt.coord[2])}};
+    };
+    const std::array<DPoint, 3> tri1{as_double(pt_a), as_double(pt_b), as_double(pt_c)};
+    const std::array<DPoint, 3> tri2{as_double(pt_d), as_double(pt_e), as_double(pt_f)};
+    const std::array<DPoint, 3> tri3{as_double(pt_d), as_double(pt_e), as_double(pt_g)};
+    CHECK(fun::persp(std::array<PgPoint, 3>{pt_a, pt_b, pt_c},
+                     std::array<PgPoint, 3>{pt_d, pt_e, pt_f}));
+    CHECK(fun::robust_persp(tri1, tri2));
+    CHECK(!fun::robust_persp(tri1, tri3));
+}
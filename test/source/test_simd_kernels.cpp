@@ -0,0 +1,109 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/simd_kernels.hpp>
+#include <vector>
+
+namespace {
+    auto make_points(std::size_t n, int64_t seed) -> fun::PointSoA {
+        fun::PointSoA pts;
+        auto state = static_cast<uint64_t>(seed);
+        auto next = [&state]() {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<int64_t>(state >> 34) - (int64_t{1} << 29);
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto x = next();
+            const auto y = next();
+            const auto z = next();
+            pts.push_back(PgPoint({x, y, z}));
+        }
+        return pts;
+    }
+}  // namespace
+
+TEST_CASE("simd_kernels: scalar is always supported") {
+    CHECK(fun::simd_supported(fun::SimdIsa::Scalar));
+    CHECK(fun::simd_supported(fun::detect_simd_isa()));
+}
+
+TEST_CASE("simd_kernels: cross_batch matches ::cross on every supported ISA") {
+    const auto lhs = make_points(37, 1);
+    const auto rhs = make_points(37, 2);
+    for (auto isa : {fun::SimdIsa::Scalar, fun::SimdIsa::Avx2, fun::SimdIsa::Avx512}) {
+        if (!fun::simd_supported(isa)) {
+            continue;
+        }
+        fun::LineSoA out(lhs.size());
+        fun::cross_batch(isa, lhs.view(), rhs.view(), out.span());
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            CHECK_EQ(out[i].coord, cross(lhs[i].coord, rhs[i].coord));
+        }
+    }
+}
+
+TEST_CASE("simd_kernels: dot_batch matches ::dot on every supported ISA") {
+    const auto lhs = make_points(29, 3);
+    const auto rhs = make_points(29, 4);
+    for (auto isa : {fun::SimdIsa::Scalar, fun::SimdIsa::Avx2, fun::SimdIsa::Avx512}) {
+        if (!fun::simd_supported(isa)) {
+            continue;
+        }
+        std::vector<int64_t> out(lhs.size());
+        fun::dot_batch(isa, lhs.view(), rhs.view(), out);
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            CHECK_EQ(out[i], dot(lhs[i].coord, rhs[i].coord));
+        }
+    }
+}
+
+TEST_CASE("simd_kernels: dispatched cross_batch") {
+    const auto lhs = make_points(5, 5);
+    const auto rhs = make_points(5, 6);
+    fun::LineSoA out(lhs.size());
+    fun::cross_batch(lhs.view(), rhs.view(), out.span());
+    CHECK_EQ(out[4].coord, cross(lhs[4].coord, rhs[4].coord));
+}
+
+TEST_CASE("simd_kernels: mat3_batch matches the scalar product on every supported ISA") {
+    const auto pts = make_points(43, 7);
+    const fun::Mat3Int mat{{{3, -1, 7}, {0, 5, -2}, {11, 4, 1}}};
+    for (auto isa : {fun::SimdIsa::Scalar, fun::SimdIsa::Avx2, fun::SimdIsa::Avx512}) {
+        if (!fun::simd_supported(isa)) {
+            continue;
+        }
+        fun::PointSoA out(pts.size());
+        fun::mat3_batch(isa, mat, pts.view(), out.span());
+        for (std::size_t i = 0; i < pts.size(); ++i) {
+            const auto& vec = pts[i].coord;
+            const std::array<int64_t, 3> expect{
+                mat[0][0] * vec[0] + mat[0][1] * vec[1] + mat[0][2] * vec[2],
+                mat[1][0] * vec[0] + mat[1][1] * vec[1] + mat[1][2] * vec[2],
+                mat[2][0] * vec[0] + mat[2][1] * vec[1] + mat[2][2] * vec[2]};
+            CHECK_EQ(out[i].coord, expect);
+        }
+    }
+}
+
+TEST_CASE("simd_kernels: form_sign_batch matches the scalar form on every supported ISA") {
+    const auto pts = make_points(45, 11);
+    // small coefficients keep a + 2b + 4 <= 63 for the 30-bit coordinates
+    const fun::Mat3Int sym{{{1, -1, 0}, {-1, 1, 1}, {0, 1, -1}}};
+    for (auto isa : {fun::SimdIsa::Scalar, fun::SimdIsa::Avx2, fun::SimdIsa::Avx512}) {
+        if (!fun::simd_supported(isa)) {
+            continue;
+        }
+        std::vector<int8_t> out(pts.size());
+        fun::form_sign_batch(isa, sym, pts.view(), out);
+        bool all_ok = true;
+        for (std::size_t i = 0; i < pts.size(); ++i) {
+            const auto& vec = pts[i].coord;
+            const auto val = vec[0] * vec[0] - 2 * vec[0] * vec[1] + vec[1] * vec[1]
+                             + 2 * vec[1] * vec[2] - vec[2] * vec[2];
+            all_ok = all_ok && out[i] == (val > 0) - (val < 0);
+        }
+        CHECK(all_ok);
+    }
+}
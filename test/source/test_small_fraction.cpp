@@ -0,0 +1,85 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <projgeom/big_int.hpp>
+#include <projgeom/fractions.hpp>
+#include <projgeom/small_fraction.hpp>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using fun::BigInt;
+using fun::SmallFraction;
+
+TEST_CASE("small_fraction: stays inline for small values") {
+    const SmallFraction half(3, -6);
+    CHECK(half.is_small());
+    CHECK_EQ(half.num(), BigInt(-1));
+    CHECK_EQ(half.den(), BigInt(2));
+    const auto sum = SmallFraction(1, 6) + SmallFraction(1, 3);
+    CHECK_EQ(sum, SmallFraction(1, 2));
+    CHECK(sum.is_small());
+    CHECK(SmallFraction(2, 3) < SmallFraction(3, 4));
+    CHECK_EQ(SmallFraction(1, 6) - SmallFraction(1, 6), SmallFraction(0));
+    CHECK_EQ(SmallFraction(2, 3) / SmallFraction(-4, 9), SmallFraction(-3, 2));
+    CHECK_THROWS_AS(SmallFraction(1) / SmallFraction(0), std::domain_error);
+    std::ostringstream os;
+    os << SmallFraction(-6, 4);
+    CHECK_EQ(os.str(), "(-3/2)");
+}
+
+TEST_CASE("small_fraction: promotes on overflow and demotes when it fits again") {
+    constexpr std::int64_t kP = 4294967291;  // 2^32 - 5, prime
+    constexpr std::int64_t kQ = 4294967279;  // 2^32 - 17, prime
+    const auto tiny = SmallFraction(1, kP) * SmallFraction(1, kQ) * SmallFraction(1, kP);
+    CHECK(!tiny.is_small());
+    CHECK_EQ(tiny.den(), BigInt(kP) * BigInt(kQ) * BigInt(kP));
+    CHECK(tiny < SmallFraction(1, kP));
+    CHECK(SmallFraction(0) < tiny);
+    const auto back = tiny * SmallFraction(kP) * SmallFraction(kQ);
+    CHECK(back.is_small());
+    CHECK_EQ(back, SmallFraction(1, kP));
+    const auto neg_min = -SmallFraction(INT64_MIN);
+    CHECK(!neg_min.is_small());
+    CHECK_EQ(neg_min.num(), BigInt(1) << 63);
+    auto copy = tiny;
+    copy += SmallFraction(1);
+    CHECK_EQ(copy - tiny, SmallFraction(1));
+}
+
+TEST_CASE("small_fraction: random sums agree with Fraction<BigInt>") {
+    std::mt19937_64 gen(77);
+    SmallFraction acc;
+    fun::Fraction<BigInt> ref;
+    bool all_ok = true;
+    for (int trial = 0; trial < 400; ++trial) {
+        const auto num = static_cast<std::int64_t>(gen() % 2001) - 1000;
+        const auto den = static_cast<std::int64_t>(gen() % 100000) + 1;
+        const SmallFraction term(num, den);
+        const fun::Fraction<BigInt> ref_term{BigInt(num), BigInt(den)};
+        if (trial % 5 == 4) {
+            acc *= term;
+            ref *= ref_term;
+        } else {
+            acc += term;
+            ref = ref + ref_term;
+        }
+        all_ok = all_ok && acc.num() == ref.num() && acc.den() == ref.den();
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("small_fraction: big values can move between threads") {
+    std::vector<SmallFraction> vals;
+    std::thread producer([&vals] {
+        for (std::int64_t i = 1; i <= 50; ++i) {
+            vals.push_back(SmallFraction(1, (std::int64_t{1} << 40) + i)
+                           * SmallFraction(1, (std::int64_t{1} << 40) - i));
+        }
+    });
+    producer.join();
+    CHECK(!vals.front().is_small());
+    vals.clear();  // limbs allocated on the producer thread are freed here
+    CHECK(vals.empty());
+}
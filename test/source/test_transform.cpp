@@ -0,0 +1,175 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/transform.hpp>
+#include <vector>
+
+using fun::Transform;
+using R = Transform::Rational;
+
+TEST_CASE("transform: the cached adjugate matches the cofactor formula") {
+    const auto xform = Transform::rotation(R(3, 5), R(4, 5))
+                           .compose(Transform::translation(2, -7))
+                           .compose(Transform::scaling(R(2), R(1, 3)))
+                           .compose(Transform::shear(R(1, 2), R(-1)));
+    const Transform plain{xform.matrix()};
+    CHECK(plain.adjugate() == xform.adjugate());
+    CHECK_EQ(xform.inverse().compose(xform), Transform::identity());
+    CHECK_THROWS_AS(Transform::scaling(R(0), R(1)).inverse(), std::domain_error);
+    const PgLine line({1, 2, 3});
+    CHECK_THROWS_AS(Transform::scaling(R(0), R(1)).apply_line(line), std::domain_error);
+}
+
+TEST_CASE("transform: lines follow their points") {
+    const auto xform = Transform::translation(3, -1).compose(Transform::shear(R(2), R(0)));
+    const PgPoint pt_p({1, 2, 1});
+    const PgPoint pt_q({-4, 5, 1});
+    const auto ln_pq = pt_p.meet(pt_q);
+    const auto ln_img = xform.apply_line(ln_pq);
+    CHECK(ln_img.incident(xform.apply_point(pt_p)));
+    CHECK(ln_img.incident(xform.apply_point(pt_q)));
+
+    std::vector<PgLine> lines{ln_pq};
+    lines.emplace_back(std::array<std::int64_t, 3>{1, 0, -3});
+    lines.emplace_back(std::array<std::int64_t, 3>{0, 1, 1});
+    std::vector<PgLine> out(lines.size(), PgLine({0, 0, 1}));
+    xform.apply_lines(lines, out);
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        CHECK_EQ(out[i], xform.apply_line(lines[i]));
+    }
+}
+
+TEST_CASE("transform: integer matrix over a common denominator") {
+    const auto scale = Transform::scaling(R(1, 2), R(-2, 3));
+    const Transform::IntMat3x3 expect{{{3, 0, 0}, {0, -4, 0}, {0, 0, 6}}};
+    CHECK(scale.int_matrix() == expect);
+    CHECK_EQ(scale.denominator(), 6);
+    CHECK_EQ(scale.matrix()[1][1], R(-2, 3));
+    CHECK_EQ(scale.determinant(), R(-1, 3));
+    // fractional images are exact in homogeneous form, not truncated
+    const auto img = scale.apply_point(PgPoint({1, 1, 1}));
+    CHECK_EQ(img, PgPoint({3, -4, 6}));
+    CHECK_EQ(Transform::translation(5, -2).apply_point(PgPoint({1, 2, 3})), PgPoint({16, -4, 3}));
+    const auto rot = Transform::rotation(R(3, 5), R(4, 5));
+    CHECK_EQ(rot.compose(rot.inverse()), Transform::identity());
+    CHECK_EQ(Transform(Transform::IntMat3x3{{{2, 0, 0}, {0, 2, 0}, {0, 0, 2}}}, -4),
+             Transform(Transform::IntMat3x3{{{-1, 0, 0}, {0, -1, 0}, {0, 0, -1}}}, 2));
+    CHECK_EQ(Transform(Transform::IntMat3x3{{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}}, -1),
+             Transform(Transform::IntMat3x3{{{-1, 0, 0}, {0, -1, 0}, {0, 0, -1}}}, 1));
+    // a unimodular reflection has g det(A) = -1 and is its own inverse
+    const auto refl = Transform::scaling(R(-1), R(1));
+    CHECK_EQ(refl.inverse().denominator(), 1);
+    CHECK_EQ(refl.inverse(), refl);
+}
+
+TEST_CASE("transform: 128-bit intermediates and overflow") {
+    constexpr std::int64_t kBig = std::int64_t{1} << 40;
+    const auto xform = Transform::translation(kBig, -kBig);
+    // the product needs more than 64 bits until the common factor is removed
+    const auto img = xform.apply_point(PgPoint({kBig, kBig, kBig}));
+    // compare coordinates: PgPoint's cross-multiplied == would overflow at this size
+    const std::array<std::int64_t, 3> expect{kBig + 1, 1 - kBig, 1};
+    CHECK_EQ(img.coord, expect);
+    CHECK_THROWS_AS(xform.apply_point(PgPoint({3, 5, kBig})), std::overflow_error);
+    CHECK_THROWS_AS(xform.compose(Transform::scaling(R(1, 3), R(1, kBig))), std::overflow_error);
+}
+
+TEST_CASE("transform: each kind uses kernels that agree with the general formulas") {
+    using fun::TransformKind;
+    const std::vector<Transform> xforms{
+        Transform::identity(),
+        Transform::translation(5, -2),
+        Transform(Transform::IntMat3x3{{{3, 0, 1}, {0, 3, -2}, {0, 0, 3}}}, 7),
+        Transform::scaling(R(1, 2), R(-2, 3)),
+        Transform::scaling(R(-1), R(1)),
+        Transform::rotation(R(3, 5), R(4, 5)).compose(Transform::translation(2, 1)),
+        Transform(Transform::IntMat3x3{{{2, 1, 0}, {0, 3, 1}, {1, 0, 4}}}),
+    };
+    const std::vector<TransformKind> kinds{
+        TransformKind::Identity, TransformKind::Translation, TransformKind::Translation,
+        TransformKind::Diagonal, TransformKind::Diagonal,    TransformKind::Affine,
+        TransformKind::Projective};
+    const PgPoint pt_p({4, -7, 3});
+    const PgPoint pt_q({-1, 2, 5});
+    for (std::size_t k = 0; k < xforms.size(); ++k) {
+        const auto& xform = xforms[k];
+        CHECK(xform.kind() == kinds[k]);
+        // A p with all nine products
+        const auto& mat = xform.int_matrix();
+        std::array<std::int64_t, 3> full{};
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) full[i] += mat[i][j] * pt_p.coord[j];
+        }
+        CHECK_EQ(xform.apply_point(pt_p).coord, full);
+        const auto img_p = xform.apply_point(pt_p);
+        const auto img_q = xform.apply_point(pt_q);
+        CHECK_EQ(xform.apply_line(pt_p.meet(pt_q)), img_p.meet(img_q));
+        const std::vector<PgPoint> both{pt_p, pt_q};
+        std::vector<PgPoint> both_img(2, PgPoint({0, 0, 1}));
+        xform.apply_points(both, both_img);
+        CHECK(both_img[0].coord == img_p.coord);
+        CHECK(both_img[1].coord == img_q.coord);
+        CHECK_EQ(xform.compose(xform.inverse()), Transform::identity());
+        for (const auto& other : xforms) {
+            Transform::Mat3x3 prod{};
+            const auto lhs = xform.matrix();
+            const auto rhs = other.matrix();
+            for (std::size_t i = 0; i < 3; ++i) {
+                for (std::size_t j = 0; j < 3; ++j) {
+                    for (std::size_t m = 0; m < 3; ++m) prod[i][j] += lhs[i][m] * rhs[m][j];
+                }
+            }
+            CHECK_EQ(xform.compose(other), Transform{prod});
+        }
+    }
+    CHECK(Transform::scaling(R(2), R(2)).kind() == TransformKind::Diagonal);
+    CHECK(Transform::shear(R(1), R(0)).kind() == TransformKind::Affine);
+}
+
+TEST_CASE("transform: batched apply_points agrees with apply_point") {
+    const auto xform = Transform::rotation(R(3, 5), R(4, 5))
+                           .compose(Transform::translation(-9, 4))
+                           .compose(Transform::scaling(R(7, 2), R(1, 3)));
+    std::vector<PgPoint> pts;
+    std::uint64_t state = 12345;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        // mostly small coordinates (SIMD blocks), one block with 53-bit ones (exact path)
+        const int shift = i >= 512 && i < 768 ? 10 : 40;
+        const auto coord = [&state, shift](int k) {
+            return static_cast<std::int64_t>(state << (3 * k)) >> shift;
+        };
+        pts.emplace_back(std::array<std::int64_t, 3>{coord(0), coord(1), coord(2) | 1});
+    }
+    std::vector<PgPoint> expect;
+    bool overflow = false;
+    for (const auto& pt : pts) {
+        try {
+            expect.push_back(xform.apply_point(pt));
+        } catch (const std::overflow_error&) {
+            overflow = true;
+        }
+    }
+    REQUIRE(!overflow);
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{3}}) {
+        std::vector<PgPoint> out(pts.size(), PgPoint({0, 0, 1}));
+        xform.apply_points(pts, out, threads);
+        fun::PointSoA soa_out;
+        xform.apply_points(fun::PointSoA{std::span<const PgPoint>{pts}}, soa_out, threads);
+        bool all_ok = true;
+        for (std::size_t i = 0; i < pts.size(); ++i) {
+            all_ok = all_ok && out[i].coord == expect[i].coord
+                     && soa_out[i].coord == expect[i].coord;
+        }
+        CHECK(all_ok);
+    }
+    // in place, and errors from worker threads reach the caller
+    auto inplace = pts;
+    xform.apply_points(inplace, inplace, 2);
+    CHECK_EQ(inplace[999].coord, expect[999].coord);
+    std::vector<PgPoint> huge(600, PgPoint({INT64_MAX / 2, 1, 2}));
+    CHECK_THROWS_AS(Transform::translation(INT64_MAX / 2, 0).apply_points(huge, huge, 2),
+                    std::overflow_error);
+}
@@ -0,0 +1,75 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdint>
+#include <projgeom/pg_object.hpp>
+#include <projgeom/transform.hpp>
+#include <projgeom/transform_expr.hpp>
+#include <stdexcept>
+#include <vector>
+
+using fun::Transform;
+using fun::TransformExpr;
+using Kind = TransformExpr::Kind;
+using R = Transform::Rational;
+
+TEST_CASE("transform_expr: specialized factors fold analytically") {
+    const auto moved = TransformExpr::translation(3, -4).compose(TransformExpr::translation(-3, 9));
+    CHECK(moved.kind() == Kind::Translation);
+    CHECK_EQ(moved.evaluate(), Transform::translation(0, 5));
+    const auto back = moved.compose(TransformExpr::translation(0, -5));
+    CHECK(back.kind() == Kind::Identity);
+    const auto scaled = TransformExpr::scaling(R(2, 3), R(5)).compose(
+        TransformExpr::scaling(R(3, 2), R(1, 7)));
+    CHECK(scaled.kind() == Kind::Diagonal);
+    CHECK_EQ(scaled.evaluate(), Transform::scaling(R(1), R(5, 7)));
+    const auto rigid
+        = TransformExpr::rotation(R(3, 5), R(4, 5)).compose(TransformExpr::translation(7, 1));
+    CHECK(rigid.kind() == Kind::Affine);
+    CHECK(TransformExpr::identity().compose(rigid).kind() == Kind::Affine);
+}
+
+TEST_CASE("transform_expr: a folded chain evaluates to the eager composition") {
+    const auto eager = Transform::rotation(R(3, 5), R(4, 5))
+                           .compose(Transform::translation(-9, 4))
+                           .compose(Transform::scaling(R(7, 2), R(1, 3)))
+                           .compose(Transform::shear(R(1, 2), R(-1)));
+    const auto lazy = TransformExpr::rotation(R(3, 5), R(4, 5))
+                          .compose(TransformExpr::translation(-9, 4))
+                          .compose(TransformExpr::scaling(R(7, 2), R(1, 3)))
+                          .compose(TransformExpr::shear(R(1, 2), R(-1)));
+    CHECK(lazy.kind() == Kind::Affine);
+    CHECK_EQ(lazy.evaluate(), eager);
+    CHECK_EQ(TransformExpr{eager}.evaluate(), eager);
+    std::vector<PgPoint> pts;
+    for (std::int64_t i = 0; i < 300; ++i) {
+        pts.emplace_back(std::array<std::int64_t, 3>{i * 7 - 1000, 31 - i, i % 4 + 1});
+    }
+    std::vector<PgPoint> out(pts.size(), PgPoint({0, 0, 1}));
+    lazy.apply_points(pts, out);
+    bool all_ok = true;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        all_ok = all_ok && lazy.apply_point(pts[i]) == eager.apply_point(pts[i])
+                 && out[i] == eager.apply_point(pts[i]);
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("transform_expr: projective factors and large entries") {
+    const Transform persp{Transform::IntMat3x3{{{1, 0, 0}, {0, 1, 0}, {1, 2, 1}}}};
+    const auto lazy = TransformExpr::translation(2, 3).compose(TransformExpr{persp});
+    CHECK(lazy.kind() == Kind::Projective);
+    CHECK_EQ(lazy.evaluate(), Transform::translation(2, 3).compose(persp));
+    const PgPoint pt({5, -1, 2});
+    CHECK_EQ(lazy.apply_point(pt), Transform::translation(2, 3).compose(persp).apply_point(pt));
+    // the common factor is divided out only when a product leaves int64
+    constexpr std::int64_t kBig = std::int64_t{1} << 40;
+    constexpr std::int64_t kMid = std::int64_t{1} << 30;
+    const auto wide = TransformExpr::scaling(R(1, kBig), R(1))
+                          .compose(TransformExpr::scaling(R(kMid), R(kMid)));
+    CHECK(wide.kind() == Kind::Diagonal);
+    CHECK_EQ(wide.evaluate(), Transform::scaling(R(1, 1024), R(kMid)));
+    CHECK_THROWS_AS(TransformExpr::scaling(R(kBig), R(1)).compose(
+                        TransformExpr::scaling(R(kBig), R(1))),
+                    std::overflow_error);
+}
@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <projgeom/big_int.hpp>
+#include <projgeom/common_concepts.h>
+#include <projgeom/int128.hpp>
+#include <projgeom/pg_line.hpp>
+#include <projgeom/pg_plane.hpp>
+#include <projgeom/pg_point.hpp>
+#include <projgeom/wide_int.hpp>
+#include <random>
+#include <sstream>
+
+using fun::Int128;
+using fun::Int256;
+
+static_assert(fun::Integral<Int128>);
+static_assert(fun::Integral<Int256>);
+
+namespace {
+    auto to_native(const Int128& val) -> fun::int128_t {
+        return static_cast<fun::int128_t>((fun::uint128_t(val.limbs()[1]) << 64)
+                                          | val.limbs()[0]);
+    }
+
+    auto from_native(fun::int128_t val) -> Int128 {
+        const auto bits = static_cast<fun::uint128_t>(val);
+        return Int128::from_limbs(
+            {static_cast<std::uint64_t>(bits), static_cast<std::uint64_t>(bits >> 64)});
+    }
+}  // namespace
+
+TEST_CASE("wide_int: Int128 agrees with the builtin 128-bit integer") {
+    std::mt19937_64 gen(2024);
+    bool all_ok = true;
+    for (int trial = 0; trial < 5000; ++trial) {
+        // mix small (fast path) and full-width operands
+        const auto shift_a = static_cast<int>(gen() % 3) * 40;
+        const auto shift_b = static_cast<int>(gen() % 2) * 30;
+        const auto a = static_cast<fun::int128_t>(static_cast<std::int64_t>(gen())) << shift_a;
+        auto b = static_cast<fun::int128_t>(static_cast<std::int64_t>(gen() >> 8)) << shift_b;
+        if (b == 0) b = 1;
+        const auto wa = from_native(a);
+        const auto wb = from_native(b);
+        const auto prod = static_cast<fun::int128_t>(static_cast<fun::uint128_t>(a)
+                                                     * static_cast<fun::uint128_t>(b));
+        all_ok = all_ok && to_native(wa + wb) == a + b && to_native(wa - wb) == a - b
+                 && to_native(wa * wb) == prod && to_native(wa / wb) == a / b
+                 && to_native(wa % wb) == a % b && ((wa < wb) == (a < b)) && to_native(-wa) == -a;
+    }
+    CHECK(all_ok);
+}
+
+TEST_CASE("wide_int: Int256 products, division and printing") {
+    const Int256 two100 = Int256(1) << 100;
+    const auto prod = (two100 + 3) * (two100 - 3);
+    CHECK_EQ(prod, (Int256(1) << 200) - 9);
+    CHECK_EQ(prod / (two100 - 3), two100 + 3);
+    CHECK_EQ(prod % (two100 - 3), Int256(0));
+    CHECK_EQ(((Int256(1) << 200) - 8) % (two100 + 3), Int256(1));
+    CHECK_EQ((-prod) / Int256(7), -(prod / Int256(7)));
+    CHECK_EQ((Int256(1) << 128).to_string(), "340282366920938463463374607431768211456");
+    CHECK_EQ(Int256(-1234567890123456789LL).to_string(), "-1234567890123456789");
+    std::ostringstream os;
+    os << Int128(0) << ' ' << Int128(-42);
+    CHECK_EQ(os.str(), "0 -42");
+    CHECK(Int256(-5) < Int256(3));
+    CHECK_EQ(Int256(Int128(-7)), Int256(-7));
+    CHECK_THROWS_AS(Int128(1) / Int128(0), std::domain_error);
+}
+
+TEST_CASE("wide_int: pg_point<Int256> deep construction does not overflow") {
+    // diagonal points of a complete quadrangle, then once more: ~10^3 -> ~10^59
+    auto construct = [](const auto& pt_a, const auto& pt_b, const auto& pt_c, const auto& pt_d) {
+        const auto pt_e = (pt_a * pt_b) * (pt_c * pt_d);
+        const auto pt_f = (pt_a * pt_c) * (pt_b * pt_d);
+        const auto pt_g = (pt_a * pt_d) * (pt_b * pt_c);
+        const auto pt_h = (pt_e * pt_b) * (pt_f * pt_d);
+        return (pt_e * pt_f) * (pt_g * pt_h);
+    };
+    using PointW = fun::pg_point<Int256>;
+    using PointD = fun::pg_point<double>;
+    const auto pw_r = construct(PointW(1009, 2, 1), PointW(-3, 1013, 1), PointW(907, -911, 1),
+                                PointW(-5, 17, 1019));
+    const auto pd_r = construct(PointD(1009, 2, 1), PointD(-3, 1013, 1), PointD(907, -911, 1),
+                                PointD(-5, 17, 1019));
+    CHECK(!pw_r.coord[2].fits_int64());
+    for (std::size_t i = 0; i < 2; ++i) {
+        const auto ratio_w
+            = static_cast<double>(pw_r.coord[i]) / static_cast<double>(pw_r.coord[2]);
+        const auto ratio_d = pd_r.coord[i] / pd_r.coord[2];
+        CHECK(std::abs(ratio_w - ratio_d) <= 1e-6 * std::abs(ratio_d));
+    }
+    // BigInt gives the same coordinates, and one more level needs more than 256 bits
+    using PointB = fun::pg_point<fun::BigInt>;
+    const PointB pb_a(1009, 2, 1);
+    const PointB pb_b(-3, 1013, 1);
+    const PointB pb_c(907, -911, 1);
+    const PointB pb_d(-5, 17, 1019);
+    const auto pb_r = construct(pb_a, pb_b, pb_c, pb_d);
+    for (std::size_t i = 0; i < 3; ++i) {
+        CHECK_EQ(pb_r.coord[i].to_string(), pw_r.coord[i].to_string());
+    }
+    const auto pb_deep = construct(pb_r, PointB(7, 3, 2), PointB(-13, 5, 3), PointB(2, -9, 11));
+    CHECK(pb_deep.coord[2].bit_length() > 256);
+}
+
+TEST_CASE("wide_int: pg_plane theorems with Int256 coordinates") {
+    using PointW = fun::pg_point<Int256>;
+    const std::array<PointW, 3> tri1{PointW(1, 1, 1), PointW(-3, 5, 2), PointW(7, -2, 3)};
+    const std::array<PointW, 3> tri2{PointW(11, 4, -1), PointW(2, 9, 5), PointW(-6, 1, 4)};
+    CHECK(fun::check_desargue(tri1, tri2));
+    const auto pt_c = PointW::parametrize(Int256(3), tri1[0], Int256(-5), tri1[1]);
+    const auto pt_f = PointW::parametrize(Int256(2), tri2[0], Int256(7), tri2[1]);
+    const std::array<PointW, 3> coline1{PointW(1, 1, 1), PointW(-3, 5, 2), PointW(pt_c)};
+    const std::array<PointW, 3> coline2{PointW(11, 4, -1), PointW(2, 9, 5), PointW(pt_f)};
+    CHECK(fun::check_pappus(coline1, coline2));
+}
@@ -43,6 +43,9 @@ elseif is_plat("windows") then
 end
 -- add_packages("fmt", "doctest", "range-v3")
 add_packages("fmt", "doctest", "spdlog")
+if is_plat("linux", "macosx") then
+	add_syslinks("pthread")
+end
 add_tests("default")
 
 -- Check if rapidcheck was downloaded by CMake